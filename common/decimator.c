@@ -0,0 +1,226 @@
+/**
+ ******************************************************************************
+ * @file 	decimator.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Multistage polyphase decimator of the microphone channels.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include <math.h>
+
+#include "./decimator.h"
+
+static const double decimatorPi = 3.14159265358979323846;
+
+/**
+ * Return the modified Bessel function I0(x) from its power series.
+ */
+static double __bessel_i0(double x)
+{
+	int k;
+	double term = 1.0, sum = 1.0;
+
+	for (k = 1; k < 64 && term > 1e-12 * sum; k++)
+	{
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+/**
+ * Design the Kaiser-windowed low pass filter of a stage at the input rate
+ * `fs`, passing `passband` and stopping from `stopband` Hz down by
+ * `attenuation` dB. Return -1 if it needs more than DECIMATOR_MAX_TAPS.
+ */
+static int __design_stage(DecimatorStage *stage, double fs, double passband,
+	double stopband, double attenuation)
+{
+	int n, taps;
+	double beta, cutoff, x, window, sum = 0.0;
+
+	/* The estimates of Kaiser for the length and the shape. */
+	taps = (int) ceil((attenuation - 7.95) /
+		(14.36 * (stopband - passband) / fs)) + 1;
+	taps += (taps % 2 == 0) ? 1 : 0;
+	if (taps > DECIMATOR_MAX_TAPS)
+	{
+		return -1;
+	}
+	if (attenuation > 50.0)
+	{
+		beta = 0.1102 * (attenuation - 8.7);
+	}
+	else if (attenuation > 21.0)
+	{
+		beta = 0.5842 * pow(attenuation - 21.0, 0.4) +
+			0.07886 * (attenuation - 21.0);
+	}
+	else
+	{
+		beta = 0.0;
+	}
+
+	cutoff = (passband + stopband) / 2.0 / fs;
+	stage->taps = taps;
+	for (n = 0; n < taps; n++)
+	{
+		x = n - (taps - 1) / 2.0;
+		window = (taps > 1) ? 2.0 * n / (taps - 1) - 1.0 : 0.0;
+		window = __bessel_i0(beta * sqrt(1.0 - window * window)) /
+			__bessel_i0(beta);
+		stage->coeffs[n] = (float) (window * ((x == 0.0) ? 2.0 * cutoff :
+			sin(2.0 * decimatorPi * cutoff * x) / (decimatorPi * x)));
+		sum += stage->coeffs[n];
+	}
+
+	/* The unity gain at DC. */
+	for (n = 0; n < taps; n++)
+	{
+		stage->coeffs[n] = (float) (stage->coeffs[n] / sum);
+	}
+	return 0;
+}
+
+/**
+ * Return the largest prime factor of `value`.
+ */
+static int __largest_prime(int value)
+{
+	int factor = 2, largest = value;
+
+	while (factor * factor <= value)
+	{
+		if (value % factor == 0)
+		{
+			value /= factor;
+			largest = factor;
+		}
+		else
+		{
+			factor++;
+		}
+	}
+	return (value > 1) ? value : largest;
+}
+
+/**
+ * Design the decimator of the input rate `fs` by `ratio`. The band below
+ * `passband` Hz of the output is kept, and the inputs that would fold into
+ * it are stopped by `attenuation` dB. Return the number of stages, or -1
+ * if the pass band doesn't fit in the output rate or the filters don't fit
+ * in DECIMATOR_MAX_STAGES and DECIMATOR_MAX_TAPS.
+ */
+int decimator_init(Decimator *decimator, float fs, int ratio,
+	float passband, float attenuation)
+{
+	int factor, rest;
+	double rate;
+
+	memset(decimator, 0, sizeof(Decimator));
+	if (fs <= 0.0f || ratio < 1 || passband <= 0.0f || attenuation <= 0.0f ||
+		2.0f * passband >= fs / ratio)
+	{
+		return -1;
+	}
+	decimator->fs = fs;
+	decimator->ratio = ratio;
+
+	/* The biggest prime factors first, they run at the highest rates
+		with the widest transition bands. */
+	rate = fs;
+	rest = ratio;
+	while (rest > 1)
+	{
+		factor = __largest_prime(rest);
+		if (decimator->stages == DECIMATOR_MAX_STAGES)
+		{
+			return -1;
+		}
+		decimator->stage[decimator->stages].ratio = factor;
+		if (__design_stage(&decimator->stage[decimator->stages], rate,
+			passband, rate / factor - passband, attenuation) < 0)
+		{
+			return -1;
+		}
+		decimator->stages++;
+		rate /= factor;
+		rest /= factor;
+	}
+	return decimator->stages;
+}
+
+/**
+ * Clear the delay lines of the channel, it starts from silence.
+ */
+void decimator_channel_reset(DecimatorChannel *channel)
+{
+	memset(channel, 0, sizeof(DecimatorChannel));
+}
+
+/**
+ * Feed the `input` sample of channel through the stages. Return 1 and the
+ * next output sample in `output` once every `ratio` inputs, 0 otherwise.
+ */
+int decimator_push(const Decimator *decimator, DecimatorChannel *channel,
+	float input, float *output)
+{
+	int s, k, head;
+	float sum, value = input;
+	const float *window;
+	const DecimatorStage *stage;
+
+	for (s = 0; s < decimator->stages; s++)
+	{
+		stage = &decimator->stage[s];
+		head = channel->head[s] = (channel->head[s] + 1) % stage->taps;
+		channel->history[s][head] = value;
+		channel->history[s][head + stage->taps] = value;
+
+		/* The outputs that are thrown away are never computed. */
+		if (++channel->phase[s] < stage->ratio)
+		{
+			return 0;
+		}
+		channel->phase[s] = 0;
+
+		/* The newest input is at the end of the window. */
+		window = &channel->history[s][head + 1];
+		sum = 0.0f;
+		for (k = 0; k < stage->taps; k++)
+		{
+			sum += stage->coeffs[k] * window[stage->taps - 1 - k];
+		}
+		value = sum;
+	}
+	*output = value;
+	return 1;
+}
+
+/**
+ * Decimate the `length` samples of `input` of the channel into `output`,
+ * which needs room for length / ratio + 1 samples. The channel carries
+ * its delay lines over the calls. Return the number of output samples.
+ */
+size_t decimator_process(const Decimator *decimator,
+	DecimatorChannel *channel, const float *input, size_t length,
+	float *output)
+{
+	size_t i, count = 0;
+
+	for (i = 0; i < length; i++)
+	{
+		count += (size_t) decimator_push(decimator, channel, input[i],
+			&output[count]);
+	}
+	return count;
+}
@@ -0,0 +1,92 @@
+/**
+ ******************************************************************************
+ * @file 	decimator.h
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Multistage polyphase decimator of the microphone channels.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#ifndef DECIMATOR_H
+#define DECIMATOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Libraries (portable, also built for the firmware) */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/* Decimator Definitions */
+
+/*	The DFSDM filters of the firmware put out about 48.8 kHz, interleaved
+	left and right, so each mic comes at about 24.4 kHz, twice the rate of
+	analysis. The rate is divided by the prime factors of the ratio one
+	after another, the biggest first, each behind its own low pass FIR
+	filter, so each stage only has to keep out the images that fold into
+	the pass band of the final rate:
+
+		stop band of a stage = its output rate - pass band
+
+	The filters are Kaiser-windowed sincs sized for the attenuation, and a
+	stage only computes the outputs that it keeps, one in `ratio` inputs.
+	The design is shared, and each channel keeps the delay lines of its
+	stages in its own `DecimatorChannel`, so the firmware needs no heap. */
+
+#define DECIMATOR_MAX_STAGES				4
+#define DECIMATOR_MAX_TAPS					64
+
+/* Data Structures */
+
+typedef struct _DecimatorStage
+{
+	int ratio;									/* inputs per output */
+	int taps;
+	float coeffs[DECIMATOR_MAX_TAPS];
+} DecimatorStage;
+
+typedef struct _Decimator
+{
+	float fs;									/* input rate in Hz */
+	int ratio;									/* product of the stage ratios */
+	int stages;
+	DecimatorStage stage[DECIMATOR_MAX_STAGES];
+} Decimator;
+
+typedef struct _DecimatorChannel
+{
+	/* The delay line is written twice, so the last `taps` inputs are
+		always in a row after `head`. */
+
+	float history[DECIMATOR_MAX_STAGES][2 * DECIMATOR_MAX_TAPS];
+	int head[DECIMATOR_MAX_STAGES];
+	int phase[DECIMATOR_MAX_STAGES];		/* inputs since the last output */
+} DecimatorChannel;
+
+/* Function Prototypes */
+
+extern int decimator_init(Decimator *decimator, float fs, int ratio,
+	float passband, float attenuation);
+extern void decimator_channel_reset(DecimatorChannel *channel);
+extern int decimator_push(const Decimator *decimator,
+	DecimatorChannel *channel, float input, float *output);
+extern size_t decimator_process(const Decimator *decimator,
+	DecimatorChannel *channel, const float *input, size_t length,
+	float *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DECIMATOR_H */
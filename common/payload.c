@@ -0,0 +1,449 @@
+/**
+ ******************************************************************************
+ * @file 	payload.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Shared payload data and its compact wire encoding.
+ * 
+ ******************************************************************************
+ * @attention
+ * 
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ * 
+ * This software is licensed under the MIT License.
+ * 
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+
+#include "./payload.h"
+
+/* Layout of a fixed-point GPS field on the wire. */
+
+typedef struct _PayloadGPSField
+{
+	size_t offset;								/* text field in PayloadData */
+	int bytes;									/* wire size (1, 2 or 4) */
+	int decimals;								/* fraction digits, -1 for a char */
+	int digits;									/* minimum integer digits */
+} PayloadGPSField;
+
+static const size_t micFields[PAYLOAD_MIC_COUNT] =
+{
+	offsetof(PayloadData, micNorth), offsetof(PayloadData, micNorthEast),
+	offsetof(PayloadData, micEast), offsetof(PayloadData, micSouthEast),
+	offsetof(PayloadData, micSouth), offsetof(PayloadData, micSouthWest),
+	offsetof(PayloadData, micWest), offsetof(PayloadData, micNorthWest)
+};
+
+static const PayloadGPSField gpsFields[PAYLOAD_GPS_COUNT] =
+{
+	{offsetof(PayloadData, gpsUTCTime), 4, 0, 6},
+	{offsetof(PayloadData, gpsLatitude), 4, 7, 1},		/* 1e-7 degrees */
+	{offsetof(PayloadData, gpsLongitude), 4, 7, 1},		/* 1e-7 degrees */
+	{offsetof(PayloadData, gpsQuality), 1, 0, 1},
+	{offsetof(PayloadData, gpsNumSat), 1, 0, 1},
+	{offsetof(PayloadData, gpsAltitude), 4, 1, 1},		/* decimeters */
+	{offsetof(PayloadData, gpsStatus), 1, -1, 0},
+	{offsetof(PayloadData, gpsSpeed), 2, 1, 1},			/* 0.1 knots */
+	{offsetof(PayloadData, gpsCourse), 2, 1, 1},			/* 0.1 degrees */
+	{offsetof(PayloadData, gpsDate), 4, 0, 6}
+};
+
+static const size_t imuFields[PAYLOAD_IMU_COUNT] =
+{
+	offsetof(PayloadData, imuAccelX), offsetof(PayloadData, imuAccelY),
+	offsetof(PayloadData, imuAccelZ), offsetof(PayloadData, imuGyroX),
+	offsetof(PayloadData, imuGyroY), offsetof(PayloadData, imuGyroZ),
+	offsetof(PayloadData, imuTemp)
+};
+
+static const int32_t powersOfTen[8] =
+{
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000
+};
+
+/**
+ * Write the `bytes` wide value in little-endian order.
+ */
+static uint8_t *__put_int(uint8_t *out, int32_t value, int bytes)
+{
+	int i;
+
+	for (i = 0; i < bytes; i++)
+	{
+		out[i] = (uint8_t) ((uint32_t) value >> (8 * i));
+	}
+	return out + bytes;
+}
+
+/**
+ * Read the `bytes` wide value in little-endian order and extend its sign.
+ */
+static int32_t __get_int(const uint8_t *in, int bytes)
+{
+	int i;
+	uint32_t value = 0;
+
+	for (i = 0; i < bytes; i++)
+	{
+		value |= (uint32_t) in[i] << (8 * i);
+	}
+	if (bytes < 4 && (value & (1u << (8 * bytes - 1))))
+	{
+		value |= ~0u << (8 * bytes);
+	}
+	return (int32_t) value;
+}
+
+/**
+ * Convert the decimal text into fixed-point value. The extra fraction
+ * digits are truncated and the value saturates at +-`limit`. Return 0 if
+ * there is no number in the text.
+ */
+static int __text_to_fixed(const char *text, int decimals, int32_t limit,
+	int32_t *value)
+{
+	int i = 0, sign = 1, found = 0, fraction = -1;
+	int64_t number = 0;
+
+	while (i < PAYLOAD_GPS_SIZE && text[i] == ' ')
+	{
+		i++;
+	}
+	if (i < PAYLOAD_GPS_SIZE && (text[i] == '-' || text[i] == '+'))
+	{
+		sign = (text[i++] == '-') ? -1 : 1;
+	}
+	for (; i < PAYLOAD_GPS_SIZE && text[i] != '\0'; i++)
+	{
+		if (text[i] == '.' && fraction < 0)
+		{
+			fraction = 0;
+			continue;
+		}
+		if (text[i] < '0' || text[i] > '9')
+		{
+			break;
+		}
+		found = 1;
+		if (fraction >= decimals)
+		{
+			continue;		/* truncate the extra fraction digits */
+		}
+		if (fraction >= 0)
+		{
+			fraction++;
+		}
+		if (number <= limit)
+		{
+			number = number * 10 + (text[i] - '0');
+		}
+	}
+	if (!found)
+	{
+		return 0;
+	}
+	if (fraction < 0)
+	{
+		fraction = 0;
+	}
+	for (; fraction < decimals && number <= limit; fraction++)
+	{
+		number *= 10;
+	}
+	if (number > limit)
+	{
+		number = limit;
+	}
+	*value = (int32_t) (sign * number);
+
+	return 1;
+}
+
+/**
+ * Format the fixed-point value as decimal text.
+ */
+static void __fixed_to_text(int32_t value, int decimals, int digits,
+	char *text)
+{
+	uint32_t magnitude, scale;
+	int length;
+
+	magnitude = (value < 0) ? 0u - (uint32_t) value : (uint32_t) value;
+	scale = (uint32_t) powersOfTen[decimals];
+
+	length = snprintf(text, PAYLOAD_GPS_SIZE, "%s%0*lu", (value < 0) ? "-" : "",
+		digits, (unsigned long) (magnitude / scale));
+	if (decimals > 0)
+	{
+		snprintf(text + length, PAYLOAD_GPS_SIZE - length, ".%0*lu", decimals,
+			(unsigned long) (magnitude % scale));
+	}
+}
+
+/**
+ * Zigzag code the sample difference, so small magnitudes have few bits.
+ */
+static uint8_t __zigzag(int8_t delta)
+{
+	return (uint8_t) (((uint8_t) delta << 1) ^ (uint8_t) (delta >> 7));
+}
+
+/**
+ * Find the bit width of each difference block and return the size of the
+ * delta coded channel.
+ */
+static size_t __mic_widths(const int8_t *samples, uint8_t *widths)
+{
+	int i, j;
+	int8_t previous = 0;
+	uint8_t bits;
+	size_t size = 1;
+
+	for (i = 0; i < PAYLOAD_MIC_SIZE / PAYLOAD_MIC_BLOCK; i++)
+	{
+		bits = 0;
+		for (j = 0; j < PAYLOAD_MIC_BLOCK; j++)
+		{
+			bits |= __zigzag((int8_t) (*samples - previous));
+			previous = *samples++;
+		}
+		widths[i] = 0;
+		while (bits)
+		{
+			widths[i]++;
+			bits >>= 1;
+		}
+		size += 1 + PAYLOAD_MIC_BLOCK * widths[i] / 8;
+	}
+	return size;
+}
+
+/**
+ * Encode one microphone channel and return the end of written bytes.
+ */
+static uint8_t *__mic_encode(const int8_t *samples, uint8_t *out)
+{
+	int i, j, bits;
+	int8_t previous = 0;
+	uint32_t buffer;
+	uint8_t widths[PAYLOAD_MIC_SIZE / PAYLOAD_MIC_BLOCK];
+
+	if (__mic_widths(samples, widths) >= 1 + PAYLOAD_MIC_SIZE)
+	{
+		*out++ = PAYLOAD_MIC_RAW;
+		memcpy(out, samples, PAYLOAD_MIC_SIZE);
+		return out + PAYLOAD_MIC_SIZE;
+	}
+	*out++ = PAYLOAD_MIC_DELTA;
+	for (i = 0; i < PAYLOAD_MIC_SIZE / PAYLOAD_MIC_BLOCK; i++)
+	{
+		*out++ = widths[i];
+
+		/* Pack the differences from the least significant bit. */
+		buffer = 0;
+		bits = 0;
+		for (j = 0; j < PAYLOAD_MIC_BLOCK; j++)
+		{
+			buffer |= (uint32_t) __zigzag((int8_t) (*samples - previous)) << bits;
+			bits += widths[i];
+			previous = *samples++;
+			while (bits >= 8)
+			{
+				*out++ = (uint8_t) buffer;
+				buffer >>= 8;
+				bits -= 8;
+			}
+		}
+	}
+	return out;
+}
+
+/**
+ * Decode one microphone channel. Return the end of read bytes or NULL if
+ * the channel is malformed.
+ */
+static const uint8_t *__mic_decode(const uint8_t *in, const uint8_t *end,
+	int8_t *samples)
+{
+	int i, j, bits, width;
+	int8_t previous = 0;
+	uint32_t buffer;
+	uint8_t zigzag;
+
+	if (in >= end)
+	{
+		return NULL;
+	}
+	if (*in == PAYLOAD_MIC_RAW)
+	{
+		if (end - in < 1 + PAYLOAD_MIC_SIZE)
+		{
+			return NULL;
+		}
+		memcpy(samples, in + 1, PAYLOAD_MIC_SIZE);
+		return in + 1 + PAYLOAD_MIC_SIZE;
+	}
+	if (*in++ != PAYLOAD_MIC_DELTA)
+	{
+		return NULL;
+	}
+	for (i = 0; i < PAYLOAD_MIC_SIZE / PAYLOAD_MIC_BLOCK; i++)
+	{
+		if (in >= end || *in > 8 ||
+			end - in < 1 + PAYLOAD_MIC_BLOCK * *in / 8)
+		{
+			return NULL;
+		}
+		width = *in++;
+
+		/* Unpack the differences and accumulate them. */
+		buffer = 0;
+		bits = 0;
+		for (j = 0; j < PAYLOAD_MIC_BLOCK; j++)
+		{
+			while (bits < width)
+			{
+				buffer |= (uint32_t) *in++ << bits;
+				bits += 8;
+			}
+			zigzag = (uint8_t) (buffer & ((1u << width) - 1));
+			buffer >>= width;
+			bits -= width;
+
+			previous = (int8_t) (previous + ((zigzag >> 1) ^ -(zigzag & 1)));
+			*samples++ = previous;
+		}
+	}
+	return in;
+}
+
+/**
+ * Encode the sections of payload data selected by `mask` into `out` and
+ * return the encoded size. The `out` must have PAYLOAD_MAX_ENCODED bytes.
+ */
+size_t payload_encode(const PayloadData *data, uint8_t mask, uint8_t *out)
+{
+	int i;
+	int32_t value, limit;
+	uint32_t bits;
+	const char *text;
+	uint8_t *start = out;
+
+	mask &= PAYLOAD_HAS_ALL;
+	*out++ = mask;
+
+	if (mask & PAYLOAD_HAS_MIC)
+	{
+		for (i = 0; i < PAYLOAD_MIC_COUNT; i++)
+		{
+			out = __mic_encode((const int8_t *) data + micFields[i], out);
+		}
+	}
+	if (mask & PAYLOAD_HAS_GPS)
+	{
+		for (i = 0; i < PAYLOAD_GPS_COUNT; i++)
+		{
+			text = (const char *) data + gpsFields[i].offset;
+			if (gpsFields[i].decimals < 0)
+			{
+				*out++ = (uint8_t) text[0];	/* 0 for an empty text */
+				continue;
+			}
+			/* The most negative value marks an empty text. */
+			limit = (int32_t) ((1u << (8 * gpsFields[i].bytes - 1)) - 1);
+			if (!__text_to_fixed(text, gpsFields[i].decimals, limit, &value))
+			{
+				value = -limit - 1;
+			}
+			out = __put_int(out, value, gpsFields[i].bytes);
+		}
+	}
+	if (mask & PAYLOAD_HAS_IMU)
+	{
+		for (i = 0; i < PAYLOAD_IMU_COUNT; i++)
+		{
+			memcpy(&bits, (const uint8_t *) data + imuFields[i], sizeof(bits));
+			out = __put_int(out, (int32_t) bits, 4);
+		}
+	}
+	return (size_t) (out - start);
+}
+
+/**
+ * Decode the payload into `data`. The sections that are not in the payload
+ * keep their previous values. Return the field-presence mask or -1 if the
+ * payload is malformed, in which case `data` may be partially updated.
+ */
+int payload_decode(const uint8_t *in, size_t size, PayloadData *data)
+{
+	int i, bytes;
+	int32_t value;
+	uint32_t bits;
+	uint8_t mask;
+	char *text;
+	const uint8_t *end = in + size;
+
+	if (size < 1 || (in[0] & ~PAYLOAD_HAS_ALL))
+	{
+		return -1;
+	}
+	mask = *in++;
+
+	if (mask & PAYLOAD_HAS_MIC)
+	{
+		for (i = 0; i < PAYLOAD_MIC_COUNT && in != NULL; i++)
+		{
+			in = __mic_decode(in, end, (int8_t *) data + micFields[i]);
+		}
+		if (in == NULL)
+		{
+			return -1;
+		}
+	}
+	if (mask & PAYLOAD_HAS_GPS)
+	{
+		for (i = 0; i < PAYLOAD_GPS_COUNT; i++)
+		{
+			text = (char *) data + gpsFields[i].offset;
+			bytes = gpsFields[i].bytes;
+			if (end - in < bytes)
+			{
+				return -1;
+			}
+			value = __get_int(in, bytes);
+			in += bytes;
+
+			if (gpsFields[i].decimals < 0)
+			{
+				text[0] = (char) value;
+				text[1] = '\0';
+			}
+			else if (value == (int32_t) (~0u << (8 * bytes - 1)))
+			{
+				text[0] = '\0';
+			}
+			else
+			{
+				__fixed_to_text(value, gpsFields[i].decimals,
+					gpsFields[i].digits, text);
+			}
+		}
+	}
+	if (mask & PAYLOAD_HAS_IMU)
+	{
+		if (end - in < 4 * PAYLOAD_IMU_COUNT)
+		{
+			return -1;
+		}
+		for (i = 0; i < PAYLOAD_IMU_COUNT; i++)
+		{
+			bits = (uint32_t) __get_int(in, 4);
+			memcpy((uint8_t *) data + imuFields[i], &bits, sizeof(bits));
+			in += 4;
+		}
+	}
+	return (in == end) ? mask : -1;
+}
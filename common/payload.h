@@ -0,0 +1,115 @@
+/**
+ ******************************************************************************
+ * @file 	payload.h
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Shared payload data and its compact wire encoding.
+ * 
+ ******************************************************************************
+ * @attention
+ * 
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ * 
+ * This software is licensed under the MIT License.
+ * 
+ ******************************************************************************
+ */
+
+#ifndef PAYLOAD_H
+#define PAYLOAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Libraries (portable, also built for the firmware) */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/* Payload Definitions */
+
+#define PAYLOAD_MIC_COUNT					8
+#define PAYLOAD_MIC_SIZE					512
+#define PAYLOAD_GPS_SIZE					64
+#define PAYLOAD_GPS_COUNT					10
+#define PAYLOAD_IMU_COUNT					7
+
+/*	The encoded payload starts with a field-presence mask. Then the present
+	sections follow in the order of mask bits (little-endian):
+
+		+ microphones	--> per channel, 1 byte coding and the samples
+		+ GPS				--> fixed-point binary fields (27 bytes)
+		+ IMU				--> IEEE 754 floats (28 bytes)
+
+	The receiver keeps the last values of absent sections. So the sender
+	sets the GPS and IMU bits only when they are updated. */
+
+#define PAYLOAD_HAS_MIC						0x01
+#define PAYLOAD_HAS_GPS						0x02
+#define PAYLOAD_HAS_IMU						0x04
+#define PAYLOAD_HAS_ALL						0x07
+
+/*	Each microphone channel is either sent raw or as the first differences
+	of its samples. The differences are zigzag coded and bit-packed in the
+	blocks of PAYLOAD_MIC_BLOCK samples, each after its 1 byte bit width.
+	The encoder picks the smaller one, so a channel never grows. */
+
+#define PAYLOAD_MIC_RAW						0
+#define PAYLOAD_MIC_DELTA					1
+#define PAYLOAD_MIC_BLOCK					32
+
+#define PAYLOAD_MAX_ENCODED				\
+	(1 + PAYLOAD_MIC_COUNT * (1 + PAYLOAD_MIC_SIZE) + 27 + 4 * PAYLOAD_IMU_COUNT)
+
+/* Data Structures */
+
+typedef struct _PayloadData
+{
+	/* The microphone sensors payload data  */
+
+	int8_t micNorth[PAYLOAD_MIC_SIZE];
+	int8_t micNorthEast[PAYLOAD_MIC_SIZE];
+	int8_t micEast[PAYLOAD_MIC_SIZE];
+	int8_t micSouthEast[PAYLOAD_MIC_SIZE];
+	int8_t micSouth[PAYLOAD_MIC_SIZE];
+	int8_t micSouthWest[PAYLOAD_MIC_SIZE];
+	int8_t micWest[PAYLOAD_MIC_SIZE];
+	int8_t micNorthWest[PAYLOAD_MIC_SIZE];
+
+	/* The GPS module payload data (NUL-terminated text) */
+
+	char gpsUTCTime[PAYLOAD_GPS_SIZE];	/* hhmmss */
+	char gpsLatitude[PAYLOAD_GPS_SIZE];	/* signed decimal degrees */
+	char gpsLongitude[PAYLOAD_GPS_SIZE];	/* signed decimal degrees */
+	char gpsQuality[PAYLOAD_GPS_SIZE];
+	char gpsNumSat[PAYLOAD_GPS_SIZE];
+	char gpsAltitude[PAYLOAD_GPS_SIZE];	/* meters */
+	char gpsStatus[PAYLOAD_GPS_SIZE];	/* A = valid, V = invalid */
+	char gpsSpeed[PAYLOAD_GPS_SIZE];		/* knots */
+	char gpsCourse[PAYLOAD_GPS_SIZE];	/* degrees */
+	char gpsDate[PAYLOAD_GPS_SIZE];		/* ddmmyy */
+
+	/* The IMU sensor payload data */
+
+	float imuAccelX;						/* m/s^2 */
+	float imuAccelY;						/* m/s^2 */
+	float imuAccelZ;						/* m/s^2 */
+	float imuGyroX;						/* dps */
+	float imuGyroY;						/* dps */
+	float imuGyroZ;						/* dps */
+	float imuTemp;							/* C */
+} PayloadData;
+
+/* Function Prototypes */
+
+extern size_t payload_encode(const PayloadData *data, uint8_t mask,
+	uint8_t *out);
+extern int payload_decode(const uint8_t *in, size_t size, PayloadData *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PAYLOAD_H */
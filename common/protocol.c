@@ -0,0 +1,236 @@
+/**
+ ******************************************************************************
+ * @file 	protocol.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Framed wire protocol between the firmware and ground station.
+ * 
+ ******************************************************************************
+ * @attention
+ * 
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ * 
+ * This software is licensed under the MIT License.
+ * 
+ ******************************************************************************
+ */
+
+#include "./protocol.h"
+
+/* Nibble table of the reflected IEEE 802.3 polynomial (0xEDB88320). */
+
+static const uint32_t crcTable[16] =
+{
+	0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+	0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+	0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+	0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+/**
+ * Write the 16-bit value in little-endian order.
+ */
+static void __put_u16(uint8_t *out, uint16_t value)
+{
+	out[0] = (uint8_t) (value);
+	out[1] = (uint8_t) (value >> 8);
+}
+
+/**
+ * Write the 32-bit value in little-endian order.
+ */
+static void __put_u32(uint8_t *out, uint32_t value)
+{
+	out[0] = (uint8_t) (value);
+	out[1] = (uint8_t) (value >> 8);
+	out[2] = (uint8_t) (value >> 16);
+	out[3] = (uint8_t) (value >> 24);
+}
+
+/**
+ * Read the 16-bit value in little-endian order.
+ */
+static uint16_t __get_u16(const uint8_t *in)
+{
+	return (uint16_t) (in[0] | (in[1] << 8));
+}
+
+/**
+ * Read the 32-bit value in little-endian order.
+ */
+static uint32_t __get_u32(const uint8_t *in)
+{
+	return (uint32_t) in[0] | ((uint32_t) in[1] << 8) |
+			 ((uint32_t) in[2] << 16) | ((uint32_t) in[3] << 24);
+}
+
+/**
+ * Update the CRC32 with given data. Start with 0 for a new checksum.
+ */
+uint32_t protocol_crc32(uint32_t crc, const uint8_t *data, size_t size)
+{
+	size_t i;
+
+	crc = ~crc;
+	for (i = 0; i < size; i++)
+	{
+		crc = crcTable[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+		crc = crcTable[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+	}
+	return ~crc;
+}
+
+/**
+ * Build the header and trailer around the payload. So the payload can be
+ * transmitted from its own place without copying.
+ */
+void protocol_frame_wrap(uint16_t sequence, const void *payload,
+	uint16_t length, uint8_t *header, uint8_t *trailer)
+{
+	uint32_t crc;
+
+	__put_u32(header, PROTOCOL_SYNC_WORD);
+	__put_u16(header + 4, sequence);
+	__put_u16(header + 6, length);
+
+	crc = protocol_crc32(0, header + 4, PROTOCOL_HEADER_SIZE - 4);
+	crc = protocol_crc32(crc, (const uint8_t *) payload, length);
+	__put_u32(trailer, crc);
+}
+
+/**
+ * Build the whole frame into `frame` and return its size.
+ */
+size_t protocol_frame_encode(uint16_t sequence, const void *payload,
+	uint16_t length, uint8_t *frame)
+{
+	protocol_frame_wrap(sequence, payload, length, frame,
+		frame + PROTOCOL_HEADER_SIZE + length);
+	memcpy(frame + PROTOCOL_HEADER_SIZE, payload, length);
+
+	return PROTOCOL_FRAME_SIZE(length);
+}
+
+/**
+ * Drop the first `count` buffered bytes while hunting the sync word.
+ */
+static void __parser_skip(ProtocolParser *parser, size_t count)
+{
+	parser->filled -= count;
+	memmove(parser->buffer, parser->buffer + count, parser->filled);
+	parser->skippedBytes += count;
+}
+
+/**
+ * Drop the bytes of previously returned frame.
+ */
+static void __parser_release(ProtocolParser *parser)
+{
+	if (parser->consumed)
+	{
+		parser->filled -= parser->consumed;
+		memmove(parser->buffer, parser->buffer + parser->consumed,
+			parser->filled);
+		parser->consumed = 0;
+	}
+}
+
+/**
+ * Initialize the stream parser.
+ */
+void protocol_parser_init(ProtocolParser *parser)
+{
+	memset(parser, 0, sizeof(ProtocolParser));
+}
+
+/**
+ * Append the received bytes into parser and return the number of bytes
+ * taken. Call protocol_parser_next() until it returns 0 and then feed the
+ * rest of bytes.
+ */
+size_t protocol_parser_feed(ProtocolParser *parser, const uint8_t *data,
+	size_t size)
+{
+	size_t space;
+
+	__parser_release(parser);
+
+	space = sizeof(parser->buffer) - parser->filled;
+	if (size > space)
+	{
+		size = space;
+	}
+	memcpy(parser->buffer + parser->filled, data, size);
+	parser->filled += size;
+
+	return size;
+}
+
+/**
+ * Find the next valid frame in the buffered bytes. Return 1 and fill the
+ * `frame` if there is one, otherwise return 0.
+ */
+int protocol_parser_next(ProtocolParser *parser, ProtocolFrame *frame)
+{
+	size_t i, size;
+	uint16_t length;
+	uint32_t crc;
+
+	__parser_release(parser);
+
+	for (;;)
+	{
+		/* Hunt the sync word, keep the 3 bytes that may start it. */
+		for (i = 0; i + 4 <= parser->filled; i++)
+		{
+			if (__get_u32(parser->buffer + i) == PROTOCOL_SYNC_WORD)
+			{
+				break;
+			}
+		}
+		if (i > 0)
+		{
+			__parser_skip(parser, i);
+		}
+		if (parser->filled < PROTOCOL_HEADER_SIZE)
+		{
+			return 0;		/* wait for the rest of header */
+		}
+		length = __get_u16(parser->buffer + 6);
+		if (length > PROTOCOL_MAX_PAYLOAD)
+		{
+			__parser_skip(parser, 1);	/* a false sync word */
+			continue;
+		}
+		size = PROTOCOL_FRAME_SIZE(length);
+		if (parser->filled < size)
+		{
+			return 0;		/* wait for the rest of frame */
+		}
+		crc = protocol_crc32(0, parser->buffer + 4,
+			PROTOCOL_HEADER_SIZE - 4 + length);
+		if (crc != __get_u32(parser->buffer + PROTOCOL_HEADER_SIZE + length))
+		{
+			/* Broken frame. Look for another sync word in it. */
+			parser->crcErrors++;
+			__parser_skip(parser, 1);
+			continue;
+		}
+		break;
+	}
+	frame->sequence = __get_u16(parser->buffer + 4);
+	frame->length = length;
+	frame->payload = parser->buffer + PROTOCOL_HEADER_SIZE;
+
+	/* Count the missing frames from the sequence gaps. */
+	if (parser->synced && frame->sequence != parser->expected)
+	{
+		parser->lostFrames += (uint16_t) (frame->sequence - parser->expected);
+	}
+	parser->synced = 1;
+	parser->expected = frame->sequence + 1;
+	parser->frames++;
+	parser->consumed = size;
+
+	return 1;
+}
@@ -0,0 +1,88 @@
+/**
+ ******************************************************************************
+ * @file 	protocol.h
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Framed wire protocol between the firmware and ground station.
+ * 
+ ******************************************************************************
+ * @attention
+ * 
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ * 
+ * This software is licensed under the MIT License.
+ * 
+ ******************************************************************************
+ */
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Libraries (portable, also built for the firmware) */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/* Protocol Definitions */
+
+/*	Each frame is sent in little-endian byte order:
+
+		+-----------+----------+--------+-----------------+--------+
+		| sync word | sequence | length | payload         | CRC32  |
+		| 4 bytes   | 2 bytes  | 2 bytes| 'length' bytes  | 4 bytes|
+		+-----------+----------+--------+-----------------+--------+
+
+	The CRC32 (IEEE 802.3) covers the sequence, length and payload. So a
+	receiver can hunt the sync word again after any lost or broken byte. */
+
+#define PROTOCOL_SYNC_WORD					0xDEADBEEF
+#define PROTOCOL_HEADER_SIZE				8
+#define PROTOCOL_TRAILER_SIZE				4
+#define PROTOCOL_MAX_PAYLOAD				6144
+#define PROTOCOL_FRAME_SIZE(length)		\
+	(PROTOCOL_HEADER_SIZE + (length) + PROTOCOL_TRAILER_SIZE)
+
+/* Data Structures */
+
+typedef struct _ProtocolFrame
+{
+	uint16_t sequence;						/* sender frame counter */
+	uint16_t length;							/* payload length in bytes */
+	const uint8_t *payload;					/* valid until the next parse */
+} ProtocolFrame;
+
+typedef struct _ProtocolParser
+{
+	uint8_t buffer[PROTOCOL_FRAME_SIZE(PROTOCOL_MAX_PAYLOAD)];
+	size_t filled;								/* buffered bytes */
+	size_t consumed;							/* bytes of the last frame */
+	int synced;									/* any frame received yet */
+	uint16_t expected;						/* next sequence number */
+	uint32_t frames;							/* valid frames */
+	uint32_t crcErrors;						/* frames with wrong CRC */
+	uint32_t lostFrames;						/* gaps in sequence numbers */
+	uint32_t skippedBytes;					/* bytes dropped while hunting */
+} ProtocolParser;
+
+/* Function Prototypes */
+
+extern uint32_t protocol_crc32(uint32_t crc, const uint8_t *data, size_t size);
+extern void protocol_frame_wrap(uint16_t sequence, const void *payload,
+	uint16_t length, uint8_t *header, uint8_t *trailer);
+extern size_t protocol_frame_encode(uint16_t sequence, const void *payload,
+	uint16_t length, uint8_t *frame);
+extern void protocol_parser_init(ProtocolParser *parser);
+extern size_t protocol_parser_feed(ProtocolParser *parser, const uint8_t *data,
+	size_t size);
+extern int protocol_parser_next(ProtocolParser *parser, ProtocolFrame *frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROTOCOL_H */
@@ -29,6 +29,7 @@ SPI_HandleTypeDef	hspi1 = {0};	/* IMU Sensor Port */
 SD_HandleTypeDef hsdmmc1 = {0};	/* SD Card Port */
 DFSDM_Channel_HandleTypeDef hdfsdm1c[CHANNEL_COUNT] = {0};
 DFSDM_Filter_HandleTypeDef hdfsdm1f[CHANNEL_COUNT] = {0};
+Decimator micDecimator = {0};
 
 /**
  * Configurate the oscillator and clock sources.
@@ -172,6 +173,14 @@ void configMicSensors(void)
 			printError(status, "Failed to assign the filter to channel!");
 		}
 	}
+
+	/* Design the decimator from the rate of each interleaved channel to
+		the audio rate. */
+	if (decimator_init(&micDecimator, MIC_CHANNEL_RATE, MIC_DECIMATION, 
+		MIC_PASSBAND, MIC_ATTENUATION) < 0)
+	{
+		printKernel("Failed to design the mic decimator!");
+	}
 }
 
 /**
@@ -38,6 +38,9 @@
 
 #include "./kernel.h"
 #include "./peripheral.h"
+#include "protocol.h"			/* shared with ground station (../common) */
+#include "payload.h"
+#include "decimator.h"
 
 /* Global and General Definitions */
 
@@ -48,6 +51,7 @@
 #define CHANNEL_COUNT		4
 #define MIC_COUNT				(CHANNEL_COUNT * 2)
 #define START_SECTOR			0x1000	/* 4096 bytes, after 2MB of FAT/reserved */
+#define REFRESH_PERIOD		16			/* frames between full GPS/IMU updates */
 
 #define FILE					__FILE__
 #define LINE					__LINE__
@@ -82,51 +86,15 @@ extern SPI_HandleTypeDef hspi1;										/* IMU Sensor */
 extern SD_HandleTypeDef	hsdmmc1;										/* SD Card */
 extern DFSDM_Channel_HandleTypeDef hdfsdm1c[CHANNEL_COUNT];	/* Mic Sensor */
 extern DFSDM_Filter_HandleTypeDef hdfsdm1f[CHANNEL_COUNT];	/* Mic Sensor */
+extern Decimator micDecimator;								/* Mic Sensor */
 
 extern SemaphoreHandle_t payloadMutex;	/* Mutex for payload data */
 
 /*****************************************************************************/
 /*****************************************************************************/
 
-/* Data Structures and Enumerations */
-typedef struct PACKED _PayloadData
-{
-	/* The microphone sensors payload data  */
-
-	int8_t micNorth[DATA_SIZE];
-	int8_t micNorthEast[DATA_SIZE];
-	int8_t micEast[DATA_SIZE];
-	int8_t micSouthEast[DATA_SIZE];
-	int8_t micSouth[DATA_SIZE];
-	int8_t micSouthWest[DATA_SIZE];
-	int8_t micWest[DATA_SIZE];
-	int8_t micNorthWest[DATA_SIZE];
-
-	/* The GPS module payload data */
-
-	uint8_t gpsUTCTime[GPS_SIZE];
-	uint8_t gpsLatitude[GPS_SIZE];
-	uint8_t gpsLongitude[GPS_SIZE];
-	uint8_t gpsQuality[GPS_SIZE];
-	uint8_t gpsNumSat[GPS_SIZE];
-	uint8_t gpsAltitude[GPS_SIZE];
-	uint8_t gpsStatus[GPS_SIZE];
-	uint8_t gpsSpeed[GPS_SIZE];		/* knots */
-	uint8_t gpsCourse[GPS_SIZE];		/* degrees */
-	uint8_t gpsDate[GPS_SIZE];
-
-	/* The IMU sensor payload data */
-	
-	float imuAccelX;						/* m/s^2 */
-	float imuAccelY;						/* m/s^2 */
-	float imuAccelZ;						/* m/s^2 */
-	float imuGyroX;						/* dps */
-	float imuGyroY;						/* dps */
-	float imuGyroZ;						/* dps */
-	float imuTemp;							/* C */ 
-} PayloadData;
-
 extern PayloadData payloadData;
+extern uint8_t payloadUpdated;			/* sections updated since last frame */
 
 /*****************************************************************************/
 /*****************************************************************************/
@@ -370,6 +338,8 @@ extern uint8_t __read_reg_from_imu(uint8_t);
 extern void __read_accel_from_imu(PayloadData *);
 extern void __read_gyro_from_imu(PayloadData *);
 extern void __read_temp_from_imu(PayloadData *);
+extern void __read_mic_samples(DFSDM_Filter_HandleTypeDef *, uint32_t, 
+	DecimatorChannel *, int32_t *);
 extern void __get_sd_card_info(void);
 
 #endif /* FIRMWARE_H */
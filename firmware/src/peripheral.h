@@ -262,7 +262,8 @@
  * System Clock:								100 MHz
  * DFSDM Clock:								100 MHz / DIVIDER = 3.125 MHz
  * Filter Output Rate:						3.125 MHz / OVERSAMPLING = 48.828 kHz
- * Actual Audio Rate:						48.828 kHz / (ORDER + 1) = 12.207 kHz
+ * Channel Rate:							48.828 kHz / 2 (left, right) = 24.414 kHz
+ * Actual Audio Rate:						24.414 kHz / DECIMATION = 12.207 kHz
  */
 
 #define MIC_PIN_DATAIN0						GPIO_PIN_1	/* GPIOC - DFSDM1 */ 
@@ -281,6 +282,11 @@
 #define MIC_RIGHT_SHIFT						0
 #define MIC_SINC_ORDER						DFSDM_FILTER_SINC3_ORDER
 #define MIC_OVERSAMPLING					64
+#define MIC_FILTER_RATE						48828.125f	/* Hz */
+#define MIC_CHANNEL_RATE					(MIC_FILTER_RATE / 2.0f)
+#define MIC_DECIMATION						2
+#define MIC_PASSBAND							3000.0f		/* Hz */
+#define MIC_ATTENUATION						60.0f			/* dB */
 
 /* LED Definitions */
 
@@ -20,6 +20,7 @@
 /* Global and shared variables. */
 
 PayloadData payloadData = {0};
+uint8_t payloadUpdated = 0;
 SemaphoreHandle_t payloadMutex;
 
 /**
@@ -29,6 +30,7 @@ void taskMicSensorNorth(void *pvParams)
 {
 	int32_t i;
 	int32_t samples[SAMPLE_SIZE] = {0};
+	static DecimatorChannel channels[2];
 	HAL_StatusTypeDef status;
 	
 	printLog("I'm taskMicSensorNorth() task!");
@@ -42,18 +44,8 @@ void taskMicSensorNorth(void *pvParams)
 
 	for (;;)
 	{
-		/* Poll the regular conversion simultaneously. */
-		for (i = 0; i < SAMPLE_SIZE; i++)
-		{
-			status = HAL_DFSDM_FilterPollForRegConversion(&hdfsdm1f[0], HAL_MAX_DELAY);
-			if (status != HAL_OK)
-			{
-				printError(status, "Failed to poll DFSDM conversion!");
-			}
-			/* Get the digital MEMS mic data and then shift it. */
-			samples[i] = HAL_DFSDM_FilterGetRegularValue(&hdfsdm1f[0], 0);
-			samples[i] = samples[i] >> 24;	/* 8-bit MSB */
-		}
+		/* Poll and decimate the conversions of both channels. */
+		__read_mic_samples(&hdfsdm1f[0], 0, channels, samples);
 		/* Take the mutex to update shared variable. */
 		if (xSemaphoreTake(payloadMutex, portMAX_DELAY) == pdTRUE)
 		{
@@ -77,6 +69,7 @@ void taskMicSensorEast(void *pvParams)
 {
 	int32_t i;
 	int32_t samples[SAMPLE_SIZE] = {0};
+	static DecimatorChannel channels[2];
 	HAL_StatusTypeDef status;
 
 	printLog("I'm taskMicSensorEast() task!");
@@ -90,18 +83,8 @@ void taskMicSensorEast(void *pvParams)
 
 	for (;;)
 	{
-		/* Poll the regular conversion simultaneously. */
-		for (i = 0; i < SAMPLE_SIZE; i++)
-		{
-			status = HAL_DFSDM_FilterPollForRegConversion(&hdfsdm1f[1], HAL_MAX_DELAY);
-			if (status != HAL_OK)
-			{
-				printError(status, "Failed to poll DFSDM conversion!");
-			}
-			/* Get the digital MEMS mic data and then shift it. */
-			samples[i] = HAL_DFSDM_FilterGetRegularValue(&hdfsdm1f[1], 1);
-			samples[i] = samples[i] >> 24;	/* 8-bit MSB */
-		}
+		/* Poll and decimate the conversions of both channels. */
+		__read_mic_samples(&hdfsdm1f[1], 1, channels, samples);
 		/* Take the mutex to update shared variable. */
 		if (xSemaphoreTake(payloadMutex, portMAX_DELAY) == pdTRUE)
 		{
@@ -125,6 +108,7 @@ void taskMicSensorSouth(void *pvParams)
 {
 	int32_t i;
 	int32_t samples[SAMPLE_SIZE] = {0};
+	static DecimatorChannel channels[2];
 	HAL_StatusTypeDef status;
 
 	printLog("I'm taskMicSensorSouth() task!");
@@ -138,18 +122,8 @@ void taskMicSensorSouth(void *pvParams)
 
 	for (;;)
 	{
-		/* Poll the regular conversion simultaneously. */
-		for (i = 0; i < SAMPLE_SIZE; i++)
-		{
-			status = HAL_DFSDM_FilterPollForRegConversion(&hdfsdm1f[2], HAL_MAX_DELAY);
-			if (status != HAL_OK)
-			{
-				printError(status, "Failed to poll DFSDM conversion!");
-			}
-			/* Get the digital MEMS mic data and then shift it. */
-			samples[i] = HAL_DFSDM_FilterGetRegularValue(&hdfsdm1f[2], 2);
-			samples[i] = samples[i] >> 24;	/* 8-bit MSB */
-		}
+		/* Poll and decimate the conversions of both channels. */
+		__read_mic_samples(&hdfsdm1f[2], 2, channels, samples);
 		/* Take the mutex to update shared variable. */
 		if (xSemaphoreTake(payloadMutex, portMAX_DELAY) == pdTRUE)
 		{
@@ -173,6 +147,7 @@ void taskMicSensorWest(void *pvParams)
 {
 	int32_t i;
 	int32_t samples[SAMPLE_SIZE] = {0};
+	static DecimatorChannel channels[2];
 	HAL_StatusTypeDef status;
 
 	printLog("I'm taskMicSensorWest() task!");
@@ -186,18 +161,8 @@ void taskMicSensorWest(void *pvParams)
 
 	for (;;)
 	{
-		/* Poll the regular conversion simultaneously. */
-		for (i = 0; i < SAMPLE_SIZE; i++)
-		{
-			status = HAL_DFSDM_FilterPollForRegConversion(&hdfsdm1f[3], HAL_MAX_DELAY);
-			if (status != HAL_OK)
-			{
-				printError(status, "Failed to poll DFSDM conversion!");
-			}
-			/* Get the digital MEMS mic data and then shift it. */
-			samples[i] = HAL_DFSDM_FilterGetRegularValue(&hdfsdm1f[3], 3);
-			samples[i] = samples[i] >> 24;	/* 8-bit MSB */
-		}
+		/* Poll and decimate the conversions of both channels. */
+		__read_mic_samples(&hdfsdm1f[3], 3, channels, samples);
 		/* Take the mutex to update shared variable. */
 		if (xSemaphoreTake(payloadMutex, portMAX_DELAY) == pdPASS)
 		{
@@ -237,6 +202,7 @@ void taskGPSModule(void *pvParams)
 		{
 			/* Parse the NMEA sentences. */
 			__parse_nmea_sentences(buffer, &payloadData);
+			payloadUpdated |= PAYLOAD_HAS_GPS;
 
 			/* Give up the mutex. */
 			xSemaphoreGive(payloadMutex);
@@ -280,6 +246,7 @@ void taskIMUSensor(void *pvParams)
 			__read_accel_from_imu(&payloadData);
 			__read_gyro_from_imu(&payloadData);
 			__read_temp_from_imu(&payloadData);
+			payloadUpdated |= PAYLOAD_HAS_IMU;
 
 			/* Give up the mutex. */
 			xSemaphoreGive(payloadMutex);
@@ -356,6 +323,13 @@ void taskServoMotors(void *pvParams)
  */
 void taskLoRaModule(void *pvParams)
 {
+	uint16_t sequence = 0;
+	uint16_t length;
+	uint8_t mask;
+	uint8_t header[PROTOCOL_HEADER_SIZE];
+	uint8_t trailer[PROTOCOL_TRAILER_SIZE];
+	static uint8_t encoded[PAYLOAD_MAX_ENCODED];
+
 	printLog("I'm taskLoRaModule() task!");
 
 	for (;;)
@@ -363,11 +337,27 @@ void taskLoRaModule(void *pvParams)
 		/* Take the mutex to update shared variable. */
 		if (xSemaphoreTake(payloadMutex, portMAX_DELAY) == pdPASS)
 		{
-			/* Transmit the packed structure to ground station. */
-			HAL_UART_Transmit(&huart5, (uint8_t *) &payloadData, sizeof(payloadData), HAL_MAX_DELAY);
+			/* Send GPS and IMU only when they are updated, but refresh them 
+				periodically in case the ground station lost a frame. */
+			mask = PAYLOAD_HAS_MIC | payloadUpdated;
+			if (sequence % REFRESH_PERIOD == 0)
+			{
+				mask = PAYLOAD_HAS_ALL;
+			}
+			length = payload_encode(&payloadData, mask, encoded);
+			payloadUpdated = 0;
 
 			/* Give up the mutex. */
 			xSemaphoreGive(payloadMutex);
+
+			/* Frame the encoded payload with sync word, sequence, length 
+				and CRC32. So the ground station can resynchronize. */
+			protocol_frame_wrap(sequence++, encoded, length, header, trailer);
+
+			/* Transmit the framed payload to ground station. */
+			HAL_UART_Transmit(&huart5, header, PROTOCOL_HEADER_SIZE, HAL_MAX_DELAY);
+			HAL_UART_Transmit(&huart5, encoded, length, HAL_MAX_DELAY);
+			HAL_UART_Transmit(&huart5, trailer, PROTOCOL_TRAILER_SIZE, HAL_MAX_DELAY);
 		}
 		/* Give some delay. */
 		vTaskDelay(TASK_LORA_DELAY);
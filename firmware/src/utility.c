@@ -174,6 +174,38 @@ void __read_temp_from_imu(PayloadData *payloadData)
 	payloadData->imuTemp = (((temp_h << 8) | temp_l) / 256.0f) + 25.0f;
 }
 
+/**
+ * Read the interleaved left and right conversions of the DFSDM filter and
+ * decimate them to the audio rate, until SAMPLE_SIZE samples are ready.
+ */
+void __read_mic_samples(DFSDM_Filter_HandleTypeDef *filter, uint32_t channel,
+	DecimatorChannel *channels, int32_t *samples)
+{
+	int32_t i = 0, count = 0, sample;
+	float value;
+	HAL_StatusTypeDef status;
+
+	/* Both channels run in step, so the outputs stay interleaved. */
+	while (count < SAMPLE_SIZE)
+	{
+		status = HAL_DFSDM_FilterPollForRegConversion(filter, HAL_MAX_DELAY);
+		if (status != HAL_OK)
+		{
+			printError(status, "Failed to poll DFSDM conversion!");
+		}
+		/* Get the digital MEMS mic data and then filter it. */
+		value = (float) HAL_DFSDM_FilterGetRegularValue(filter, channel);
+		if (decimator_push(&micDecimator, &channels[i % 2], value, &value))
+		{
+			/* The filter overshoots on loud input, keep it in 8 bits. */
+			sample = (int32_t) lroundf(value / 16777216.0f);	/* 8-bit MSB */
+			samples[count++] = (sample > INT8_MAX) ? INT8_MAX :
+				(sample < INT8_MIN) ? INT8_MIN : sample;
+		}
+		i++;
+	}
+}
+
 /**
  * Get the SD Card information.
  */
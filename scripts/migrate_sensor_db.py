@@ -0,0 +1,90 @@
+"""
+Sensor Database Migration
+-------------------------
+
+The ground station stored only the north microphone channel in 512 INTEGER
+columns (Data1..Data512) of "SensorData" table. The schema version 2 keeps
+the whole frame in each row, all 8 channels in a single "Microphones" BLOB
+(channel-major int8 samples) with the IMU/GPS columns and a monotonic frame
+sequence.
+
+The ground station migrates the database that it opens. This script does
+the same for the archived databases, without running the ground station:
+
+$ python3 migrate_sensor_db.py [-h] database [database ...]
+
+The old rows keep their order. Only their north channel has samples and
+their missing samples become 0.
+"""
+
+# Import the libraries.
+
+import sys, time, argparse, sqlite3
+
+SCHEMA_VERSION	= 2
+TABLE				= "SensorData"
+DATA_SIZE		= 512
+MIC_COUNT		= 8
+MIC_RAW			= 0
+TIME_FORMAT		= "%Y-%m-%d %H:%M:%S"
+
+CREATE_TABLE = f"""
+CREATE TABLE IF NOT EXISTS {TABLE} (ID INTEGER PRIMARY KEY AUTOINCREMENT,
+	Sequence INTEGER NOT NULL, Received INTEGER NOT NULL,
+	Timestamp TEXT NOT NULL, MicEncoding INTEGER NOT NULL,
+	Microphones BLOB NOT NULL, AccelX REAL, AccelY REAL, AccelZ REAL,
+	GyroX REAL, GyroY REAL, GyroZ REAL, Temperature REAL, UTCTime TEXT,
+	Latitude REAL, Longitude REAL, Quality INTEGER, NumSat INTEGER,
+	Altitude REAL, Status TEXT, Speed REAL, Course REAL, Date TEXT);
+CREATE UNIQUE INDEX IF NOT EXISTS {TABLE}Sequence ON {TABLE} (Sequence);
+PRAGMA user_version={SCHEMA_VERSION};
+"""
+
+def migrate(path):
+	"""Convert the version 1 table of database into the BLOB layout."""
+
+	db = sqlite3.connect(path, isolation_level=None)
+	columns = [row[1] for row in db.execute(f"PRAGMA table_info({TABLE})")]
+	if "Data1" not in columns:
+		print(f"'{path}' doesn't have a version 1 table, skipped.")
+		return
+
+	data = ", ".join(f"Data{i}" for i in range(1, DATA_SIZE + 1))
+	padding = bytes(DATA_SIZE * (MIC_COUNT - 1))
+
+	db.execute("BEGIN")
+	db.execute(f"ALTER TABLE {TABLE} RENAME TO {TABLE}V1")
+	for statement in CREATE_TABLE.split(";"):
+		db.execute(statement)
+
+	rows = db.execute(f"SELECT {data}, Timestamp FROM {TABLE}V1 ORDER BY ID")
+	for sequence, row in enumerate(rows.fetchall()):
+		samples = bytes((value or 0) & 0xFF for value in row[:DATA_SIZE])
+		received = int(time.mktime(time.strptime(row[-1], TIME_FORMAT)))
+		db.execute(
+			f"INSERT INTO {TABLE} (Sequence, Received, Timestamp, MicEncoding, "
+			f"Microphones) VALUES (?, ?, ?, ?, ?)",
+			(sequence, received * 1000000, row[-1], MIC_RAW, samples + padding)
+		)
+	db.execute(f"DROP TABLE {TABLE}V1")
+	db.execute("COMMIT")
+	db.execute("VACUUM")
+
+	count = db.execute(f"SELECT COUNT(*) FROM {TABLE}").fetchone()[0]
+	print(f"Migrated {count} rows of '{path}' into the schema version "
+			f"{SCHEMA_VERSION}.")
+	db.close()
+
+# Parse the command-line arguments.
+
+parser = argparse.ArgumentParser(
+	prog = sys.argv[0],
+	description = "Sensor database migration to the BLOB schema",
+	epilog="The database is converted in place, so keep a copy of it."
+)
+
+parser.add_argument("database", type=str, nargs="+")
+args = parser.parse_args()
+
+for path in args.database:
+	migrate(path)
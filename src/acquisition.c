@@ -0,0 +1,216 @@
+/**
+ ******************************************************************************
+ * @file 	acquisition.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Serial acquisition thread of AeroSONAR.
+ * 
+ ******************************************************************************
+ * @attention
+ * 
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ * 
+ * This software is licensed under the MIT License.
+ * 
+ ******************************************************************************
+ */
+
+#include "main.h"
+
+/* Global and Shared Variables */
+
+PayloadRing payloadRing = {0};
+
+static pthread_t readerThread;
+static ProtocolParser readerParser;
+static PayloadData readerFrame;			/* keeps the absent sections */
+static int readerFd = -1;
+static int readerPipe[2] = {-1, -1};		/* wakes up the reader to stop */
+static atomic_bool readerRunning = false;
+
+/**
+ * Push a frame into the ring. It's only called by the producer thread.
+ */
+gboolean ring_push(PayloadRing *ring, const PayloadData *frame)
+{
+	size_t head, tail;
+
+	head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+	if (head - tail == RING_CAPACITY)
+	{
+		/* The consumer is too slow, so drop the newest frame. */
+		atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+		return FALSE;
+	}
+	memcpy(&ring->frames[head & (RING_CAPACITY - 1)], frame,
+		sizeof(PayloadData));
+	atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+
+	return TRUE;
+}
+
+/**
+ * Pop a frame from the ring. It's only called by the consumer thread.
+ */
+gboolean ring_pop(PayloadRing *ring, PayloadData *frame)
+{
+	size_t head, tail;
+
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	head = atomic_load_explicit(&ring->head, memory_order_acquire);
+	if (head == tail)
+	{
+		return FALSE;		/* there is no frame yet */
+	}
+	memcpy(frame, &ring->frames[tail & (RING_CAPACITY - 1)],
+		sizeof(PayloadData));
+	atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+
+	return TRUE;
+}
+
+/**
+ * Decode and push the valid frames that parser found in the received bytes.
+ */
+static void __device_frames(const uint8_t *data, size_t size)
+{
+	size_t taken;
+	ProtocolFrame frame;
+
+	while (size > 0)
+	{
+		taken = protocol_parser_feed(&readerParser, data, size);
+		data += taken;
+		size -= taken;
+		while (protocol_parser_next(&readerParser, &frame))
+		{
+			if (payload_decode(frame.payload, frame.length, &readerFrame) < 0)
+			{
+				printWarning("dropped a malformed payload of %u bytes",
+					frame.length);
+				continue;
+			}
+			ring_push(&payloadRing, &readerFrame);
+		}
+	}
+}
+
+/**
+ * Read the device node on its own thread and push the complete frames.
+ */
+static void *__device_reader(void *arg)
+{
+	struct pollfd fds[2];
+	uint8_t buffer[BUFFER_SIZE * 2];
+	ssize_t numRead;
+
+	fds[0].fd = readerFd;
+	fds[0].events = POLLIN;
+	fds[1].fd = readerPipe[0];
+	fds[1].events = POLLIN;
+
+	while (atomic_load(&readerRunning))
+	{
+		/* Sleep until the device has data or the reader is stopped. */
+		if (poll(fds, 2, -1) == -1)
+		{
+			if (errno == EINTR)
+				continue;
+			syscallError();
+		}
+		if (fds[1].revents & POLLIN)
+		{
+			break;
+		}
+		if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL))
+		{
+			printWarning("lost the device node, stopped the reader");
+			break;
+		}
+		numRead = read_device_node(readerFd, buffer, sizeof(buffer));
+		__device_frames(buffer, numRead);
+	}
+	return NULL;
+}
+
+/**
+ * Start the reader thread of the open device node.
+ */
+void start_device_reader(int fd)
+{
+	int err;
+
+	if (atomic_load(&readerRunning))
+	{
+		return;		/* there is already a running reader */
+	}
+	readerFd = fd;
+	protocol_parser_init(&readerParser);
+	memset(&readerFrame, 0, sizeof(PayloadData));
+	atomic_store(&payloadRing.head, 0);
+	atomic_store(&payloadRing.tail, 0);
+	atomic_store(&payloadRing.dropped, 0);
+
+	if (pipe2(readerPipe, O_CLOEXEC) == -1)
+		syscallError();
+
+	atomic_store(&readerRunning, true);
+	err = pthread_create(&readerThread, NULL, __device_reader, NULL);
+	if (err != 0)
+	{
+		errno = err;
+		syscallError();
+	}
+	printLog("started the device reader thread");
+}
+
+/**
+ * Stop the reader thread before the device node is closed.
+ */
+void stop_device_reader(void)
+{
+	int err;
+
+	if (!atomic_load(&readerRunning))
+	{
+		return;
+	}
+	atomic_store(&readerRunning, false);
+	if (write(readerPipe[1], "x", 1) == -1)	/* wake up the poll() */
+		syscallError();
+
+	err = pthread_join(readerThread, NULL);
+	if (err != 0)
+	{
+		errno = err;
+		syscallError();
+	}
+	if (close(readerPipe[0]) == -1 || close(readerPipe[1]) == -1)
+		syscallError();
+
+	readerPipe[0] = readerPipe[1] = -1;
+	readerFd = -1;
+	printLog("stopped the device reader thread (%u frames, %u CRC errors, "
+		"%u lost, %zu dropped)", readerParser.frames, readerParser.crcErrors,
+		readerParser.lostFrames, atomic_load(&payloadRing.dropped));
+}
+
+/**
+ * Drain the received frames and keep the latest one. Every frame is also
+ * recorded if there is a `recorder`. Return the number of drained frames.
+ */
+int drain_device_frames(PayloadData *latest, DbRecorder *recorder)
+{
+	int count = 0;
+
+	while (ring_pop(&payloadRing, latest))
+	{
+		if (recorder != NULL)
+		{
+			db_recorder_write(recorder, latest);
+		}
+		count++;
+	}
+	return count;
+}
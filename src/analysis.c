@@ -19,112 +19,14 @@
 
 /* Global and Shared Variables */
 
-DspTime sigSamples[MIC_COUNT] = {0};
 DspTime sigBeamformed = {0};
 guint sigVolumest = 1;
+double sigFrequency = 0.0;
+int sigArrival = 0;
+double sigPower[PIPELINE_SCAN_ANGLES] = {0};
 
-/**
- * Convert the payload mic data to 'DspTime' objects.
- */
-void convert_payload_to_sample(void)
-{
-	int i;
-
-	/* Convert the payload data to 'DspTime' objects. */
-	for (i = 0; i < MIC_COUNT; i++)
-	{
-		sigSamples[i].length = DATA_SIZE;
-	}
-	for (i = 0; i < DATA_SIZE; i++)
-	{
-		sigSamples[0].data[i] = (double) payloadData.micNorth[i];
-		sigSamples[1].data[i] = (double) payloadData.micNorthEast[i];
-		sigSamples[2].data[i] = (double) payloadData.micEast[i];
-		sigSamples[3].data[i] = (double) payloadData.micSouthEast[i];
-		sigSamples[4].data[i] = (double) payloadData.micSouth[i];
-		sigSamples[5].data[i] = (double) payloadData.micSouthWest[i];
-		sigSamples[6].data[i] = (double) payloadData.micWest[i];
-		sigSamples[7].data[i] = (double) payloadData.micNorthWest[i];
-	}
-}
-
-/**
- * Find the dominant frequency around the mic outputs.
- */
-double find_dominant_freq(void)
-{
-	int i;
-	DspFreq outputs[MIC_COUNT];
-	DspTime magnitudes[MIC_COUNT];
-	int indexes[MIC_COUNT];
-	double frequencies[MIC_COUNT];
-	double max_freq = 0;
-
-	/* Convert the time domain signals into frequency domain. */
-	for (i = 0; i < MIC_COUNT; i++)
-	{
-		dsp_transform_dft(&sigSamples[i], &outputs[i]);
-		outputs[i].length = (int) (outputs[i].length / 2);
-	}
-	/* Find the maximum frequencies and corresponding bins. */
-	for (i = 0; i < MIC_COUNT; i++)
-	{
-		dsp_freq_magnitude(&outputs[i], &magnitudes[i]);
-		magnitudes[i].data[0] = 0.0;	/* pass the DC bias */
-		indexes[i] = dsp_time_argmax(&magnitudes[i]);
-		frequencies[i] = (MIC_SAMPLE_FREQ / DATA_SIZE) * indexes[i];
-	}
-	/* Compare the frequencies to find the maximum. */
-	for (i = 0; i < MIC_COUNT; i++)
-	{
-		if (frequencies[i] > max_freq)
-		{
-			max_freq = frequencies[i];
-		}
-	}
-	return max_freq;
-}
-
-/**
- * Calculate the arrival of angle from coming signals.
- */
-int calculate_arrival(double freq)
-{
-	int i;
-	DspArrival arrival;
-
-	arrival.mics = MIC_COUNT;
-	arrival.freq = freq;
-	arrival.radius = MIC_RADIUS;
-	arrival.sources = 1;
-	for (i = 0; i < MIC_COUNT; i++)
-	{
-		arrival.samples[i] = &sigSamples[i];	/* samples itself */
-	}
-	return dsp_arrival_music(&arrival);
-}
-
-/**
- * Make the delay-and-sum beamforming.
- */
-DspTime do_beamforming(double freq, double arrival)
-{
-	int i;
-	DspBeamform beamform;
-	DspTime sample;
-
-	beamform.mics = MIC_COUNT;	
-	beamform.freq = freq;	
-	beamform.radius = MIC_RADIUS;	
-	beamform.theta = arrival;
-	for (i = 0; i < MIC_COUNT; i++)	
-	{
-		beamform.samples[i] = &sigSamples[i];	/* samples itself */
-	}
-	dsp_beamform_delay_sum(&beamform, &sample);
-
-	return sample;
-}
+static Pipeline sigPipeline;
+static DspPool sigPool;
 
 /**
  * Make the other signal analysis to update `MicSignal` struct.
@@ -133,19 +35,21 @@ void make_signal_analysis(DspTime *beamformed, int arrival)
 {
 	int i;
 	char buffer[MIC_SIGNAL_NUM][BUFFER_SIZE];
+	PipelineStats stats;
 
 	/* Make the signal analysis one by one. */
-	snprintf(buffer[0], BUFFER_SIZE, "%.4f", dsp_time_max(beamformed));	/* maximum */
-	snprintf(buffer[1], BUFFER_SIZE, "%.4f", dsp_time_min(beamformed));	/* minimum */
-	snprintf(buffer[2], BUFFER_SIZE, "%.4f", dsp_time_mean(beamformed));	/* mean */
-	snprintf(buffer[3], BUFFER_SIZE, "%.4f", dsp_time_stddev(beamformed)); /* standard deviation */
-	snprintf(buffer[4], BUFFER_SIZE, "%.4f", dsp_time_energy(beamformed));	/* energy */
-	snprintf(buffer[5], BUFFER_SIZE, "%.4f", dsp_time_rms(beamformed));	/* RMS */
-	snprintf(buffer[6], BUFFER_SIZE, "%.4f", dsp_time_power(beamformed));	/* power */
-	snprintf(buffer[7], BUFFER_SIZE, "%.4f", dsp_time_crest_factor(beamformed));	/* crest factor */
-	snprintf(buffer[8], BUFFER_SIZE, "%.4f", dsp_time_skewness(beamformed));	/* skewness */
-	snprintf(buffer[9], BUFFER_SIZE, "%.4f", dsp_time_kurtosis(beamformed));	/* kurtosis */
-	snprintf(buffer[10], BUFFER_SIZE, "%.4f", dsp_time_variance(beamformed));	/* variance */
+	pipeline_stats(beamformed, &stats);
+	snprintf(buffer[0], BUFFER_SIZE, "%.4f", stats.max);	/* maximum */
+	snprintf(buffer[1], BUFFER_SIZE, "%.4f", stats.min);	/* minimum */
+	snprintf(buffer[2], BUFFER_SIZE, "%.4f", stats.mean);	/* mean */
+	snprintf(buffer[3], BUFFER_SIZE, "%.4f", stats.stddev); /* standard deviation */
+	snprintf(buffer[4], BUFFER_SIZE, "%.4f", stats.energy);	/* energy */
+	snprintf(buffer[5], BUFFER_SIZE, "%.4f", stats.rms);	/* RMS */
+	snprintf(buffer[6], BUFFER_SIZE, "%.4f", stats.power);	/* power */
+	snprintf(buffer[7], BUFFER_SIZE, "%.4f", stats.crestFactor);	/* crest factor */
+	snprintf(buffer[8], BUFFER_SIZE, "%.4f", stats.skewness);	/* skewness */
+	snprintf(buffer[9], BUFFER_SIZE, "%.4f", stats.kurtosis);	/* kurtosis */
+	snprintf(buffer[10], BUFFER_SIZE, "%.4f", stats.variance);	/* variance */
 	snprintf(buffer[11], BUFFER_SIZE, "%d", arrival);	/* arrival of angle */
 
 	/* Update the signal analysis rows. */
@@ -156,36 +60,40 @@ void make_signal_analysis(DspTime *beamformed, int arrival)
 }
 
 /**
- * Return the sector that has much more intensity.
+ * Run the analysis pipeline on the current payload. It doesn't touch any
+ * widget, so the recorded sessions can be replayed without the GUI.
  */
-int select_sector(void)
+void analyze_payload(void)
 {
-	int i;
-	double means[MIC_COUNT], biggest;
-
-	/* Get the mean of sensor signals. */
-	for (i = 0; i < MIC_COUNT; i++)
+	if (sigPipeline.arena.base == NULL)
 	{
-		means[i] = dsp_time_mean(&sigSamples[i]);
-	}
-	/* Find the biggest mean. */
-	biggest = means[0];
-	for (i = 0; i < MIC_COUNT; i++)
-	{
-		if (means[i] > biggest)
+		pipeline_init(&sigPipeline, ANALYSIS_PRECISION);
+		if (ANALYSIS_WIDEBAND)
 		{
-			biggest = means[i];
+			dsp_pool_init(&sigPool, ANALYSIS_SRP_WORKERS);
+			pipeline_srp(&sigPipeline, &sigPool);
 		}
-	}
-	for (i = 0; i < MIC_COUNT; i++)
-	{
-		if (means[i] == biggest)
+		else
+		{
+			pipeline_track(&sigPipeline, ANALYSIS_MUSIC_FORGET,
+				ANALYSIS_MUSIC_REFRESH);
+		}
+		if (ANALYSIS_MVDR)
 		{
-			return i + 1;
+			pipeline_mvdr(&sigPipeline, PIPELINE_MVDR_LOADING);
+		}
+		if (ANALYSIS_BAND_ORDER > 0)
+		{
+			pipeline_band(&sigPipeline, ANALYSIS_BAND_ORDER);
 		}
 	}
-	/* Never should come here. */
-	return -1;
+	pipeline_run(&sigPipeline, &payloadData);
+
+	sigFrequency = sigPipeline.frequency;
+	sigArrival = sigPipeline.arrival;
+	sigBeamformed = sigPipeline.beamformed;
+	sigVolumest = sigPipeline.sector;
+	memcpy(sigPower, sigPipeline.power, sizeof(sigPower));
 }
 
 /**
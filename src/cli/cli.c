@@ -0,0 +1,409 @@
+/**
+ ******************************************************************************
+ * @file 	cli.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Headless batch-processing CLI of AeroSONAR.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./cli.h"
+
+/*	The CLI runs the acoustic pipeline on the raw captures of device node
+	(e.g. 'cat /dev/ttyUSB0 > flight.cap') without any display:
+
+		$ SONAR_CLI [-f csv|json] [-j jobs] [-p 32|64] [-d music|esprit|srp|tdoa] [-b sum|mvdr] [-o output]
+			capture...
+
+	The frames are parsed into batches and a worker per core analyzes
+	them. The results are written in the capture order. */
+
+static CliBatch cliBatch;
+static PipelinePrecision cliPrecision = PIPELINE_FLOAT64;
+static PipelineDoa cliDoa = PIPELINE_MUSIC;
+static PipelineBeam cliBeam = PIPELINE_DELAY_SUM;
+
+static const char *usage =
+	"Usage: " CLI_PROGRAM " [-f csv|json] [-j jobs] [-p 32|64] [-d music|esprit|srp|tdoa] [-b sum|mvdr] [-o output] capture...\n"
+	"\n"
+	"  -f  output format, 'csv' (default) or 'json' (one object per line)\n"
+	"  -j  worker threads, the online cores by default\n"
+	"  -p  precision of spectral kernels, 32 or 64 (default) bits\n"
+	"  -d  arrival of angle method, 'music' (default), 'esprit', 'srp' or 'tdoa'\n"
+	"  -b  beamformer, delay-and-'sum' (default) or 'mvdr'\n"
+	"  -o  output file, the standard output by default\n";
+
+/**
+ * Open the capture file to parse its frames.
+ */
+void cli_reader_open(CliReader *reader, const char *path)
+{
+	memset(reader, 0, sizeof(CliReader));
+	reader->path = path;
+	reader->fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (reader->fd == -1)
+		syscallError();
+
+	protocol_parser_init(&reader->parser);
+}
+
+/**
+ * Parse the next valid frame of capture. Return 0 at the end of capture.
+ */
+int cli_reader_next(CliReader *reader, CliFrame *frame)
+{
+	ssize_t numRead;
+	ProtocolFrame parsed;
+
+	for (;;)
+	{
+		while (protocol_parser_next(&reader->parser, &parsed))
+		{
+			if (payload_decode(parsed.payload, parsed.length, &reader->frame) < 0)
+			{
+				fprintf(stderr, "%s: skipped a malformed payload of %u bytes\n",
+					reader->path, parsed.length);
+				continue;
+			}
+			memcpy(&frame->payload, &reader->frame, sizeof(PayloadData));
+			frame->file = reader->path;
+			frame->index = reader->frames++;
+			frame->sequence = parsed.sequence;
+
+			return 1;
+		}
+		if (reader->offset < reader->filled)
+		{
+			/* Feed the rest of buffer that the parser didn't take yet. */
+			reader->offset += protocol_parser_feed(&reader->parser,
+				reader->buffer + reader->offset, reader->filled - reader->offset);
+			continue;
+		}
+		numRead = read(reader->fd, reader->buffer, sizeof(reader->buffer));
+		if (numRead == -1)
+		{
+			if (errno == EINTR)
+				continue;
+			syscallError();
+		}
+		if (numRead == 0)
+		{
+			return 0;		/* end of capture */
+		}
+		reader->filled = numRead;
+		reader->offset = 0;
+	}
+}
+
+/**
+ * Close the capture file.
+ */
+void cli_reader_close(CliReader *reader)
+{
+	if (close(reader->fd) == -1)
+		syscallError();
+
+	reader->fd = -1;
+}
+
+/**
+ * Write the JSON string with the required escapes.
+ */
+static void __write_json_string(FILE *output, const char *text)
+{
+	fputc('"', output);
+	for (; *text != '\0'; text++)
+	{
+		if (*text == '"' || *text == '\\')
+		{
+			fprintf(output, "\\%c", *text);
+		}
+		else if ((unsigned char) *text < 0x20)
+		{
+			fprintf(output, "\\u%04x", (unsigned char) *text);
+		}
+		else
+		{
+			fputc(*text, output);
+		}
+	}
+	fputc('"', output);
+}
+
+/**
+ * Write the header of output if the format has any.
+ */
+void cli_write_header(FILE *output, CliFormat format)
+{
+	if (format == CLI_FORMAT_CSV)
+	{
+		fprintf(output, "file,frame,sequence,frequency,arrival,sector,max,min,"
+			"mean,stddev,energy,rms,power,crest_factor,skewness,kurtosis,"
+			"variance\n");
+	}
+}
+
+/**
+ * Write the analysis results of frame.
+ */
+void cli_write_frame(FILE *output, CliFormat format, const CliFrame *frame)
+{
+	const char *c;
+	const PipelineStats *stats = &frame->stats;
+
+	if (format == CLI_FORMAT_CSV)
+	{
+		/* The file names are quoted as RFC 4180 only when they need it. */
+		if (strpbrk(frame->file, ",\"\n") != NULL)
+		{
+			fputc('"', output);
+			for (c = frame->file; *c != '\0'; c++)
+			{
+				if (*c == '"')
+					fputc('"', output);
+				fputc(*c, output);
+			}
+			fputc('"', output);
+		}
+		else
+		{
+			fputs(frame->file, output);
+		}
+		fprintf(output, ",%lu,%u,%.4f,%d,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,"
+			"%.4f,%.4f,%.4f,%.4f,%.4f\n", frame->index, frame->sequence,
+			frame->frequency, frame->arrival, frame->sector, stats->max,
+			stats->min, stats->mean, stats->stddev, stats->energy, stats->rms,
+			stats->power, stats->crestFactor, stats->skewness, stats->kurtosis,
+			stats->variance);
+	}
+	else
+	{
+		fprintf(output, "{\"file\":");
+		__write_json_string(output, frame->file);
+		fprintf(output, ",\"frame\":%lu,\"sequence\":%u,\"frequency\":%.4f,"
+			"\"arrival\":%d,\"sector\":%d,\"beamformed\":{\"max\":%.4f,"
+			"\"min\":%.4f,\"mean\":%.4f,\"stddev\":%.4f,\"energy\":%.4f,"
+			"\"rms\":%.4f,\"power\":%.4f,\"crest_factor\":%.4f,"
+			"\"skewness\":%.4f,\"kurtosis\":%.4f,\"variance\":%.4f}}\n",
+			frame->index, frame->sequence, frame->frequency, frame->arrival,
+			frame->sector, stats->max, stats->min, stats->mean, stats->stddev,
+			stats->energy, stats->rms, stats->power, stats->crestFactor,
+			stats->skewness, stats->kurtosis, stats->variance);
+	}
+}
+
+/**
+ * Analyze the claimed frames of each batch on its own pipeline.
+ */
+static void *__worker(void *arg)
+{
+	int i;
+	Pipeline *pipeline;
+	CliFrame *frame;
+
+	pipeline = malloc(sizeof(Pipeline));	/* too big for the stack */
+	if (pipeline == NULL)
+		syscallError();
+
+	pipeline_init(pipeline, cliPrecision);
+	if (cliDoa == PIPELINE_ESPRIT)
+	{
+		pipeline_esprit(pipeline);
+	}
+	else if (cliDoa == PIPELINE_SRP_PHAT)
+	{
+		pipeline_srp(pipeline, NULL);		/* the frames are already parallel */
+	}
+	else if (cliDoa == PIPELINE_GCC_PHAT)
+	{
+		pipeline_tdoa(pipeline);
+	}
+	if (cliBeam == PIPELINE_MVDR)
+	{
+		pipeline_mvdr(pipeline, PIPELINE_MVDR_LOADING);
+	}
+
+	for (;;)
+	{
+		pthread_barrier_wait(&cliBatch.start);
+		if (cliBatch.stop)
+		{
+			break;
+		}
+		while ((i = atomic_fetch_add(&cliBatch.next, 1)) < cliBatch.count)
+		{
+			frame = &cliBatch.frames[i];
+			pipeline_run(pipeline, &frame->payload);
+
+			frame->frequency = pipeline->frequency;
+			frame->arrival = pipeline->arrival;
+			frame->sector = pipeline->sector;
+			pipeline_stats(&pipeline->beamformed, &frame->stats);
+		}
+		pthread_barrier_wait(&cliBatch.done);
+	}
+	free(pipeline);
+
+	return NULL;
+}
+
+/**
+ * Return the seconds of monotonic clock.
+ */
+static double __seconds(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[])
+{
+	int i, opt, err, jobs = 0;
+	unsigned long frames = 0, crcErrors = 0, lostFrames = 0;
+	double started, elapsed;
+	CliFormat format = CLI_FORMAT_CSV;
+	FILE *output = stdout;
+	pthread_t workers[CLI_MAX_WORKERS];
+	static CliReader reader;
+
+	while ((opt = getopt(argc, argv, "f:j:p:d:b:o:h")) != -1)
+	{
+		switch (opt)
+		{
+			case 'f':
+				if (strcmp(optarg, "csv") == 0)
+					format = CLI_FORMAT_CSV;
+				else if (strcmp(optarg, "json") == 0)
+					format = CLI_FORMAT_JSON;
+				else
+					customError("unknown output format '%s'", optarg);
+				break;
+			case 'j':
+				jobs = atoi(optarg);
+				if (jobs < 1 || jobs > CLI_MAX_WORKERS)
+					customError("the jobs must be between 1 and %d",
+						CLI_MAX_WORKERS);
+				break;
+			case 'p':
+				if (strcmp(optarg, "32") == 0)
+					cliPrecision = PIPELINE_FLOAT32;
+				else if (strcmp(optarg, "64") == 0)
+					cliPrecision = PIPELINE_FLOAT64;
+				else
+					customError("unknown precision '%s'", optarg);
+				break;
+			case 'd':
+				if (strcmp(optarg, "music") == 0)
+					cliDoa = PIPELINE_MUSIC;
+				else if (strcmp(optarg, "esprit") == 0)
+					cliDoa = PIPELINE_ESPRIT;
+				else if (strcmp(optarg, "srp") == 0)
+					cliDoa = PIPELINE_SRP_PHAT;
+				else if (strcmp(optarg, "tdoa") == 0)
+					cliDoa = PIPELINE_GCC_PHAT;
+				else
+					customError("unknown arrival method '%s'", optarg);
+				break;
+			case 'b':
+				if (strcmp(optarg, "sum") == 0)
+					cliBeam = PIPELINE_DELAY_SUM;
+				else if (strcmp(optarg, "mvdr") == 0)
+					cliBeam = PIPELINE_MVDR;
+				else
+					customError("unknown beamformer '%s'", optarg);
+				break;
+			case 'o':
+				output = fopen(optarg, "w");
+				if (output == NULL)
+					syscallError();
+				break;
+			default:
+				fputs(usage, (opt == 'h') ? stdout : stderr);
+				exit((opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE);
+		}
+	}
+	if (optind >= argc)
+	{
+		fputs(usage, stderr);
+		exit(EXIT_FAILURE);
+	}
+	if (jobs == 0)
+	{
+		jobs = (int) sysconf(_SC_NPROCESSORS_ONLN);
+		jobs = (jobs < 1) ? 1 : (jobs > CLI_MAX_WORKERS) ? CLI_MAX_WORKERS : jobs;
+	}
+
+	/* Start the workers, the main thread joins both barriers too. */
+	pthread_barrier_init(&cliBatch.start, NULL, jobs + 1);
+	pthread_barrier_init(&cliBatch.done, NULL, jobs + 1);
+	for (i = 0; i < jobs; i++)
+	{
+		err = pthread_create(&workers[i], NULL, __worker, NULL);
+		if (err != 0)
+		{
+			errno = err;
+			syscallError();
+		}
+	}
+	cli_write_header(output, format);
+	started = __seconds();
+
+	for (; optind < argc; optind++)
+	{
+		cli_reader_open(&reader, argv[optind]);
+		do
+		{
+			/* Parse a batch of frames and analyze them in parallel. */
+			cliBatch.count = 0;
+			while (cliBatch.count < CLI_BATCH_FRAMES &&
+				cli_reader_next(&reader, &cliBatch.frames[cliBatch.count]))
+			{
+				cliBatch.count++;
+			}
+			atomic_store(&cliBatch.next, 0);
+			pthread_barrier_wait(&cliBatch.start);
+			pthread_barrier_wait(&cliBatch.done);
+
+			for (i = 0; i < cliBatch.count; i++)
+			{
+				cli_write_frame(output, format, &cliBatch.frames[i]);
+			}
+			frames += cliBatch.count;
+		}
+		while (cliBatch.count == CLI_BATCH_FRAMES);
+
+		crcErrors += reader.parser.crcErrors;
+		lostFrames += reader.parser.lostFrames;
+		cli_reader_close(&reader);
+	}
+
+	/* Release the workers from their last wait. */
+	cliBatch.stop = 1;
+	pthread_barrier_wait(&cliBatch.start);
+	for (i = 0; i < jobs; i++)
+	{
+		pthread_join(workers[i], NULL);
+	}
+	elapsed = __seconds() - started;
+
+	if (fflush(output) == EOF || (output != stdout && fclose(output) == EOF))
+		syscallError();
+
+	fprintf(stderr, "%lu frames in %.3f s (%.1f frames/s, %d jobs), "
+		"%lu CRC errors, %lu lost frames\n", frames, elapsed,
+		frames / ((elapsed > 0.0) ? elapsed : 1e-9), jobs, crcErrors,
+		lostFrames);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,131 @@
+/**
+ ******************************************************************************
+ * @file 	cli.h
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Headless batch-processing CLI of AeroSONAR.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#ifndef CLI_H
+#define CLI_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Standard C Libraries */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+/* Project Libraries */
+
+#include "../../common/protocol.h"
+#include "../../common/payload.h"
+#include "../pipeline.h"
+
+/* Global macro definitions */
+
+#define CLI_PROGRAM							"SONAR_CLI"
+#define CLI_BATCH_FRAMES					256		/* frames per batch */
+#define CLI_READ_SIZE						8192		/* bytes per read */
+#define CLI_MAX_WORKERS						256
+
+/* Error handling macros */
+
+#define syscallError()																		\
+{                                      												\
+	fprintf(stderr, "\n*** %s (%s::%d in %s()) ***\n", strerror(errno),		\
+			  __FILE__, __LINE__, __func__);		   	 									\
+	exit(EXIT_FAILURE);	/* exit with failure status */							\
+}
+
+#define customError(errmsg, ...) 														\
+{                            																\
+	fprintf(stderr, "\n*** " errmsg " (%s::%d in %s()) ***\n",					\
+			  ##__VA_ARGS__, __FILE__, __LINE__, __func__);							\
+	exit(EXIT_FAILURE);	/* exit with failure status */							\
+}
+
+/* Global enumerations */
+
+typedef enum _CliFormat
+{
+	CLI_FORMAT_CSV,
+	CLI_FORMAT_JSON							/* one object per line */
+} CliFormat;
+
+/* Global structures */
+
+typedef struct _CliFrame
+{
+	/* A decoded frame and its analysis results. */
+
+	PayloadData payload;
+	const char *file;							/* capture of frame */
+	unsigned long index;						/* frame index in capture */
+	uint16_t sequence;						/* sender frame counter */
+	double frequency;							/* dominant frequency in Hz */
+	int arrival;								/* arrival of angle in degrees */
+	int sector;									/* loudest sector, 1 to 8 */
+	PipelineStats stats;						/* beamformed signal */
+} CliFrame;
+
+typedef struct _CliBatch
+{
+	/* The frames that the workers analyze together. The workers claim
+		the frames one by one, so the slow frames don't stall the others. */
+
+	CliFrame frames[CLI_BATCH_FRAMES];
+	int count;									/* filled frames */
+	atomic_int next;							/* next frame to claim */
+	int stop;									/* no batch anymore */
+	pthread_barrier_t start;
+	pthread_barrier_t done;
+} CliBatch;
+
+typedef struct _CliReader
+{
+	/* The capture file that is parsed frame by frame. */
+
+	const char *path;
+	int fd;
+	ProtocolParser parser;
+	PayloadData frame;						/* keeps the absent sections */
+	uint8_t buffer[CLI_READ_SIZE];
+	size_t filled;								/* bytes read into buffer */
+	size_t offset;								/* bytes fed into parser */
+	unsigned long frames;					/* decoded frames */
+} CliReader;
+
+/* Function prototypes */
+
+extern void cli_reader_open(CliReader *, const char *);
+extern int cli_reader_next(CliReader *, CliFrame *);
+extern void cli_reader_close(CliReader *);
+extern void cli_write_header(FILE *, CliFormat);
+extern void cli_write_frame(FILE *, CliFormat, const CliFrame *);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLI_H */
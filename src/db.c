@@ -17,6 +17,27 @@
 
 #include "main.h"
 
+/*	The sensor data table keeps a whole frame in each row (schema version 2):
+
+		+ Sequence		--> monotonic frame counter over all sessions
+		+ Received		--> wall-clock receive time (microseconds)
+		+ Timestamp		--> receive time as text
+		+ MicEncoding	--> DB_MIC_RAW or DB_MIC_ENCODED
+		+ Microphones	--> 8 channels of int8 samples (N, NE, E, ..., NW)
+		+ Accel*, Gyro*, Temperature
+		+ UTCTime, Latitude, ..., Date (NULL until the GPS has a value)
+
+	The version 1 table had only the north channel in Data1..Data512 INTEGER
+	columns. db_migrate_table() converts it in place. */
+
+#define DB_COLUMNS																			\
+	"Sequence, Received, Timestamp, MicEncoding, Microphones, "						\
+	"AccelX, AccelY, AccelZ, GyroX, GyroY, GyroZ, Temperature, "					\
+	"UTCTime, Latitude, Longitude, Quality, NumSat, Altitude, Status, "			\
+	"Speed, Course, Date"
+#define DB_PARAMETERS																		\
+	"?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?"
+
 /**
  * Open the SQLite3 database.
  */
@@ -32,87 +53,386 @@ struct sqlite3 *db_open(const char *filepath)
 	return db;
 }
 
+/**
+ * Run the SQL statement that doesn't return any row.
+ */
+static void __db_exec(struct sqlite3 *db, const char *sql)
+{
+	int rc;
+
+	rc = sqlite3_exec(db, sql, 0, 0, 0);
+	if (rc != SQLITE_OK)
+		dbError(db);
+}
+
+/**
+ * Run the SQL query and return the integer in its first column.
+ */
+static sqlite3_int64 __db_query_int(struct sqlite3 *db, const char *sql)
+{
+	int rc;
+	sqlite3_int64 value = 0;
+	sqlite3_stmt *stmt;
+
+	rc = sqlite3_prepare_v2(db, sql, -1, &stmt, 0);
+	if (rc != SQLITE_OK)
+		dbError(db);
+
+	if (sqlite3_step(stmt) == SQLITE_ROW)
+	{
+		value = sqlite3_column_int64(stmt, 0);
+	}
+	rc = sqlite3_finalize(stmt);
+	if (rc != SQLITE_OK)
+		dbError(db);
+
+	return value;
+}
+
 /**
  * Create a new table into the open database.
  */
 void db_create_table(struct sqlite3 *db, Database database)
 {
-	int i, rc;
-	char data[32];
 	char sql[SQL_SIZE];
 
 	/* Create the database table for sensor data. */
 	if (database == DATABASE_SENSOR_DATA)
 	{
-		sprintf(sql, 
-			"CREATE TABLE IF NOT EXISTS %s (ID INTEGER "
-			"PRIMARY KEY AUTOINCREMENT,", DB_SENSOR_DATA_TABLE
+		sprintf(sql,
+			"CREATE TABLE IF NOT EXISTS %s (ID INTEGER PRIMARY KEY AUTOINCREMENT, "
+			"Sequence INTEGER NOT NULL, Received INTEGER NOT NULL, "
+			"Timestamp TEXT NOT NULL, MicEncoding INTEGER NOT NULL, "
+			"Microphones BLOB NOT NULL, AccelX REAL, AccelY REAL, AccelZ REAL, "
+			"GyroX REAL, GyroY REAL, GyroZ REAL, Temperature REAL, UTCTime TEXT, "
+			"Latitude REAL, Longitude REAL, Quality INTEGER, NumSat INTEGER, "
+			"Altitude REAL, Status TEXT, Speed REAL, Course REAL, Date TEXT);"
+			"CREATE UNIQUE INDEX IF NOT EXISTS %sSequence ON %s (Sequence);"
+			"PRAGMA user_version=%d;",
+			DB_SENSOR_DATA_TABLE, DB_SENSOR_DATA_TABLE, DB_SENSOR_DATA_TABLE,
+			DB_SCHEMA_VERSION
 		);
-		/* Append the data columns from 1 to DATA_SIZE. */
-		for (i = 1; i <= DATA_SIZE; i++)
-		{
-			memset(data, 0, 32);		/* initialize 0s */
-			sprintf(data, "Data%d INTEGER,", i);
-			strcat(sql, data);
-		}
-		/* Latly, insert the date and time timestamp. */
-		strcat(sql, "Timestamp TEXT NOT NULL);");
 	}
-	rc = sqlite3_exec(db, sql, 0, 0, 0);
-	if (rc != SQLITE_OK)
-		dbError(db);
+	__db_exec(db, sql);
 }
 
 /**
- * Bind the appropriate data into the open database.
+ * Convert the version 1 sensor data table into the BLOB layout. The old
+ * rows keep their order, only their north channel has samples.
  */
-void db_bind_data(struct sqlite3 *db, Database database)
+void db_migrate_table(struct sqlite3 *db)
 {
-	int i, rc;
-	char data[16];
+	int i, rc, length = 0;
 	char sql[SQL_SIZE];
-	sqlite3_stmt *stmt;
-	
-	/* Bind the "micSensorData" structure into open database. */
-	if (database == DATABASE_SENSOR_DATA)
+	int8_t samples[DB_MIC_SIZE];
+	struct tm tm;
+	sqlite3_int64 count = 0;
+	sqlite3_stmt *select, *insert;
+
+	sprintf(sql, "SELECT COUNT(*) FROM pragma_table_info('%s') "
+		"WHERE name = 'Data1';", DB_SENSOR_DATA_TABLE);
+	if (__db_query_int(db, sql) == 0)
 	{
-		/* Build the sql sequence. */
-		sprintf(sql, "INSERT INTO %s (", DB_SENSOR_DATA_TABLE);
-		for (i = 1; i <= DATA_SIZE; i++)
-		{
-			memset(data, 0, 16);		/* initialize with 0s */
-			sprintf(data, "Data%d, ", i);
-			strcat(sql, data);
-		}
-		strcat(sql, "Timestamp) VALUES (");
-		for (i = 1; i <= DATA_SIZE; i++)
+		return;		/* there is no version 1 table */
+	}
+	__db_exec(db, "BEGIN;");
+	__db_exec(db, "ALTER TABLE " DB_SENSOR_DATA_TABLE " RENAME TO "
+		DB_SENSOR_DATA_TABLE "V1;");
+	db_create_table(db, DATABASE_SENSOR_DATA);
+
+	/* Read the old rows in their insertion order. */
+	length += sprintf(sql + length, "SELECT ");
+	for (i = 1; i <= DATA_SIZE; i++)
+	{
+		length += sprintf(sql + length, "Data%d, ", i);
+	}
+	sprintf(sql + length, "Timestamp FROM %sV1 ORDER BY ID;",
+		DB_SENSOR_DATA_TABLE);
+
+	rc = sqlite3_prepare_v2(db, sql, -1, &select, 0);
+	if (rc != SQLITE_OK)
+		dbError(db);
+	rc = sqlite3_prepare_v2(db, "INSERT INTO " DB_SENSOR_DATA_TABLE
+		" (Sequence, Received, Timestamp, MicEncoding, Microphones) "
+		"VALUES (?, ?, ?, ?, ?);", -1, &insert, 0);
+	if (rc != SQLITE_OK)
+		dbError(db);
+
+	memset(samples, 0, DB_MIC_SIZE);
+	while ((rc = sqlite3_step(select)) == SQLITE_ROW)
+	{
+		for (i = 0; i < DATA_SIZE; i++)
 		{
-			strcat(sql, "?, ");
+			samples[i] = (int8_t) sqlite3_column_int(select, i);
 		}
-		strcat(sql, "?);");
+		/* The receive time only has seconds in the old table. */
+		memset(&tm, 0, sizeof(struct tm));
+		tm.tm_isdst = -1;
+		strptime((const char *) sqlite3_column_text(select, DATA_SIZE),
+			TIME_FORMAT, &tm);
 
-		/* Bind the sql sequence into the open database. */
-		rc = sqlite3_prepare_v2(db, sql, -1, &stmt, 0);
-		if (rc != SQLITE_OK)
+		sqlite3_bind_int64(insert, 1, count++);
+		sqlite3_bind_int64(insert, 2, (sqlite3_int64) mktime(&tm) * 1000000);
+		sqlite3_bind_value(insert, 3, sqlite3_column_value(select, DATA_SIZE));
+		sqlite3_bind_int(insert, 4, DB_MIC_RAW);
+		sqlite3_bind_blob(insert, 5, samples, DB_MIC_SIZE, SQLITE_STATIC);
+
+		if (sqlite3_step(insert) != SQLITE_DONE)
 			dbError(db);
+		sqlite3_reset(insert);
+	}
+	if (rc != SQLITE_DONE)
+		dbError(db);
 
-		for (i = 1; i <= DATA_SIZE; i++)
-		{
-			sqlite3_bind_int(stmt, i, payloadData.micNorth[i - 1]);
-		}
-		sqlite3_bind_text(stmt, DATA_SIZE + 1, 
-			get_time(TIME_FORMAT), -1, SQLITE_STATIC);
+	sqlite3_finalize(select);
+	sqlite3_finalize(insert);
+
+	__db_exec(db, "DROP TABLE " DB_SENSOR_DATA_TABLE "V1;");
+	__db_exec(db, "COMMIT;");
+
+	printLog("migrated %lld rows of '%s' into the schema version %d",
+		(long long) count, DB_SENSOR_DATA_TABLE, DB_SCHEMA_VERSION);
+}
+
+/**
+ * Open the database for recording a session. It enables the write-ahead
+ * log, sets the `synchronous` mode and prepares the insertion once.
+ */
+void db_recorder_open(DbRecorder *recorder, const char *filepath,
+	const char *synchronous)
+{
+	int rc;
+	char sql[SQL_SIZE];
+
+	if (recorder->db != NULL)
+	{
+		return;		/* there is already an open session */
 	}
-	printLog("recorded the sensor data into '%s'", DB_SENSOR_DATA_PATH);
+	memset(recorder, 0, sizeof(DbRecorder));
+	recorder->db = db_open(filepath);
+
+	/* The readers don't block the writer and the commits append to log. */
+	__db_exec(recorder->db, "PRAGMA journal_mode=WAL;");
+	sprintf(sql, "PRAGMA synchronous=%s;", synchronous);
+	__db_exec(recorder->db, sql);
+
+	db_migrate_table(recorder->db);
+	db_create_table(recorder->db, DATABASE_SENSOR_DATA);
+
+	/* Continue the frame sequence of previous sessions. */
+	recorder->sequence = __db_query_int(recorder->db, "SELECT "
+		"IFNULL(MAX(Sequence) + 1, 0) FROM " DB_SENSOR_DATA_TABLE ";");
 
-	/* Step and finalize the current insertion. */
+	rc = sqlite3_prepare_v3(recorder->db, "INSERT INTO " DB_SENSOR_DATA_TABLE
+		" (" DB_COLUMNS ") VALUES (" DB_PARAMETERS ");", -1,
+		SQLITE_PREPARE_PERSISTENT, &recorder->insert, 0);
+	if (rc != SQLITE_OK)
+		dbError(recorder->db);
+
+	printLog("opened the recorder of '%s' (synchronous=%s)", filepath,
+		synchronous);
+}
+
+/**
+ * Bind the GPS text as a number, or NULL if the text is empty.
+ */
+static void __bind_gps(sqlite3_stmt *stmt, int index, const char *text,
+	gboolean integer)
+{
+	if (text[0] == '\0')
+	{
+		sqlite3_bind_null(stmt, index);
+	}
+	else if (integer)
+	{
+		sqlite3_bind_int(stmt, index, atoi(text));
+	}
+	else
+	{
+		sqlite3_bind_double(stmt, index, atof(text));
+	}
+}
+
+/**
+ * Bind the GPS text as it is, or NULL if the text is empty.
+ */
+static void __bind_gps_text(sqlite3_stmt *stmt, int index, const char *text)
+{
+	if (text[0] == '\0')
+	{
+		sqlite3_bind_null(stmt, index);
+	}
+	else
+	{
+		sqlite3_bind_text(stmt, index, text, -1, SQLITE_STATIC);
+	}
+}
+
+/**
+ * Record the frame into open transaction. The transaction is committed
+ * when it has DB_COMMIT_ROWS rows or it is older than DB_COMMIT_INTERVAL.
+ */
+void db_recorder_write(DbRecorder *recorder, const PayloadData *frame)
+{
+	int rc;
+	size_t size;
+	sqlite3_stmt *stmt = recorder->insert;
+	static uint8_t mics[PAYLOAD_MAX_ENCODED];
+
+	if (recorder->db == NULL)
+	{
+		return;
+	}
+	if (recorder->pending == 0)
+	{
+		__db_exec(recorder->db, "BEGIN;");
+		recorder->began = g_get_monotonic_time();
+	}
+	sqlite3_bind_int64(stmt, 1, recorder->sequence);
+	sqlite3_bind_int64(stmt, 2, g_get_real_time());
+	sqlite3_bind_text(stmt, 3, get_time(TIME_FORMAT), -1, SQLITE_TRANSIENT);
+
+	/* Store the 8 channels as a single BLOB. */
+	if (DB_MIC_ENCODING == DB_MIC_ENCODED)
+	{
+		size = payload_encode(frame, PAYLOAD_HAS_MIC, mics);
+	}
+	else
+	{
+		size = db_pack_mics(frame, (int8_t *) mics);
+	}
+	sqlite3_bind_int(stmt, 4, DB_MIC_ENCODING);
+	sqlite3_bind_blob(stmt, 5, mics, size, SQLITE_STATIC);
+
+	sqlite3_bind_double(stmt, 6, frame->imuAccelX);
+	sqlite3_bind_double(stmt, 7, frame->imuAccelY);
+	sqlite3_bind_double(stmt, 8, frame->imuAccelZ);
+	sqlite3_bind_double(stmt, 9, frame->imuGyroX);
+	sqlite3_bind_double(stmt, 10, frame->imuGyroY);
+	sqlite3_bind_double(stmt, 11, frame->imuGyroZ);
+	sqlite3_bind_double(stmt, 12, frame->imuTemp);
+
+	__bind_gps_text(stmt, 13, frame->gpsUTCTime);
+	__bind_gps(stmt, 14, frame->gpsLatitude, FALSE);
+	__bind_gps(stmt, 15, frame->gpsLongitude, FALSE);
+	__bind_gps(stmt, 16, frame->gpsQuality, TRUE);
+	__bind_gps(stmt, 17, frame->gpsNumSat, TRUE);
+	__bind_gps(stmt, 18, frame->gpsAltitude, FALSE);
+	__bind_gps_text(stmt, 19, frame->gpsStatus);
+	__bind_gps(stmt, 20, frame->gpsSpeed, FALSE);
+	__bind_gps(stmt, 21, frame->gpsCourse, FALSE);
+	__bind_gps_text(stmt, 22, frame->gpsDate);
+
+	/* Step and reset the cached insertion for the next frame. */
 	rc = sqlite3_step(stmt);
 	if (rc != SQLITE_DONE)
-		dbError(db);
-	
-	rc = sqlite3_finalize(stmt);
+		dbError(recorder->db);
+
+	rc = sqlite3_reset(stmt);
 	if (rc != SQLITE_OK)
-		dbError(db);
+		dbError(recorder->db);
+
+	recorder->sequence++;
+	recorder->pending++;
+	recorder->rows++;
+
+	db_recorder_commit(recorder, recorder->pending >= DB_COMMIT_ROWS);
+}
+
+/**
+ * Commit the open transaction if it is `forced` or older than
+ * DB_COMMIT_INTERVAL.
+ */
+void db_recorder_commit(DbRecorder *recorder, gboolean forced)
+{
+	gint64 age;
+
+	if (recorder->db == NULL || recorder->pending == 0)
+	{
+		return;
+	}
+	age = g_get_monotonic_time() - recorder->began;
+	if (forced || age >= DB_COMMIT_INTERVAL * 1000)
+	{
+		__db_exec(recorder->db, "COMMIT;");
+		recorder->pending = 0;
+		recorder->commits++;
+	}
+}
+
+/**
+ * Commit the pending rows and close the database of session.
+ */
+void db_recorder_close(DbRecorder *recorder)
+{
+	int rc;
+
+	if (recorder->db == NULL)
+	{
+		return;
+	}
+	db_recorder_commit(recorder, TRUE);
+
+	rc = sqlite3_finalize(recorder->insert);
+	if (rc != SQLITE_OK)
+		dbError(recorder->db);
+
+	db_close(recorder->db);
+	printLog("recorded %" G_GUINT64_FORMAT " frames in %" G_GUINT64_FORMAT
+		" transactions", recorder->rows, recorder->commits);
+
+	recorder->db = NULL;
+	recorder->insert = NULL;
+}
+
+/**
+ * Copy the 8 microphone channels into `samples` in the BLOB order and
+ * return the copied size.
+ */
+size_t db_pack_mics(const PayloadData *frame, int8_t *samples)
+{
+	int i;
+	const int8_t *channels[PAYLOAD_MIC_COUNT] = {
+		frame->micNorth, frame->micNorthEast, frame->micEast,
+		frame->micSouthEast, frame->micSouth, frame->micSouthWest,
+		frame->micWest, frame->micNorthWest
+	};
+
+	for (i = 0; i < PAYLOAD_MIC_COUNT; i++)
+	{
+		memcpy(samples + i * PAYLOAD_MIC_SIZE, channels[i], PAYLOAD_MIC_SIZE);
+	}
+	return DB_MIC_SIZE;
+}
+
+/**
+ * Restore the 8 microphone channels from the BLOB of a row. Return FALSE
+ * if the BLOB is malformed.
+ */
+gboolean db_unpack_mics(const void *blob, int size, int encoding,
+	PayloadData *frame)
+{
+	int i;
+	const int8_t *samples = blob;
+	int8_t *channels[PAYLOAD_MIC_COUNT] = {
+		frame->micNorth, frame->micNorthEast, frame->micEast,
+		frame->micSouthEast, frame->micSouth, frame->micSouthWest,
+		frame->micWest, frame->micNorthWest
+	};
+
+	if (encoding == DB_MIC_ENCODED)
+	{
+		return payload_decode(blob, size, frame) == PAYLOAD_HAS_MIC;
+	}
+	if (encoding != DB_MIC_RAW || size != DB_MIC_SIZE)
+	{
+		return FALSE;
+	}
+	for (i = 0; i < PAYLOAD_MIC_COUNT; i++)
+	{
+		memcpy(channels[i], samples + i * PAYLOAD_MIC_SIZE, PAYLOAD_MIC_SIZE);
+	}
+	return TRUE;
 }
 
 /**
@@ -120,27 +440,30 @@ void db_bind_data(struct sqlite3 *db, Database database)
  */
 void db_query_data(struct sqlite3 *db, Database database)
 {
-	int i, rc;
+	int rc;
 	sqlite3_stmt *stmt;
 	char sql[SQL_SIZE];
 
-	/* Get the binded data of "micSensorData". */
+	/* Get the recorded frames of sensor data. */
 	if (database == DATABASE_SENSOR_DATA)
 	{
-		sprintf(sql, "SELECT * FROM %s", DB_SENSOR_DATA_TABLE);
+		sprintf(sql, "SELECT ID, Sequence, Timestamp, MicEncoding, "
+			"LENGTH(Microphones), Latitude, Longitude FROM %s;",
+			DB_SENSOR_DATA_TABLE);
 
 		rc = sqlite3_prepare_v2(db, sql, -1, &stmt, 0);
 		if (rc != SQLITE_OK)
 			dbError(db);
-			
+
 		while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
 		{
-			printf("ID: %d, ", sqlite3_column_int(stmt, 0));
-			for (i = 1; i <= DATA_SIZE; i++)
-			{
-				printf("Data%d: %d, ", i, sqlite3_column_int(stmt, i));
-			}
-			printf("Timestamp: %s\n", sqlite3_column_text(stmt, 513));
+			printf("ID: %d, Sequence: %lld, Timestamp: %s, Encoding: %d, "
+				"Microphones: %d bytes, Latitude: %f, Longitude: %f\n",
+				sqlite3_column_int(stmt, 0),
+				(long long) sqlite3_column_int64(stmt, 1),
+				sqlite3_column_text(stmt, 2), sqlite3_column_int(stmt, 3),
+				sqlite3_column_int(stmt, 4), sqlite3_column_double(stmt, 5),
+				sqlite3_column_double(stmt, 6));
 		}
 	}
 	/* Finalize the reading operations. */
@@ -155,7 +478,7 @@ void db_query_data(struct sqlite3 *db, Database database)
 void db_close(struct sqlite3 *db)
 {
 	int rc;
-	
+
 	rc = sqlite3_close(db);
 	if (rc != SQLITE_OK)
 		dbError(db);
@@ -0,0 +1,186 @@
+/**
+ ******************************************************************************
+ * @file 	arena.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Scratch arenas and variable-length sample views.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+
+/*	An arena hands out the buffers of a frame from the storage that the
+	caller owns. Nothing is freed one by one: the whole arena is reset at
+	the next frame, or rewound to a mark after a temporary buffer. */
+
+/**
+ * Bind the arena to the caller-owned `storage` of `size` bytes.
+ */
+void dsp_arena_init(DspArena *arena, void *storage, size_t size)
+{
+	assert (arena != NULL && storage != NULL && size > 0);
+
+	arena->base = storage;
+	arena->size = size;
+	arena->used = 0;
+	arena->peak = 0;
+}
+
+/**
+ * Allocate `size` bytes aligned to the cache line. The arena must be big
+ * enough for the worst frame, so running out of it is a bug.
+ */
+void *dsp_arena_alloc(DspArena *arena, size_t size)
+{
+	uintptr_t address;
+	size_t offset;
+
+	assert_arena(arena);
+
+	address = (uintptr_t) (arena->base + arena->used);
+	offset = arena->used + ((DSP_ARENA_ALIGN - address % DSP_ARENA_ALIGN) %
+		DSP_ARENA_ALIGN);
+	assert (offset <= arena->size && size <= arena->size - offset);
+
+	arena->used = offset + size;
+	if (arena->used > arena->peak)
+	{
+		arena->peak = arena->used;
+	}
+	return arena->base + offset;
+}
+
+/**
+ * Return the current position of the arena to rewind later.
+ */
+size_t dsp_arena_mark(const DspArena *arena)
+{
+	assert_arena(arena);
+
+	return arena->used;
+}
+
+/**
+ * Release the buffers that were allocated after the `mark`.
+ */
+void dsp_arena_rewind(DspArena *arena, size_t mark)
+{
+	assert_arena(arena);
+	assert (mark <= arena->used);
+
+	arena->used = mark;
+}
+
+/**
+ * Release all buffers of the arena for the next frame.
+ */
+void dsp_arena_reset(DspArena *arena)
+{
+	assert_arena(arena);
+
+	arena->used = 0;
+}
+
+/**
+ * Allocate a time view of `capacity` samples from the arena.
+ */
+DspTimeView dsp_time_view_new(DspArena *arena, len_t capacity)
+{
+	DspTimeView view;
+
+	assert_length(capacity);
+
+	view.length = capacity;
+	view.capacity = capacity;
+	view.data = dsp_arena_alloc(arena, capacity * sizeof(double));
+
+	return view;
+}
+
+/**
+ * Allocate a frequency view of `capacity` bins from the arena.
+ */
+DspFreqView dsp_freq_view_new(DspArena *arena, len_t capacity)
+{
+	DspFreqView view;
+
+	assert_length(capacity);
+
+	view.length = capacity;
+	view.capacity = capacity;
+	view.data = dsp_arena_alloc(arena, capacity * sizeof(double [2]));
+
+	return view;
+}
+
+/**
+ * Allocate a single-precision time view of `capacity` samples.
+ */
+DspTimeViewF32 dsp_time_view_f32_new(DspArena *arena, len_t capacity)
+{
+	DspTimeViewF32 view;
+
+	assert_length(capacity);
+
+	view.length = capacity;
+	view.capacity = capacity;
+	view.data = dsp_arena_alloc(arena, capacity * sizeof(float));
+
+	return view;
+}
+
+/**
+ * Allocate a single-precision frequency view of `capacity` bins.
+ */
+DspFreqViewF32 dsp_freq_view_f32_new(DspArena *arena, len_t capacity)
+{
+	DspFreqViewF32 view;
+
+	assert_length(capacity);
+
+	view.length = capacity;
+	view.capacity = capacity;
+	view.data = dsp_arena_alloc(arena, capacity * sizeof(float [2]));
+
+	return view;
+}
+
+/**
+ * Return a time view over the storage of the fixed-size `sample`.
+ */
+DspTimeView dsp_time_view_of(DspTime *sample)
+{
+	DspTimeView view;
+
+	assert_sample(sample);
+
+	view.length = sample->length;
+	view.capacity = MAX_DATA;
+	view.data = sample->data;
+
+	return view;
+}
+
+/**
+ * Return a frequency view over the storage of the fixed-size `sample`.
+ */
+DspFreqView dsp_freq_view_of(DspFreq *sample)
+{
+	DspFreqView view;
+
+	assert (sample != NULL);
+
+	view.length = sample->length;
+	view.capacity = MAX_DATA;
+	view.data = sample->data;
+
+	return view;
+}
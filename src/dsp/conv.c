@@ -0,0 +1,384 @@
+/**
+ ******************************************************************************
+ * @file 	conv.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Fast convolution and correlation with FFT.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+#include <complex.h>
+
+/*	The convolution of the library is direct, so it costs N * M. Here the
+	two real inputs ride on one complex transform z = a + j * b, and the
+	spectrum of their convolution comes from Z alone
+
+		A(k) * B(k) = (Z(k)^2 - conj(Z(-k))^2) / 4j
+
+	so a convolution costs a forward and an inverse transform of the
+	padded length. The direct form is kept while its N * M multiply-adds
+	cost less than the transforms, which is below about 64 taps for a
+	frame of 512. The correlation is the convolution with the
+	reversed second sample. The transform lengths are powers of two, so
+	the plans don't run out with the lengths of inputs.
+
+	The long signals are filtered by blocks with overlap-save: a block
+	takes the last `taps - 1` inputs of the previous one in front, and the
+	outputs that wrapped around are thrown away. The outputs are real, so
+	two blocks share a complex transform, one in the real and one in the
+	imaginary part. */
+
+/**
+ * Return the smallest power of two that is not less than `length`.
+ */
+static len_t __conv_length(len_t length)
+{
+	len_t n = 1;
+
+	while (n < length)
+	{
+		n <<= 1;
+	}
+	return n;
+}
+
+/**
+ * Return whether the direct form is cheaper than the transforms.
+ */
+static int __conv_is_direct(len_t flength, len_t slength)
+{
+	len_t length = __conv_length(flength + slength - 1);
+	double fft = DSP_CONV_FFT_COST * length * log2((double) length);
+
+	return (double) flength * slength <= fft;
+}
+
+/**
+ * Direct convolution of `flength` and `slength` samples.
+ */
+static void __conv_direct(const double *fdata, len_t flength,
+	const double *sdata, len_t slength, double *result)
+{
+	len_t i, j;
+
+	for (i = 0; i < flength + slength - 1; i++)
+	{
+		result[i] = 0.0;
+	}
+	for (i = 0; i < flength; i++)
+	{
+		for (j = 0; j < slength; j++)
+		{
+			result[i + j] += fdata[i] * sdata[j];
+		}
+	}
+}
+
+/**
+ * Convolution of `flength` and `slength` samples with FFT. The second
+ * sample is read backwards if `reverse` is set.
+ */
+static void __conv_fft(const double *fdata, len_t flength,
+	const double *sdata, len_t slength, int reverse, double *result,
+	DspArena *arena)
+{
+	len_t k, length;
+	size_t mark;
+	const DspFFTPlan *plan;
+	double complex *packed, *spectrum, z, w;
+
+	length = __conv_length(flength + slength - 1);
+	plan = dsp_fft_plan(length);
+
+	mark = dsp_arena_mark(arena);
+	packed = dsp_arena_alloc(arena, length * sizeof(double complex));
+	spectrum = dsp_arena_alloc(arena, length * sizeof(double complex));
+
+	for (k = 0; k < length; k++)
+	{
+		packed[k] = 0.0;
+	}
+	for (k = 0; k < flength; k++)
+	{
+		packed[k] = fdata[k];
+	}
+	for (k = 0; k < slength; k++)
+	{
+		packed[k] += I * (reverse ? sdata[slength - 1 - k] : sdata[k]);
+	}
+	dsp_fft_complex(plan, (const double (*)[2]) packed,
+		(double (*)[2]) spectrum, 0);
+
+	for (k = 0; k <= length / 2; k++)
+	{
+		z = spectrum[k];
+		w = conj(spectrum[(length - k) % length]);
+		packed[k] = (z * z - w * w) / (4.0 * I);
+		if (k > 0 && k < length - k)
+		{
+			packed[length - k] = conj(packed[k]);
+		}
+	}
+	dsp_fft_complex(plan, (const double (*)[2]) packed,
+		(double (*)[2]) spectrum, 1);
+
+	for (k = 0; k < flength + slength - 1; k++)
+	{
+		result[k] = creal(spectrum[k]) / length;
+	}
+	dsp_arena_rewind(arena, mark);
+}
+
+/**
+ * Convolution of the views, in the direct form if it's cheaper.
+ */
+static void __conv_views(const DspTimeView *fsample,
+	const DspTimeView *ssample, int reverse, DspTimeView *result,
+	DspArena *arena)
+{
+	len_t k, length;
+	size_t mark;
+	double *reversed;
+
+	assert_view(fsample);
+	assert_view(ssample);
+	length = fsample->length + ssample->length - 1;
+	assert (result != NULL && result->capacity >= length);
+	assert_length(length);
+
+	if (__conv_is_direct(fsample->length, ssample->length))
+	{
+		mark = dsp_arena_mark(arena);
+		reversed = dsp_arena_alloc(arena, ssample->length * sizeof(double));
+		for (k = 0; k < ssample->length; k++)
+		{
+			reversed[k] = reverse ? ssample->data[ssample->length - 1 - k] :
+				ssample->data[k];
+		}
+		__conv_direct(fsample->data, fsample->length, reversed,
+			ssample->length, result->data);
+		dsp_arena_rewind(arena, mark);
+	}
+	else
+	{
+		__conv_fft(fsample->data, fsample->length, ssample->data,
+			ssample->length, reverse, result->data, arena);
+	}
+	result->length = length;
+}
+
+/**
+ * Convolution of two views with the output of `dsp_time_convolve()`. The
+ * scratch buffers are taken from the `arena` and released before return.
+ */
+void dsp_view_convolve(const DspTimeView *fsample,
+	const DspTimeView *ssample, DspTimeView *result, DspArena *arena)
+{
+	__conv_views(fsample, ssample, 0, result, arena);
+}
+
+/**
+ * Cross correlation of two views with the output of
+ * `dsp_time_cross_corr()`, from the lag `1 - length` to `length - 1`.
+ */
+void dsp_view_cross_corr(const DspTimeView *fsample,
+	const DspTimeView *ssample, DspTimeView *result, DspArena *arena)
+{
+	assert_view(fsample);
+	assert_view(ssample);
+	assert (fsample->length == ssample->length);
+
+	__conv_views(fsample, ssample, 1, result, arena);
+}
+
+/**
+ * Auto correlation of the view with the output of `dsp_time_auto_corr()`.
+ */
+void dsp_view_auto_corr(const DspTimeView *sample, DspTimeView *result,
+	DspArena *arena)
+{
+	__conv_views(sample, sample, 1, result, arena);
+}
+
+/**
+ * Prepare the overlap-save convolver of the `taps` coefficients. The
+ * block length is picked for the taps, the short kernels stay direct.
+ */
+void dsp_convolver_init(DspConvolver *conv, const double *coeffs, int taps)
+{
+	len_t k;
+	double complex *kernel;
+
+	assert (conv != NULL && coeffs != NULL);
+	assert (taps > 0 && taps <= MAX_DATA / 4);
+
+	memset(conv, 0, sizeof(DspConvolver));
+	conv->taps = taps;
+	conv->coeffs = malloc(taps * sizeof(double));
+	conv->history = calloc(taps, sizeof(double));
+	assert (conv->coeffs != NULL && conv->history != NULL);
+	memcpy(conv->coeffs, coeffs, taps * sizeof(double));
+	if (taps <= DSP_CONV_DIRECT_TAPS)
+	{
+		return;
+	}
+
+	/* About a quarter of the block is thrown away as the overlap. */
+	conv->block = __conv_length(4 * (len_t) taps);
+	conv->step = conv->block - (len_t) taps + 1;
+	conv->plan = dsp_fft_plan(conv->block);
+	conv->kernel = malloc(conv->block * sizeof(double [2]));
+	conv->buffer = malloc(2 * conv->block * sizeof(double [2]));
+	assert (conv->kernel != NULL && conv->buffer != NULL);
+
+	kernel = (double complex *) conv->buffer;
+	for (k = 0; k < conv->block; k++)
+	{
+		kernel[k] = (k < (len_t) taps) ? coeffs[k] : 0.0;
+	}
+	dsp_fft_complex(conv->plan, (const double (*)[2]) conv->buffer,
+		conv->kernel, 0);
+}
+
+/**
+ * Forget the inputs of the previous blocks.
+ */
+void dsp_convolver_reset(DspConvolver *conv)
+{
+	assert (conv != NULL && conv->history != NULL);
+
+	memset(conv->history, 0, conv->taps * sizeof(double));
+}
+
+/**
+ * Return the input at `index` from the start of call, the negative ones
+ * are taken from the history.
+ */
+static double __convolver_input(const DspConvolver *conv,
+	const DspTimeView *input, long index)
+{
+	return (index >= 0) ? input->data[index] :
+		conv->history[conv->taps - 1 + index];
+}
+
+/**
+ * Keep the last `taps - 1` inputs before the next call.
+ */
+static void __convolver_remember(DspConvolver *conv, const DspTimeView *input)
+{
+	int j, keep = conv->taps - 1;
+
+	for (j = 0; j < keep; j++)
+	{
+		conv->history[j] = __convolver_input(conv, input,
+			(long) input->length - keep + j);
+	}
+}
+
+/**
+ * Filter the `input` with the convolver into the `output` of the same
+ * length, y(n) = sum_k h(k) * x(n - k). The inputs of the previous calls
+ * are carried over, so the frames can be filtered one after another.
+ * The `input` and `output` must not overlap.
+ */
+void dsp_convolver_process(DspConvolver *conv, const DspTimeView *input,
+	DspTimeView *output)
+{
+	int j, part, keep;
+	len_t k, n, start, count[2];
+	double sum;
+	double complex *packed, *spectrum;
+	const double complex *kernel;
+
+	assert (conv != NULL && conv->history != NULL);
+	assert_view(input);
+	assert (output != NULL && output->capacity >= input->length);
+	assert (input->data != output->data);
+
+	keep = conv->taps - 1;
+	if (conv->block == 0)
+	{
+		for (n = 0; n < input->length; n++)
+		{
+			sum = 0.0;
+			for (j = 0; j < conv->taps; j++)
+			{
+				sum += conv->coeffs[j] *
+					__convolver_input(conv, input, (long) n - j);
+			}
+			output->data[n] = sum;
+		}
+	}
+	else
+	{
+		packed = (double complex *) conv->buffer;
+		spectrum = packed + conv->block;
+		kernel = (const double complex *) conv->kernel;
+		for (start = 0; start < input->length; start += count[0] + count[1])
+		{
+			/* Two blocks of `step` new samples, the second may be empty. */
+			count[0] = input->length - start;
+			count[0] = (count[0] > conv->step) ? conv->step : count[0];
+			count[1] = input->length - start - count[0];
+			count[1] = (count[1] > conv->step) ? conv->step : count[1];
+
+			for (k = 0; k < conv->block; k++)
+			{
+				packed[k] = 0.0;
+				for (part = 0; part < 2; part++)
+				{
+					n = part * count[0] + k;		/* from `start` plus `keep` */
+					if (k < (len_t) keep || k - keep < count[part])
+					{
+						packed[k] += (part ? I : 1.0) * __convolver_input(conv,
+							input, (long) (start + n) - keep);
+					}
+				}
+			}
+
+			dsp_fft_complex(conv->plan, (const double (*)[2]) packed,
+				(double (*)[2]) spectrum, 0);
+			for (k = 0; k < conv->block; k++)
+			{
+				spectrum[k] *= kernel[k] / conv->block;
+			}
+			dsp_fft_complex(conv->plan, (const double (*)[2]) spectrum,
+				(double (*)[2]) packed, 1);
+
+			/* The first `keep` outputs wrapped around the block. */
+			for (k = 0; k < count[0]; k++)
+			{
+				output->data[start + k] = creal(packed[keep + k]);
+			}
+			for (k = 0; k < count[1]; k++)
+			{
+				output->data[start + count[0] + k] = cimag(packed[keep + k]);
+			}
+		}
+	}
+	__convolver_remember(conv, input);
+	output->length = input->length;
+}
+
+/**
+ * Release the buffers of the convolver.
+ */
+void dsp_convolver_free(DspConvolver *conv)
+{
+	assert (conv != NULL);
+
+	free(conv->coeffs);
+	free(conv->history);
+	free(conv->kernel);
+	free(conv->buffer);
+	memset(conv, 0, sizeof(DspConvolver));
+}
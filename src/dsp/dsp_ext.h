@@ -0,0 +1,419 @@
+/**
+ ******************************************************************************
+ * @file 	dsp_ext.h
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Ground station extensions of the DSP library.
+ * 
+ ******************************************************************************
+ * @attention
+ * 
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ * 
+ * This software is licensed under the MIT License.
+ * 
+ ******************************************************************************
+ */
+
+#ifndef DSP_EXT_H
+#define DSP_EXT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Custom DSP Library */
+
+#include "../../lib/include/dsp.h"
+
+/* Standard C Libraries */
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+/* User-defined Constants */
+
+#define DSP_FFT_MAX_FACTORS	32
+#define DSP_FFT_MAX_PLANS		32
+#define DSP_ARENA_ALIGN			64			/* cache line */
+#define DSP_MOMENTS_LANES		4			/* independent accumulators */
+#define DSP_JACOBI_SWEEPS		64			/* of the eigendecomposition */
+#define DSP_LINALG_EPSILON		1e-12		/* norm of a dependent column */
+#define DSP_MUSIC_MIN_BETA		1e-3		/* PAST forgetting of no memory */
+#define DSP_STEERING_MAX_TABLES	256		/* (mics, radius, freq) keys */
+#define DSP_STEERING_STEP		4			/* degrees of coarse grid */
+#define DSP_STEERING_ANGLES		(360 / DSP_STEERING_STEP)
+#define DSP_STEERING_PEAKS		2			/* coarse peaks to be refined */
+#define DSP_STEERING_TOLERANCE	0.01		/* degrees of refined angle */
+#define DSP_ESPRIT_CYCLES		4			/* periods per DFT snapshot */
+#define DSP_ESPRIT_MIN_BLOCK		32			/* samples per DFT snapshot */
+#define DSP_ESPRIT_ROOT_ITERATIONS	500
+#define DSP_POOL_MAX_WORKERS		32
+#define DSP_TDOA_MAX_PAIRS		(MAX_MICS * (MAX_MICS - 1) / 2)
+#define DSP_CONV_DIRECT_TAPS		48			/* shorter streamed kernels stay direct */
+#define DSP_CONV_FFT_COST		4			/* multiply-adds per L * log2(L) */
+#define DSP_SOS_MAX_SECTIONS		8			/* biquads of a cascade */
+#define DSP_WINDOW_MAX_TABLES	64			/* (type, length, factor) keys */
+
+/* User-defined Enumerations */
+
+typedef enum _DspSimdLevel
+{
+	DSP_SIMD_SCALAR,						/* portable reference */
+	DSP_SIMD_SSE2,							/* 2 doubles per register */
+	DSP_SIMD_AVX2,							/* 4 doubles per register */
+	DSP_SIMD_AVX512						/* 8 doubles per register */
+} DspSimdLevel;
+
+typedef enum _DspWindow
+{
+	DSP_WINDOW_HAMMING,
+	DSP_WINDOW_HANNING,
+	DSP_WINDOW_BLACKMAN,
+	DSP_WINDOW_CHEBYSHEV,				/* side lobes `factor` dB down */
+	DSP_WINDOW_KAISER					/* stop band `factor` dB down */
+} DspWindow;
+
+/* User-defined Structures */
+
+typedef struct _DspFFTPlan
+{
+	len_t length;							/* transform length */
+	int stages;								/* number of radix stages */
+	int factors[DSP_FFT_MAX_FACTORS];	/* radix of each stage */
+	int maxRadix;							/* biggest radix in stages */
+	len_t *permute;						/* input index of each output */
+	double (*twiddles)[2];				/* exp(-j*2*pi*k/length) */
+	float (*twiddlesF32)[2];			/* single-precision twiddles */
+} DspFFTPlan;
+
+typedef struct _DspWindowTable
+{
+	DspWindow type;
+	len_t length;							/* samples of the window */
+	int factor;								/* dB of Chebyshev and Kaiser */
+	double *coeffs;
+	float *coeffsF32;						/* single-precision coefficients */
+} DspWindowTable;
+
+typedef struct _DspArena
+{
+	unsigned char *base;					/* caller-owned storage */
+	size_t size;							/* bytes of storage */
+	size_t used;							/* bytes handed out */
+	size_t peak;							/* most bytes ever used */
+} DspArena;
+
+typedef struct _DspTimeView
+{
+	len_t length;							/* samples in use */
+	len_t capacity;						/* samples of storage */
+	double *data;							/* storage of the owner */
+} DspTimeView;
+
+typedef struct _DspFreqView
+{
+	len_t length;							/* bins in use */
+	len_t capacity;						/* bins of storage */
+	double (*data)[2];					/* storage of the owner */
+} DspFreqView;
+
+typedef struct _DspTimeViewF32
+{
+	len_t length;							/* samples in use */
+	len_t capacity;						/* samples of storage */
+	float *data;							/* storage of the owner */
+} DspTimeViewF32;
+
+typedef struct _DspFreqViewF32
+{
+	len_t length;							/* bins in use */
+	len_t capacity;						/* bins of storage */
+	float (*data)[2];						/* storage of the owner */
+} DspFreqViewF32;
+
+typedef struct _DspMoments
+{
+	len_t count;							/* number of samples */
+	double max;
+	double min;
+	double absMax;
+	double mean;
+	double stddev;							/* of population */
+	double energy;
+	double rms;
+	double power;
+	double crestFactor;
+	double skewness;
+	double kurtosis;						/* excess kurtosis */
+	double variance;						/* of population */
+} DspMoments;
+
+typedef struct _DspSteering
+{
+	int mics;								/* geometry of the array */
+	double radius;
+	double freq;							/* frequency of the vectors */
+	double (*vectors)[2];				/* mics per coarse angle */
+} DspSteering;
+
+typedef struct _DspDirection
+{
+	double azimuth;						/* degrees in [0, 360) */
+	double elevation;						/* degrees above the array */
+} DspDirection;
+
+typedef struct _DspTdoa
+{
+	int mics;								/* of the circular array */
+	int pairs;
+	int first[DSP_TDOA_MAX_PAIRS];		/* mics of each pair */
+	int second[DSP_TDOA_MAX_PAIRS];
+	double delay[DSP_TDOA_MAX_PAIRS];	/* seconds second lags first */
+	double weight[DSP_TDOA_MAX_PAIRS];	/* GCC-PHAT peak in [0, 1] */
+} DspTdoa;
+
+typedef struct _DspConvolver
+{
+	int taps;								/* length of the kernel */
+	double *coeffs;
+	double *history;						/* last `taps - 1` inputs */
+	len_t block;							/* transform length, 0 if direct */
+	len_t step;								/* new samples per block */
+	const DspFFTPlan *plan;
+	double (*kernel)[2];					/* spectrum of the taps */
+	double (*buffer)[2];					/* two blocks of scratch */
+} DspConvolver;
+
+typedef struct _DspFir
+{
+	int channels;
+	DspConvolver convolvers[MAX_MICS];	/* a history per channel */
+} DspFir;
+
+typedef struct _DspBiquad
+{
+	double b0, b1, b2;					/* normalized by a0 */
+	double a1, a2;
+} DspBiquad;
+
+typedef struct _DspSos
+{
+	int sections;
+	int channels;
+	DspBiquad biquads[DSP_SOS_MAX_SECTIONS];
+	double state[DSP_SOS_MAX_SECTIONS][MAX_MICS][2];	/* s1, s2 of channels */
+} DspSos;
+
+typedef void (*DspPoolTask)(void *arg, int index);
+
+typedef struct _DspPool
+{
+	int workers;							/* threads besides the caller */
+	pthread_t threads[DSP_POOL_MAX_WORKERS];
+	pthread_mutex_t mutex;
+	pthread_cond_t start;					/* a new loop is posted */
+	pthread_cond_t done;					/* the workers are idle */
+	unsigned long generation;			/* number of posted loops */
+	int active;								/* workers in current loop */
+	int stop;
+	DspPoolTask task;						/* body of current loop */
+	void *arg;
+	int count;								/* indexes of current loop */
+	atomic_int next;						/* next index to be taken */
+} DspPool;
+
+typedef struct _DspMusicTracker
+{
+	double forget;							/* weight of the past frames */
+	int refresh;							/* frames between decompositions */
+	int frames;								/* frames since decomposition */
+	int decompositions;					/* full decompositions so far */
+	int mics;								/* geometry of the tracked array */
+	int sources;
+	double bearing;						/* refined arrival in degrees */
+	double covariance[MAX_MICS][MAX_MICS];
+	double subspace[MAX_MICS][MAX_MICS];		/* signal subspace in columns */
+	double inverse[MAX_SOURCES][MAX_SOURCES];	/* inverse correlation of PAST */
+} DspMusicTracker;
+
+typedef struct _DspMvdr
+{
+	int mics;
+	double loading;						/* of the mean power on diagonal */
+	double factor[MAX_MICS][MAX_MICS];	/* Cholesky of loaded covariance */
+} DspMvdr;
+
+/**
+ * Validate the `plan` object. It's passed by reference to functions.
+ */
+#define assert_plan(plan)															\
+{																							\
+	assert (plan != NULL);															\
+	assert_length(plan->length);													\
+	assert (plan->permute != NULL && plan->twiddles != NULL);			\
+	assert (plan->twiddlesF32 != NULL);											\
+}
+
+/**
+ * Validate the `arena` object. It's passed by reference to functions.
+ */
+#define assert_arena(arena)														\
+{																							\
+	assert (arena != NULL && arena->base != NULL);							\
+	assert (arena->used <= arena->size);										\
+}
+
+/**
+ * Validate the `view` object. It's passed by reference to functions.
+ */
+#define assert_view(view)															\
+{																							\
+	assert (view != NULL && view->data != NULL);								\
+	assert_length(view->length);													\
+	assert (view->length <= view->capacity);									\
+}
+
+/* Arena and View Methods */
+
+extern void dsp_arena_init(DspArena *arena, void *storage, size_t size);
+extern void *dsp_arena_alloc(DspArena *arena, size_t size);
+extern size_t dsp_arena_mark(const DspArena *arena);
+extern void dsp_arena_rewind(DspArena *arena, size_t mark);
+extern void dsp_arena_reset(DspArena *arena);
+extern DspTimeView dsp_time_view_new(DspArena *arena, len_t capacity);
+extern DspFreqView dsp_freq_view_new(DspArena *arena, len_t capacity);
+extern DspTimeView dsp_time_view_of(DspTime *sample);
+extern DspFreqView dsp_freq_view_of(DspFreq *sample);
+extern DspTimeViewF32 dsp_time_view_f32_new(DspArena *arena, len_t capacity);
+extern DspFreqViewF32 dsp_freq_view_f32_new(DspArena *arena, len_t capacity);
+
+/* Fast Fourier Transformation Methods */
+
+extern const DspFFTPlan *dsp_fft_plan(len_t length);
+extern void dsp_fft_complex(const DspFFTPlan *plan, const double (*input)[2], double (*output)[2], int inverse);
+extern void dsp_transform_fft(const DspTime *sample, DspFreq *result);
+extern void dsp_transform_ifft(const DspFreq *sample, DspTime *result);
+extern void dsp_transform_rfft(const DspTime *sample, DspFreq *result);
+extern void dsp_transform_rfft_pair(const DspTime *fsample, const DspTime *ssample, DspFreq *fresult, DspFreq *sresult);
+extern void dsp_transform_rfft_batch(const DspTime *samples, int count, DspFreq *results);
+extern void dsp_view_rfft(const DspTimeView *sample, DspFreqView *result, DspArena *arena);
+extern void dsp_view_rfft_pair(const DspTimeView *fsample, const DspTimeView *ssample, DspFreqView *fresult, DspFreqView *sresult, DspArena *arena);
+extern void dsp_view_rfft_batch(const DspTimeView *samples, int count, DspFreqView *results, DspArena *arena);
+extern void dsp_fft_complex_f32(const DspFFTPlan *plan, const float (*input)[2], float (*output)[2], int inverse);
+extern void dsp_view_rfft_f32(const DspTimeViewF32 *sample, DspFreqViewF32 *result, DspArena *arena);
+extern void dsp_view_rfft_pair_f32(const DspTimeViewF32 *fsample, const DspTimeViewF32 *ssample, DspFreqViewF32 *fresult, DspFreqViewF32 *sresult, DspArena *arena);
+extern void dsp_view_rfft_batch_f32(const DspTimeViewF32 *samples, int count, DspFreqViewF32 *results, DspArena *arena);
+
+/* Windowing Methods */
+
+extern const DspWindowTable *dsp_window_table(DspWindow type, len_t length, int factor);
+extern void dsp_window_apply(DspWindow type, int factor, DspTimeView *sample);
+extern void dsp_window_apply_f32(DspWindow type, int factor, DspTimeViewF32 *sample);
+
+/* Convolution Methods */
+
+extern void dsp_view_convolve(const DspTimeView *fsample, const DspTimeView *ssample, DspTimeView *result, DspArena *arena);
+extern void dsp_view_cross_corr(const DspTimeView *fsample, const DspTimeView *ssample, DspTimeView *result, DspArena *arena);
+extern void dsp_view_auto_corr(const DspTimeView *sample, DspTimeView *result, DspArena *arena);
+extern void dsp_convolver_init(DspConvolver *conv, const double *coeffs, int taps);
+extern void dsp_convolver_reset(DspConvolver *conv);
+extern void dsp_convolver_process(DspConvolver *conv, const DspTimeView *input, DspTimeView *output);
+extern void dsp_convolver_free(DspConvolver *conv);
+
+/* Streaming Filter Methods */
+
+extern void dsp_fir_design(DspFilter filter, double fc1, double fc2, double fs, int taps, double *coeffs);
+extern void dsp_fir_init(DspFir *fir, DspFilter filter, double fc1, double fc2, double fs, int taps, int channels);
+extern void dsp_fir_reset(DspFir *fir);
+extern void dsp_fir_process(DspFir *fir, const DspTimeView *inputs, DspTimeView *outputs);
+extern void dsp_fir_free(DspFir *fir);
+extern void dsp_biquad_design(DspBiquad *biquad, DspFilter filter, double fc, double fs, double q);
+extern void dsp_sos_init(DspSos *sos, int channels);
+extern void dsp_sos_append(DspSos *sos, const DspBiquad *biquad);
+extern void dsp_sos_butterworth(DspSos *sos, DspFilter filter, int order, double fc, double fs);
+extern void dsp_sos_reset(DspSos *sos);
+extern void dsp_sos_process(DspSos *sos, const DspTimeView *inputs, DspTimeView *outputs);
+
+/* Statistics Methods */
+
+extern void dsp_time_moments(const DspTime *sample, DspMoments *result);
+extern void dsp_view_moments(const DspTimeView *sample, DspMoments *result);
+
+/* Elementwise Methods with SIMD Kernels */
+
+extern DspSimdLevel dsp_simd_detect(void);
+extern DspSimdLevel dsp_simd_level(void);
+extern DspSimdLevel dsp_simd_select(DspSimdLevel level);
+extern const char *dsp_simd_name(DspSimdLevel level);
+extern void dsp_view_add(const DspTimeView *fsample, const DspTimeView *ssample, DspTimeView *result);
+extern void dsp_view_dot_mul(const DspTimeView *fsample, const DspTimeView *ssample, DspTimeView *result);
+extern void dsp_view_scalar_mul(const DspTimeView *sample, double scalar, DspTimeView *result);
+extern void dsp_view_scale(const DspTimeView *sample, double scale, DspTimeView *result);
+extern void dsp_view_abs(const DspTimeView *sample, DspTimeView *result);
+extern void dsp_view_clip(const DspTimeView *sample, double min, double max, DspTimeView *result);
+extern void dsp_view_window(const DspTimeView *sample, const double *window, DspTimeView *result);
+extern void dsp_view_magnitude(const DspFreqView *sample, DspTimeView *result);
+
+/* Linear Algebra Methods */
+
+extern void dsp_linalg_eigen_symm(int n, const double matrix[][MAX_MICS], double *values, double vectors[][MAX_MICS]);
+extern int dsp_linalg_orthonormalize(int n, int cols, double matrix[][MAX_MICS]);
+extern int dsp_linalg_cholesky(int n, double matrix[][MAX_MICS]);
+extern void dsp_linalg_cholesky_solve(int n, const double factor[][MAX_MICS], double *vector);
+
+/* Arrival Tracking Methods */
+
+extern void dsp_covariance(const DspArrival *arrival, double covariance[][MAX_MICS]);
+extern void dsp_music_tracker_init(DspMusicTracker *tracker, double forget, int refresh);
+extern void dsp_music_tracker_reset(DspMusicTracker *tracker);
+extern int dsp_arrival_music_track(DspMusicTracker *tracker, const DspArrival *arrival);
+extern const DspSteering *dsp_steering_table(int mics, double radius, double freq);
+extern double dsp_steering_search(const DspArrival *arrival, const double projector[][MAX_MICS]);
+extern int dsp_arrival_esprit(const DspArrival *arrival, double fs, DspDirection *result);
+extern double dsp_arrival_srp_phat(const DspArrival *arrival, double fs, double low, double high, DspPool *pool, DspArena *arena);
+extern int dsp_tdoa_gcc_phat(const DspArrival *arrival, double fs, DspTdoa *result, DspArena *arena);
+extern int dsp_arrival_tdoa(const DspTdoa *tdoa, double radius, DspDirection *result);
+extern int dsp_beam_scan(const DspArrival *arrival, double fs, double low, double high, int angles, double *power, DspArena *arena);
+
+/* Beamforming Methods */
+
+extern int dsp_mvdr_init(DspMvdr *mvdr, int mics, const double covariance[][MAX_MICS], double loading);
+extern void dsp_mvdr_weights(const DspMvdr *mvdr, double radius, double freq, double theta, double (*weights)[2]);
+extern void dsp_beamform_capon(const DspBeamform *beamform, const DspMvdr *mvdr, double fs, DspTime *result, DspArena *arena);
+
+/* Thread Pool Methods */
+
+extern void dsp_pool_init(DspPool *pool, int workers);
+extern void dsp_pool_run(DspPool *pool, DspPoolTask task, void *arg, int count);
+extern int dsp_pool_size(const DspPool *pool);
+extern void dsp_pool_free(DspPool *pool);
+
+/* Single-precision Methods */
+
+extern void dsp_time_f32_from_int8(const int8_t *data, len_t length, DspTimeViewF32 *result);
+extern void dsp_time_f32_from_double(const DspTime *sample, DspTimeViewF32 *result);
+extern void dsp_time_f32_to_double(const DspTimeViewF32 *sample, DspTime *result);
+extern float dsp_time_f32_max(const DspTimeViewF32 *sample);
+extern float dsp_time_f32_min(const DspTimeViewF32 *sample);
+extern float dsp_time_f32_abs_max(const DspTimeViewF32 *sample);
+extern int dsp_time_f32_argmax(const DspTimeViewF32 *sample);
+extern float dsp_time_f32_mean(const DspTimeViewF32 *sample);
+extern float dsp_time_f32_energy(const DspTimeViewF32 *sample);
+extern float dsp_time_f32_power(const DspTimeViewF32 *sample);
+extern float dsp_time_f32_rms(const DspTimeViewF32 *sample);
+extern float dsp_time_f32_stddev(const DspTimeViewF32 *sample);
+extern float dsp_time_f32_variance(const DspTimeViewF32 *sample);
+extern void dsp_time_f32_scale(const DspTimeViewF32 *sample, float scale, DspTimeViewF32 *result);
+extern void dsp_freq_f32_magnitude(const DspFreqViewF32 *sample, DspTimeViewF32 *result);
+extern void dsp_window_f32_hamming(const DspTimeViewF32 *sample, DspTimeViewF32 *result);
+extern void dsp_window_f32_hanning(const DspTimeViewF32 *sample, DspTimeViewF32 *result);
+extern void dsp_window_f32_blackman(const DspTimeViewF32 *sample, DspTimeViewF32 *result);
+extern void dsp_filter_f32_fir_low_pass(const DspTimeViewF32 *sample, float fc, float fs, int taps, DspTimeViewF32 *result, DspArena *arena);
+extern void dsp_filter_f32_fir_high_pass(const DspTimeViewF32 *sample, float fc, float fs, int taps, DspTimeViewF32 *result, DspArena *arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSP_EXT_H */
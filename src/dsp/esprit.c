@@ -0,0 +1,380 @@
+/**
+ ******************************************************************************
+ * @file 	esprit.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Closed-form arrival of angle for the uniform circular array.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+#include <complex.h>
+
+/*	UCA-ESPRIT of Mathews and Zoltowski. A plane wave from azimuth phi and
+	polar angle theta reaches the mic n at angle gamma_n of the circle with
+	the phase of zeta * cos(phi - gamma_n), where zeta = k * r * sin(theta).
+	The phase modes of the circle
+
+		b_m = j^-m / N * sum_n exp(j * m * gamma_n) * x_n,	|m| <= M'
+
+	turn it into J_m(zeta) * exp(j * m * phi), and the recurrence of Bessel
+	functions J_m-1 + J_m+1 = 2m / zeta * J_m gives the shift invariance
+
+		mu * b_m-1 + conj(mu) * b_m+1 = 2m / (k * r) * b_m
+
+	with mu = sin(theta) * exp(j * phi). The beamspace covariance is made
+	real by a unitary transform, so the signal subspace comes from a real
+	eigendecomposition of (2M' + 1) x (2M' + 1). Then mu of each source is
+	an eigenvalue of a small least squares solution, there is no angular
+	grid at all. The samples are real, so the complex snapshots are taken
+	with a short-time DFT at the frequency of arrival. */
+
+/**
+ * Return the number of phase modes M' of the array at `freq`.
+ */
+static int __esprit_modes(const DspArrival *arrival, double kr)
+{
+	int modes;
+
+	/* The modes up to about k * r carry the power, but the aliasing of
+		mode m with m - N needs N > 2M'. A mode short of k * r only bends
+		the elevation, more than that bends the azimuth too. */
+	modes = (int) ceil(kr);
+	if (modes > (arrival->mics - 1) / 2 + 1)
+	{
+		return 0;
+	}
+	if (modes > (arrival->mics - 1) / 2)
+	{
+		modes = (arrival->mics - 1) / 2;
+	}
+	if (modes < arrival->sources + 1)
+	{
+		modes = arrival->sources + 1;
+	}
+	return (2 * modes + 1 <= arrival->mics) ? modes : 0;
+}
+
+/**
+ * Accumulate the beamspace covariance of the phase modes from the short-time
+ * DFT snapshots of mics at `freq`.
+ */
+static void __esprit_covariance(const DspArrival *arrival, double fs,
+	int modes, double complex covariance[][MAX_MICS])
+{
+	int i, n, m, count = 2 * modes + 1;
+	len_t t, start, block, length;
+	double window, omega;
+	double complex snapshot[MAX_MICS], beam[MAX_MICS], kernel, rotation;
+	double complex hann, hannRotation, modeRotation[MAX_MICS], phaseMode;
+
+	length = arrival->samples[0]->length;
+	omega = 2.0 * M_PI * arrival->freq / fs;
+
+	/* The block spans a few cycles, so the image at -freq falls into the
+		sidelobes of Hann window. The blocks overlap by half. */
+	block = (len_t) ceil(DSP_ESPRIT_CYCLES * fs / arrival->freq);
+	block = (block < DSP_ESPRIT_MIN_BLOCK) ? DSP_ESPRIT_MIN_BLOCK : block;
+	block = (block > length) ? length : block;
+
+	rotation = cexp(-I * omega);
+	hannRotation = (block > 1) ? cexp(I * 2.0 * M_PI / (block - 1)) : 1.0;
+	for (n = 0; n < arrival->mics; n++)
+	{
+		modeRotation[n] = cexp(I * 2.0 * M_PI * n / arrival->mics);
+	}
+
+	memset(covariance, 0, MAX_MICS * sizeof(covariance[0]));
+	for (start = 0; start + block <= length; start += (block + 1) / 2)
+	{
+		for (n = 0; n < arrival->mics; n++)
+		{
+			snapshot[n] = 0.0;
+		}
+		/* The kernel and the Hann window are rotated sample by sample. */
+		kernel = cexp(-I * omega * start);
+		hann = 1.0;
+		for (t = 0; t < block; t++)
+		{
+			window = (block > 1) ? 0.5 - 0.5 * creal(hann) : 1.0;
+			for (n = 0; n < arrival->mics; n++)
+			{
+				snapshot[n] += window * kernel *
+					arrival->samples[n]->data[start + t];
+			}
+			kernel *= rotation;
+			hann *= hannRotation;
+		}
+		for (i = 0; i < count; i++)
+		{
+			m = i - modes;
+			beam[i] = 0.0;
+			for (n = 0; n < arrival->mics; n++)
+			{
+				phaseMode = modeRotation[(m * n % arrival->mics +
+					arrival->mics) % arrival->mics];
+				beam[i] += phaseMode * snapshot[n];
+			}
+
+			/* j^-m cycles through 1, -j, -1, j. */
+			switch ((m % 4 + 4) % 4)
+			{
+				case 1: beam[i] *= -I; break;
+				case 2: beam[i] *= -1.0; break;
+				case 3: beam[i] *= I; break;
+				default: break;
+			}
+			beam[i] /= arrival->mics;
+		}
+		for (i = 0; i < count; i++)
+		{
+			for (n = 0; n < count; n++)
+			{
+				covariance[i][n] += beam[i] * conj(beam[n]);
+			}
+		}
+	}
+}
+
+/**
+ * Fill the unitary transform that makes the centro-Hermitian beamspace
+ * real. The mode m is in row m + M'.
+ */
+static void __esprit_transform(int modes, double complex transform[][MAX_MICS])
+{
+	int m, sign;
+
+	memset(transform, 0, MAX_MICS * sizeof(transform[0]));
+	transform[modes][0] = 1.0;
+	for (m = 1; m <= modes; m++)
+	{
+		sign = (m % 2) ? -1 : 1;
+		transform[modes + m][2 * m - 1] = M_SQRT1_2;
+		transform[modes - m][2 * m - 1] = sign * M_SQRT1_2;
+		transform[modes + m][2 * m] = I * M_SQRT1_2;
+		transform[modes - m][2 * m] = -I * sign * M_SQRT1_2;
+	}
+}
+
+/**
+ * Calculate the eigenvalues of the complex `n` x `n` matrix from the roots
+ * of its characteristic polynomial, n is the number of sources.
+ */
+static void __complex_eigenvalues(int n, double complex matrix[][MAX_SOURCES],
+	double complex *values)
+{
+	int i, j, k, iter;
+	double complex coeffs[MAX_SOURCES + 1], power[MAX_SOURCES][MAX_SOURCES];
+	double complex product[MAX_SOURCES][MAX_SOURCES], trace, value, denom;
+	double change;
+
+	if (n == 1)
+	{
+		values[0] = matrix[0][0];
+		return;
+	}
+
+	/* Faddeev-LeVerrier, z^n + c_n-1 * z^n-1 + ... + c_0. */
+	memset(power, 0, sizeof(power));
+	coeffs[n] = 1.0;
+	for (k = 1; k <= n; k++)
+	{
+		for (i = 0; i < n; i++)
+		{
+			power[i][i] += coeffs[n - k + 1];
+		}
+		trace = 0.0;
+		for (i = 0; i < n; i++)
+		{
+			for (j = 0; j < n; j++)
+			{
+				product[i][j] = 0.0;
+				for (iter = 0; iter < n; iter++)
+				{
+					product[i][j] += matrix[i][iter] * power[iter][j];
+				}
+			}
+			trace += product[i][i];
+		}
+		memcpy(power, product, sizeof(power));
+		coeffs[n - k] = -trace / k;
+	}
+
+	/* Durand-Kerner iteration of all roots at once. */
+	for (i = 0; i < n; i++)
+	{
+		values[i] = cpow(0.4 + 0.9 * I, i);
+	}
+	for (iter = 0; iter < DSP_ESPRIT_ROOT_ITERATIONS; iter++)
+	{
+		change = 0.0;
+		for (i = 0; i < n; i++)
+		{
+			value = coeffs[n];
+			for (k = n - 1; k >= 0; k--)
+			{
+				value = value * values[i] + coeffs[k];
+			}
+			denom = 1.0;
+			for (j = 0; j < n; j++)
+			{
+				denom *= (j != i) ? values[i] - values[j] : 1.0;
+			}
+			value /= denom;
+			values[i] -= value;
+			change = fmax(change, cabs(value));
+		}
+		if (change < DSP_LINALG_EPSILON)
+		{
+			break;
+		}
+	}
+}
+
+/**
+ * Calculate the directions of sources from coming signals with UCA-ESPRIT.
+ * The mics must be evenly spaced on the circle, in the order of the
+ * library. The `fs` is the sample frequency of the mics. Return the number
+ * of directions, 0 if the array can't resolve the sources at the `freq`.
+ */
+int dsp_arrival_esprit(const DspArrival *arrival, double fs,
+	DspDirection *result)
+{
+	int i, j, k, r, d, modes, count, rows;
+	double kr, gamma;
+	double real[MAX_MICS][MAX_MICS], values[MAX_MICS];
+	double vectors[MAX_MICS][MAX_MICS], normal[MAX_MICS][MAX_MICS];
+	double system[2 * MAX_MICS][2 * MAX_SOURCES], rhs[2 * MAX_MICS];
+	double solution[2 * MAX_SOURCES];
+	double complex covariance[MAX_MICS][MAX_MICS];
+	double complex transform[MAX_MICS][MAX_MICS];
+	double complex subspace[MAX_MICS][MAX_SOURCES];
+	double complex psi[MAX_SOURCES][MAX_SOURCES], mu[MAX_SOURCES];
+	double complex sum, prev, next;
+
+	assert_arrival(arrival);
+	assert (arrival->radius > 0.0 && fs > 0.0 && result != NULL);
+	for (i = 1; i < arrival->mics; i++)
+	{
+		assert (arrival->samples[i]->length == arrival->samples[0]->length);
+	}
+
+	if (arrival->freq <= 0.0 || 2.0 * arrival->freq >= fs)
+	{
+		return 0;
+	}
+	d = arrival->sources;
+	kr = 2.0 * M_PI * arrival->freq / SOUND_SPEED * arrival->radius;
+	modes = __esprit_modes(arrival, kr);
+	if (modes == 0)
+	{
+		return 0;
+	}
+	count = 2 * modes + 1;
+
+	/* Real beamspace covariance Re(T^H * R * T), its biggest eigenvectors
+		span the real signal subspace. */
+	__esprit_covariance(arrival, fs, modes, covariance);
+	__esprit_transform(modes, transform);
+	for (i = 0; i < count; i++)
+	{
+		for (j = 0; j < count; j++)
+		{
+			sum = 0.0;
+			for (r = 0; r < count; r++)
+			{
+				for (k = 0; k < count; k++)
+				{
+					sum += conj(transform[r][i]) * covariance[r][k] *
+						transform[k][j];
+				}
+			}
+			real[i][j] = creal(sum);
+		}
+	}
+	dsp_linalg_eigen_symm(count, (const double (*)[MAX_MICS]) real, values,
+		vectors);
+	for (r = 0; r < count; r++)
+	{
+		for (k = 0; k < d; k++)
+		{
+			subspace[r][k] = 0.0;
+			for (j = 0; j < count; j++)
+			{
+				subspace[r][k] += transform[r][j] * vectors[j][count - 1 - k];
+			}
+		}
+	}
+
+	/* S_-1 * Psi + S_+1 * conj(Psi) = Gamma * S_0 over the modes
+		|m| < M', split into the real and imaginary parts of Psi = P + jQ. */
+	rows = 2 * (count - 2);
+	for (r = 1; r < count - 1; r++)
+	{
+		for (k = 0; k < d; k++)
+		{
+			prev = subspace[r - 1][k];
+			next = subspace[r + 1][k];
+			system[r - 1][k] = creal(prev) + creal(next);
+			system[r - 1][d + k] = cimag(next) - cimag(prev);
+			system[count - 3 + r][k] = cimag(prev) + cimag(next);
+			system[count - 3 + r][d + k] = creal(prev) - creal(next);
+		}
+	}
+	for (i = 0; i < 2 * d; i++)
+	{
+		for (j = 0; j < 2 * d; j++)
+		{
+			normal[i][j] = 0.0;
+			for (r = 0; r < rows; r++)
+			{
+				normal[i][j] += system[r][i] * system[r][j];
+			}
+		}
+	}
+	if (!dsp_linalg_cholesky(2 * d, normal))
+	{
+		return 0;
+	}
+	for (k = 0; k < d; k++)
+	{
+		for (r = 1; r < count - 1; r++)
+		{
+			gamma = 2.0 * (r - modes) / kr;
+			rhs[r - 1] = gamma * creal(subspace[r][k]);
+			rhs[count - 3 + r] = gamma * cimag(subspace[r][k]);
+		}
+		for (i = 0; i < 2 * d; i++)
+		{
+			solution[i] = 0.0;
+			for (r = 0; r < rows; r++)
+			{
+				solution[i] += system[r][i] * rhs[r];
+			}
+		}
+		dsp_linalg_cholesky_solve(2 * d, (const double (*)[MAX_MICS]) normal,
+			solution);
+		for (i = 0; i < d; i++)
+		{
+			psi[i][k] = solution[i] + I * solution[d + i];
+		}
+	}
+
+	/* mu = sin(theta) * exp(j * phi) of each source. The array is planar,
+		so the elevation above it has no sign. */
+	__complex_eigenvalues(d, psi, mu);
+	for (k = 0; k < d; k++)
+	{
+		result[k].azimuth = fmod(carg(mu[k]) * 180.0 / M_PI + 360.0, 360.0);
+		result[k].elevation = acos(fmin(cabs(mu[k]), 1.0)) * 180.0 / M_PI;
+	}
+	return d;
+}
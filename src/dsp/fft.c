@@ -0,0 +1,478 @@
+/**
+ ******************************************************************************
+ * @file 	fft.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Mixed-radix fast Fourier transformations.
+ * 
+ ******************************************************************************
+ * @attention
+ * 
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ * 
+ * This software is licensed under the MIT License.
+ * 
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+#include <complex.h>
+#include <pthread.h>
+
+/* The plans are created once per length and then shared read-only. */
+
+static DspFFTPlan *fftPlans[DSP_FFT_MAX_PLANS];
+static int fftPlanCount = 0;
+static pthread_mutex_t fftPlanMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Split the transform length into radix-4, 2, 3 and odd prime stages.
+ */
+static void __fft_factorize(DspFFTPlan *plan)
+{
+	len_t n, p;
+
+	n = plan->length;
+	p = 4;
+	plan->stages = 0;
+	plan->maxRadix = 1;
+	while (n > 1)
+	{
+		while (n % p)
+		{
+			switch (p)
+			{
+				case 4: p = 2; break;
+				case 2: p = 3; break;
+				default: p += 2; break;
+			}
+			if (p * p > n)
+			{
+				p = n;		/* no more factors, the rest is prime */
+			}
+		}
+		assert (plan->stages < DSP_FFT_MAX_FACTORS);
+		plan->factors[plan->stages++] = (int) p;
+		if ((int) p > plan->maxRadix)
+		{
+			plan->maxRadix = (int) p;
+		}
+		n /= p;
+	}
+}
+
+/**
+ * Fill the digit-reversed input order of the decimation-in-time stages.
+ */
+static void __fft_permute(DspFFTPlan *plan, len_t *out, len_t in,
+	len_t stride, int stage)
+{
+	int i, p;
+	len_t m;
+
+	if (stage == plan->stages)
+	{
+		*out = in;
+		return;
+	}
+	p = plan->factors[stage];
+	m = plan->length / (stride * p);	/* outputs of each sub-transform */
+	for (i = 0; i < p; i++)
+	{
+		__fft_permute(plan, out + i * m, in + i * stride, stride * p,
+			stage + 1);
+	}
+}
+
+/**
+ * Create a new plan with its twiddle and permutation tables.
+ */
+static DspFFTPlan *__fft_plan_new(len_t length)
+{
+	len_t k;
+	DspFFTPlan *plan;
+
+	plan = calloc(1, sizeof(DspFFTPlan));
+	assert (plan != NULL);
+
+	plan->length = length;
+	plan->permute = malloc(length * sizeof(len_t));
+	plan->twiddles = malloc(length * sizeof(double [2]));
+	plan->twiddlesF32 = malloc(length * sizeof(float [2]));
+	assert (plan->permute != NULL && plan->twiddles != NULL);
+	assert (plan->twiddlesF32 != NULL);
+
+	__fft_factorize(plan);
+	__fft_permute(plan, plan->permute, 0, 1, 0);
+	for (k = 0; k < length; k++)
+	{
+		plan->twiddles[k][0] = cos(-2.0 * M_PI * k / length);
+		plan->twiddles[k][1] = sin(-2.0 * M_PI * k / length);
+		plan->twiddlesF32[k][0] = (float) plan->twiddles[k][0];
+		plan->twiddlesF32[k][1] = (float) plan->twiddles[k][1];
+	}
+	return plan;
+}
+
+/* The transformation kernels are instantiated once per precision. Both
+	of them share the plans, which keep the twiddles of each precision. */
+
+#define FFT_REAL					double
+#define FFT_COMPLEX				double complex
+#define FFT_CONJ					conj
+#define FFT_CIMAG					cimag
+#define FFT_TWIDDLES(plan)		((plan)->twiddles)
+#define FFT_NAME(name)			name##_f64
+#include "./fft_kernel.h"
+#undef FFT_REAL
+#undef FFT_COMPLEX
+#undef FFT_CONJ
+#undef FFT_CIMAG
+#undef FFT_TWIDDLES
+#undef FFT_NAME
+
+#define FFT_REAL					float
+#define FFT_COMPLEX				float complex
+#define FFT_CONJ					conjf
+#define FFT_CIMAG					cimagf
+#define FFT_TWIDDLES(plan)		((plan)->twiddlesF32)
+#define FFT_NAME(name)			name##_f32
+#include "./fft_kernel.h"
+#undef FFT_REAL
+#undef FFT_COMPLEX
+#undef FFT_CONJ
+#undef FFT_CIMAG
+#undef FFT_TWIDDLES
+#undef FFT_NAME
+
+/**
+ * Get the shared plan of given transform length.
+ */
+const DspFFTPlan *dsp_fft_plan(len_t length)
+{
+	int i;
+	DspFFTPlan *plan = NULL;
+
+	assert_length(length);
+
+	pthread_mutex_lock(&fftPlanMutex);
+	for (i = 0; i < fftPlanCount; i++)
+	{
+		if (fftPlans[i]->length == length)
+		{
+			plan = fftPlans[i];
+			break;
+		}
+	}
+	if (plan == NULL)
+	{
+		assert (fftPlanCount < DSP_FFT_MAX_PLANS);
+		plan = __fft_plan_new(length);
+		fftPlans[fftPlanCount++] = plan;
+	}
+	pthread_mutex_unlock(&fftPlanMutex);
+
+	return plan;
+}
+
+/**
+ * Complex-to-complex transformation. The `input` and `output` must not
+ * overlap. Inverse transformation isn't normalized by the length.
+ */
+void dsp_fft_complex(const DspFFTPlan *plan, const double (*input)[2],
+	double (*output)[2], int inverse)
+{
+	assert_plan(plan);
+	assert (input != NULL && output != NULL && (void *) input != output);
+
+	__fft_complex_f64(plan, (const double complex *) input,
+		(double complex *) output, inverse);
+}
+
+/**
+ * Single-precision complex-to-complex transformation.
+ */
+void dsp_fft_complex_f32(const DspFFTPlan *plan, const float (*input)[2],
+	float (*output)[2], int inverse)
+{
+	assert_plan(plan);
+	assert (input != NULL && output != NULL && (void *) input != output);
+
+	__fft_complex_f32(plan, (const float complex *) input,
+		(float complex *) output, inverse);
+}
+
+/**
+ * Fast Fourier transformation with the same output of DFT.
+ */
+void dsp_transform_fft(const DspTime *sample, DspFreq *result)
+{
+	len_t k;
+	const DspFFTPlan *plan;
+	double (*input)[2];
+
+	assert_sample(sample);
+
+	plan = dsp_fft_plan(sample->length);
+	input = malloc(sample->length * sizeof(double [2]));
+	assert (input != NULL);
+
+	for (k = 0; k < sample->length; k++)
+	{
+		input[k][0] = sample->data[k];
+		input[k][1] = 0.0;
+	}
+	dsp_fft_complex(plan, (const double (*)[2]) input, result->data, 0);
+	result->length = sample->length;
+
+	free(input);
+}
+
+/**
+ * Inverse fast Fourier transformation with the same output of IDFT.
+ */
+void dsp_transform_ifft(const DspFreq *sample, DspTime *result)
+{
+	len_t k;
+	const DspFFTPlan *plan;
+	double (*output)[2];
+
+	assert_sample(sample);
+
+	plan = dsp_fft_plan(sample->length);
+	output = malloc(sample->length * sizeof(double [2]));
+	assert (output != NULL);
+
+	dsp_fft_complex(plan, sample->data, output, 1);
+	for (k = 0; k < sample->length; k++)
+	{
+		result->data[k] = output[k][0] / sample->length;
+	}
+	result->length = sample->length;
+
+	free(output);
+}
+
+/**
+ * Real-input fast Fourier transformation with the same output of real DFT.
+ * Only `length / 2 + 1` bins are computed.
+ */
+void dsp_transform_rfft(const DspTime *sample, DspFreq *result)
+{
+	double complex *scratch;
+
+	assert_sample(sample);
+
+	scratch = malloc(2 * sample->length * sizeof(double complex));
+	assert (scratch != NULL);
+
+	__rfft_f64(sample->data, sample->length, (double complex *) result->data,
+		scratch);
+	result->length = sample->length / 2 + 1;
+
+	free(scratch);
+}
+
+/**
+ * Real-input fast Fourier transformation of two samples at once. The 
+ * samples are packed as real and imaginary parts of one transformation.
+ */
+void dsp_transform_rfft_pair(const DspTime *fsample, const DspTime *ssample,
+	DspFreq *fresult, DspFreq *sresult)
+{
+	double complex *scratch;
+
+	assert_sample(fsample);
+	assert_sample(ssample);
+	assert (fsample->length == ssample->length);
+
+	scratch = malloc(2 * fsample->length * sizeof(double complex));
+	assert (scratch != NULL);
+
+	__rfft_pair_f64(fsample->data, ssample->data, fsample->length,
+		(double complex *) fresult->data, (double complex *) sresult->data,
+		scratch);
+	fresult->length = fsample->length / 2 + 1;
+	sresult->length = fsample->length / 2 + 1;
+
+	free(scratch);
+}
+
+/**
+ * Real-input fast Fourier transformation of many samples such as the 
+ * microphone channels. The samples are transformed pair by pair.
+ */
+void dsp_transform_rfft_batch(const DspTime *samples, int count, 
+	DspFreq *results)
+{
+	int i;
+
+	assert (samples != NULL && results != NULL && count > 0);
+
+	for (i = 0; i + 1 < count; i += 2)
+	{
+		dsp_transform_rfft_pair(&samples[i], &samples[i + 1], 
+			&results[i], &results[i + 1]);
+	}
+	if (count % 2)
+	{
+		dsp_transform_rfft(&samples[count - 1], &results[count - 1]);
+	}
+}
+
+/**
+ * Real-input fast Fourier transformation of the view. The scratch buffer
+ * is taken from the `arena` and released before return.
+ */
+void dsp_view_rfft(const DspTimeView *sample, DspFreqView *result,
+	DspArena *arena)
+{
+	size_t mark;
+	double complex *scratch;
+
+	assert_view(sample);
+	assert (result != NULL && result->capacity >= sample->length / 2 + 1);
+
+	mark = dsp_arena_mark(arena);
+	scratch = dsp_arena_alloc(arena, 2 * sample->length * 
+		sizeof(double complex));
+
+	__rfft_f64(sample->data, sample->length, (double complex *) result->data,
+		scratch);
+	result->length = sample->length / 2 + 1;
+
+	dsp_arena_rewind(arena, mark);
+}
+
+/**
+ * Real-input fast Fourier transformation of two views at once.
+ */
+void dsp_view_rfft_pair(const DspTimeView *fsample, 
+	const DspTimeView *ssample, DspFreqView *fresult, DspFreqView *sresult,
+	DspArena *arena)
+{
+	size_t mark;
+	len_t bins;
+	double complex *scratch;
+
+	assert_view(fsample);
+	assert_view(ssample);
+	assert (fsample->length == ssample->length);
+
+	bins = fsample->length / 2 + 1;
+	assert (fresult != NULL && fresult->capacity >= bins);
+	assert (sresult != NULL && sresult->capacity >= bins);
+
+	mark = dsp_arena_mark(arena);
+	scratch = dsp_arena_alloc(arena, 2 * fsample->length * 
+		sizeof(double complex));
+
+	__rfft_pair_f64(fsample->data, ssample->data, fsample->length,
+		(double complex *) fresult->data, (double complex *) sresult->data,
+		scratch);
+	fresult->length = bins;
+	sresult->length = bins;
+
+	dsp_arena_rewind(arena, mark);
+}
+
+/**
+ * Real-input fast Fourier transformation of many views such as the 
+ * microphone channels. The views are transformed pair by pair.
+ */
+void dsp_view_rfft_batch(const DspTimeView *samples, int count, 
+	DspFreqView *results, DspArena *arena)
+{
+	int i;
+
+	assert (samples != NULL && results != NULL && count > 0);
+
+	for (i = 0; i + 1 < count; i += 2)
+	{
+		dsp_view_rfft_pair(&samples[i], &samples[i + 1], 
+			&results[i], &results[i + 1], arena);
+	}
+	if (count % 2)
+	{
+		dsp_view_rfft(&samples[count - 1], &results[count - 1], arena);
+	}
+}
+
+/**
+ * Single-precision real-input fast Fourier transformation of the view.
+ * The scratch buffer is taken from the `arena` and released before return.
+ */
+void dsp_view_rfft_f32(const DspTimeViewF32 *sample, DspFreqViewF32 *result,
+	DspArena *arena)
+{
+	size_t mark;
+	float complex *scratch;
+
+	assert_view(sample);
+	assert (result != NULL && result->capacity >= sample->length / 2 + 1);
+
+	mark = dsp_arena_mark(arena);
+	scratch = dsp_arena_alloc(arena, 2 * sample->length * 
+		sizeof(float complex));
+
+	__rfft_f32(sample->data, sample->length, (float complex *) result->data,
+		scratch);
+	result->length = sample->length / 2 + 1;
+
+	dsp_arena_rewind(arena, mark);
+}
+
+/**
+ * Single-precision real-input fast Fourier transformation of two views at
+ * once.
+ */
+void dsp_view_rfft_pair_f32(const DspTimeViewF32 *fsample, 
+	const DspTimeViewF32 *ssample, DspFreqViewF32 *fresult, 
+	DspFreqViewF32 *sresult, DspArena *arena)
+{
+	size_t mark;
+	len_t bins;
+	float complex *scratch;
+
+	assert_view(fsample);
+	assert_view(ssample);
+	assert (fsample->length == ssample->length);
+
+	bins = fsample->length / 2 + 1;
+	assert (fresult != NULL && fresult->capacity >= bins);
+	assert (sresult != NULL && sresult->capacity >= bins);
+
+	mark = dsp_arena_mark(arena);
+	scratch = dsp_arena_alloc(arena, 2 * fsample->length * 
+		sizeof(float complex));
+
+	__rfft_pair_f32(fsample->data, ssample->data, fsample->length,
+		(float complex *) fresult->data, (float complex *) sresult->data,
+		scratch);
+	fresult->length = bins;
+	sresult->length = bins;
+
+	dsp_arena_rewind(arena, mark);
+}
+
+/**
+ * Single-precision real-input fast Fourier transformation of many views. 
+ * The views are transformed pair by pair.
+ */
+void dsp_view_rfft_batch_f32(const DspTimeViewF32 *samples, int count, 
+	DspFreqViewF32 *results, DspArena *arena)
+{
+	int i;
+
+	assert (samples != NULL && results != NULL && count > 0);
+
+	for (i = 0; i + 1 < count; i += 2)
+	{
+		dsp_view_rfft_pair_f32(&samples[i], &samples[i + 1], 
+			&results[i], &results[i + 1], arena);
+	}
+	if (count % 2)
+	{
+		dsp_view_rfft_f32(&samples[count - 1], &results[count - 1], arena);
+	}
+}
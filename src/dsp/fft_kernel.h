@@ -0,0 +1,271 @@
+/**
+ ******************************************************************************
+ * @file 	fft_kernel.h
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Mixed-radix FFT kernels of one floating-point precision.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+/*	It's only included by fft.c, once per precision, after defining:
+
+		FFT_REAL			--> double or float
+		FFT_COMPLEX		--> double complex or float complex
+		FFT_CONJ			--> conj or conjf
+		FFT_CIMAG		--> cimag or cimagf
+		FFT_TWIDDLES	--> twiddle table of plan in that precision
+		FFT_NAME(name)	--> name of kernel with precision suffix
+
+	So both precisions share the same butterflies and the same plans. */
+
+/**
+ * Radix-2 butterfly over `m` interleaved sub-transforms.
+ */
+static void FFT_NAME(__fft_bfly2)(FFT_COMPLEX *out, const FFT_COMPLEX *tw,
+	len_t fstride, len_t m)
+{
+	len_t k;
+	FFT_COMPLEX t;
+
+	for (k = 0; k < m; k++)
+	{
+		t = out[k + m] * tw[k * fstride];
+		out[k + m] = out[k] - t;
+		out[k] += t;
+	}
+}
+
+/**
+ * Radix-3 butterfly over `m` interleaved sub-transforms.
+ */
+static void FFT_NAME(__fft_bfly3)(FFT_COMPLEX *out, const FFT_COMPLEX *tw,
+	len_t fstride, len_t m)
+{
+	len_t k;
+	FFT_COMPLEX s0, s1, s2, s3;
+	FFT_REAL epi3;
+
+	epi3 = FFT_CIMAG(tw[fstride * m]);	/* sin(-2*pi/3) */
+	for (k = 0; k < m; k++)
+	{
+		s1 = out[k + m] * tw[k * fstride];
+		s2 = out[k + 2 * m] * tw[2 * k * fstride];
+		s3 = s1 + s2;
+		s0 = (s1 - s2) * epi3;
+
+		out[k + m] = out[k] - (FFT_REAL) 0.5 * s3;
+		out[k] += s3;
+		out[k + 2 * m] = out[k + m] - I * s0;
+		out[k + m] += I * s0;
+	}
+}
+
+/**
+ * Radix-4 butterfly over `m` interleaved sub-transforms.
+ */
+static void FFT_NAME(__fft_bfly4)(FFT_COMPLEX *out, const FFT_COMPLEX *tw,
+	len_t fstride, len_t m)
+{
+	len_t k;
+	FFT_COMPLEX s0, s1, s2, s3, s4, s5;
+
+	for (k = 0; k < m; k++)
+	{
+		s0 = out[k + m] * tw[k * fstride];
+		s1 = out[k + 2 * m] * tw[2 * k * fstride];
+		s2 = out[k + 3 * m] * tw[3 * k * fstride];
+		s5 = out[k] - s1;
+		s3 = out[k] + s1 + s0 + s2;
+		s4 = s0 - s2;
+
+		out[k + 2 * m] = out[k] + s1 - s0 - s2;
+		out[k] = s3;
+		out[k + m] = s5 - I * s4;
+		out[k + 3 * m] = s5 + I * s4;
+	}
+}
+
+/**
+ * Generic odd radix butterfly over `m` interleaved sub-transforms.
+ */
+static void FFT_NAME(__fft_bfly_generic)(FFT_COMPLEX *out,
+	const FFT_COMPLEX *tw, len_t fstride, len_t m, int p, len_t length,
+	FFT_COMPLEX *scratch)
+{
+	int q, q1;
+	len_t u, k, index;
+
+	for (u = 0; u < m; u++)
+	{
+		for (q1 = 0, k = u; q1 < p; q1++, k += m)
+		{
+			scratch[q1] = out[k];
+		}
+		for (q1 = 0, k = u; q1 < p; q1++, k += m)
+		{
+			index = 0;
+			out[k] = scratch[0];
+			for (q = 1; q < p; q++)
+			{
+				index += fstride * k;
+				if (index >= length)
+				{
+					index -= length;
+				}
+				out[k] += scratch[q] * tw[index];
+			}
+		}
+	}
+}
+
+/**
+ * Complex-to-complex transformation. The `in` and `out` must not overlap.
+ * Inverse transformation isn't normalized by the length.
+ */
+static void FFT_NAME(__fft_complex)(const DspFFTPlan *plan,
+	const FFT_COMPLEX *in, FFT_COMPLEX *out, int inverse)
+{
+	int stage, p;
+	len_t k, m, fstride, block, blocks;
+	FFT_COMPLEX *scratch = NULL;
+	const FFT_COMPLEX *tw;
+
+	tw = (const FFT_COMPLEX *) FFT_TWIDDLES(plan);
+
+	/* Gather the inputs in digit-reversed order, X(-k) = conj(x(k)). */
+	for (k = 0; k < plan->length; k++)
+	{
+		out[k] = inverse ? FFT_CONJ(in[plan->permute[k]]) :
+			in[plan->permute[k]];
+	}
+	if (plan->maxRadix > 4)
+	{
+		scratch = malloc(plan->maxRadix * sizeof(FFT_COMPLEX));
+		assert (scratch != NULL);
+	}
+	/* Combine the sub-transforms from the innermost stage to outermost. */
+	m = 1;
+	for (stage = plan->stages - 1; stage >= 0; stage--)
+	{
+		p = plan->factors[stage];
+		blocks = plan->length / (m * p);
+		fstride = blocks;
+		for (block = 0; block < blocks; block++)
+		{
+			switch (p)
+			{
+				case 2:
+					FFT_NAME(__fft_bfly2)(out + block * p * m, tw, fstride, m);
+					break;
+				case 3:
+					FFT_NAME(__fft_bfly3)(out + block * p * m, tw, fstride, m);
+					break;
+				case 4:
+					FFT_NAME(__fft_bfly4)(out + block * p * m, tw, fstride, m);
+					break;
+				default:
+					FFT_NAME(__fft_bfly_generic)(out + block * p * m, tw,
+						fstride, m, p, plan->length, scratch);
+					break;
+			}
+		}
+		m *= p;
+	}
+	if (inverse)
+	{
+		for (k = 0; k < plan->length; k++)
+		{
+			out[k] = FFT_CONJ(out[k]);
+		}
+	}
+	free(scratch);
+}
+
+/**
+ * Real-input transformation of `length` samples into `length / 2 + 1`
+ * bins. Even lengths are packed into a half-length complex transformation.
+ * The `scratch` holds `2 * length` complex numbers.
+ */
+static void FFT_NAME(__rfft)(const FFT_REAL *data, len_t length,
+	FFT_COMPLEX *out, FFT_COMPLEX *scratch)
+{
+	len_t k, half;
+	const DspFFTPlan *plan, *halfPlan;
+	FFT_COMPLEX *spectrum, even, odd, zk, zc;
+
+	plan = dsp_fft_plan(length);
+
+	/* Odd lengths can't be packed, so use the complex transformation. */
+	if (length % 2)
+	{
+		spectrum = scratch + length;
+		for (k = 0; k < length; k++)
+		{
+			scratch[k] = data[k];
+		}
+		FFT_NAME(__fft_complex)(plan, scratch, spectrum, 0);
+		memcpy(out, spectrum, (length / 2 + 1) * sizeof(FFT_COMPLEX));
+		return;
+	}
+	half = length / 2;
+	halfPlan = dsp_fft_plan(half);
+	spectrum = scratch + half;
+
+	/* Pack the even and odd samples as real and imaginary parts. */
+	for (k = 0; k < half; k++)
+	{
+		scratch[k] = data[2 * k] + I * data[2 * k + 1];
+	}
+	FFT_NAME(__fft_complex)(halfPlan, scratch, spectrum, 0);
+
+	/* Split the even and odd spectrums and then combine them. The plan
+		of full length is only used for its twiddles. */
+	for (k = 0; k <= half; k++)
+	{
+		zk = spectrum[k % half];
+		zc = FFT_CONJ(spectrum[(half - k) % half]);
+		even = (FFT_REAL) 0.5 * (zk + zc);
+		odd = (FFT_REAL) -0.5 * I * (zk - zc);
+		out[k] = even + ((const FFT_COMPLEX *) FFT_TWIDDLES(plan))[k] * odd;
+	}
+}
+
+/**
+ * Real-input transformation of two samples at once. The samples are packed
+ * as real and imaginary parts of one transformation. The `scratch` holds
+ * `2 * length` complex numbers.
+ */
+static void FFT_NAME(__rfft_pair)(const FFT_REAL *fdata,
+	const FFT_REAL *sdata, len_t length, FFT_COMPLEX *fout,
+	FFT_COMPLEX *sout, FFT_COMPLEX *scratch)
+{
+	len_t k;
+	const DspFFTPlan *plan;
+	FFT_COMPLEX *spectrum, zk, zc;
+
+	plan = dsp_fft_plan(length);
+	spectrum = scratch + length;
+
+	for (k = 0; k < length; k++)
+	{
+		scratch[k] = fdata[k] + I * sdata[k];
+	}
+	FFT_NAME(__fft_complex)(plan, scratch, spectrum, 0);
+
+	/* Use the conjugate symmetry of real spectrums to separate them. */
+	for (k = 0; k <= length / 2; k++)
+	{
+		zk = spectrum[k];
+		zc = FFT_CONJ(spectrum[(length - k) % length]);
+		fout[k] = (FFT_REAL) 0.5 * (zk + zc);
+		sout[k] = (FFT_REAL) -0.5 * I * (zk - zc);
+	}
+}
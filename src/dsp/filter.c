@@ -0,0 +1,349 @@
+/**
+ ******************************************************************************
+ * @file 	filter.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Streaming FIR and IIR filters that carry their state.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+
+/*	The filters of library design their coefficients at each call and start
+	from silence, so each frame starts with a transient. The filters here
+	are designed once and keep a state per channel, so the frames of a
+	stream are filtered as if they were a single signal.
+
+	The FIR filter is the Blackman-windowed sinc of the library, but causal:
+	it lags by (taps - 1) / 2 samples instead of being centered on the
+	frame. The long kernels run on the overlap-save convolver.
+
+	The IIR filter is a cascade of second-order sections in the transposed
+	direct form II, each with the cookbook biquad of R. Bristow-Johnson
+
+		y(n) = b0 * x(n) + s1,	s1 = b1 * x(n) - a1 * y(n) + s2,
+		s2 = b2 * x(n) - a2 * y(n)
+
+	A Butterworth filter of even order is the cascade of its pole pairs,
+	with the quality 1 / (2 * sin((2k + 1) * pi / (2 * order))) of each.
+	The channels are separate views, and each section runs over a whole
+	channel with its state in registers. */
+
+/**
+ * Fill the Blackman-windowed sinc of normalized cutoff `fn` into `h`, with
+ * the unity gain at DC.
+ */
+static void __fir_sinc(double fn, int taps, double *h)
+{
+	int i;
+	double x, phase, sum = 0.0;
+
+	for (i = 0; i < taps; i++)
+	{
+		x = i - (taps - 1) / 2.0;
+		h[i] = (x == 0.0) ? 2.0 * fn : sin(2.0 * M_PI * fn * x) / (M_PI * x);
+		if (taps > 1)
+		{
+			phase = 2.0 * M_PI * i / (taps - 1);
+			h[i] *= 0.42 - 0.5 * cos(phase) + 0.08 * cos(2.0 * phase);
+		}
+		sum += h[i];
+	}
+	for (i = 0; i < taps; i++)
+	{
+		h[i] /= sum;
+	}
+}
+
+/**
+ * Turn the filter of `taps` coefficients to its complement, delta - h.
+ */
+static void __fir_invert(int taps, double *h)
+{
+	int i;
+
+	for (i = 0; i < taps; i++)
+	{
+		h[i] = -h[i];
+	}
+	h[(taps - 1) / 2] += 1.0;
+}
+
+/**
+ * Design the FIR `filter` of odd `taps` coefficients into `coeffs`. The
+ * low and high pass filters cut at `fc1`, the band filters pass or stop
+ * from `fc1` to `fc2`.
+ */
+void dsp_fir_design(DspFilter filter, double fc1, double fc2, double fs,
+	int taps, double *coeffs)
+{
+	int i;
+	double *upper;
+
+	assert (coeffs != NULL && taps > 0 && taps % 2 == 1);
+	assert (fs > 0.0 && fc1 > 0.0 && fc1 < fs / 2.0);
+	assert (filter == DSP_FILTER_LOW_PASS || filter == DSP_FILTER_HIGH_PASS ||
+		(fc2 > fc1 && fc2 < fs / 2.0));
+
+	__fir_sinc(fc1 / fs, taps, coeffs);
+	if (filter == DSP_FILTER_HIGH_PASS)
+	{
+		__fir_invert(taps, coeffs);
+	}
+	else if (filter == DSP_FILTER_BAND_PASS || filter == DSP_FILTER_BAND_STOP)
+	{
+		/* The band is the low pass of `fc2` less the one of `fc1`. */
+		upper = malloc(taps * sizeof(double));
+		assert (upper != NULL);
+		__fir_sinc(fc2 / fs, taps, upper);
+		for (i = 0; i < taps; i++)
+		{
+			coeffs[i] = upper[i] - coeffs[i];
+		}
+		free(upper);
+		if (filter == DSP_FILTER_BAND_STOP)
+		{
+			__fir_invert(taps, coeffs);
+		}
+	}
+}
+
+/**
+ * Prepare the FIR `filter` of `channels` with its state. The arguments of
+ * design are the ones of `dsp_fir_design()`.
+ */
+void dsp_fir_init(DspFir *fir, DspFilter filter, double fc1, double fc2,
+	double fs, int taps, int channels)
+{
+	int c;
+	double *coeffs;
+
+	assert (fir != NULL);
+	assert (channels > 0 && channels <= MAX_MICS);
+
+	coeffs = malloc(taps * sizeof(double));
+	assert (coeffs != NULL);
+	dsp_fir_design(filter, fc1, fc2, fs, taps, coeffs);
+
+	fir->channels = channels;
+	for (c = 0; c < channels; c++)
+	{
+		dsp_convolver_init(&fir->convolvers[c], coeffs, taps);
+	}
+	free(coeffs);
+}
+
+/**
+ * Forget the inputs of the previous frames of all channels.
+ */
+void dsp_fir_reset(DspFir *fir)
+{
+	int c;
+
+	assert (fir != NULL);
+
+	for (c = 0; c < fir->channels; c++)
+	{
+		dsp_convolver_reset(&fir->convolvers[c]);
+	}
+}
+
+/**
+ * Filter the frame of each channel, `inputs[c]` into `outputs[c]`. The
+ * output lags the input by (taps - 1) / 2 samples. The inputs and outputs
+ * must not overlap.
+ */
+void dsp_fir_process(DspFir *fir, const DspTimeView *inputs,
+	DspTimeView *outputs)
+{
+	int c;
+
+	assert (fir != NULL && inputs != NULL && outputs != NULL);
+
+	for (c = 0; c < fir->channels; c++)
+	{
+		dsp_convolver_process(&fir->convolvers[c], &inputs[c], &outputs[c]);
+	}
+}
+
+/**
+ * Release the convolvers of the channels.
+ */
+void dsp_fir_free(DspFir *fir)
+{
+	int c;
+
+	assert (fir != NULL);
+
+	for (c = 0; c < fir->channels; c++)
+	{
+		dsp_convolver_free(&fir->convolvers[c]);
+	}
+	fir->channels = 0;
+}
+
+/**
+ * Design the cookbook biquad of `filter` at `fc` Hz with the quality `q`.
+ * The band filters are centered on `fc` with the bandwidth of fc / q.
+ */
+void dsp_biquad_design(DspBiquad *biquad, DspFilter filter, double fc,
+	double fs, double q)
+{
+	double omega, alpha, cosine, a0;
+
+	assert (biquad != NULL);
+	assert (fs > 0.0 && fc > 0.0 && fc < fs / 2.0 && q > 0.0);
+
+	omega = 2.0 * M_PI * fc / fs;
+	cosine = cos(omega);
+	alpha = sin(omega) / (2.0 * q);
+	switch (filter)
+	{
+		case DSP_FILTER_LOW_PASS:
+			biquad->b0 = (1.0 - cosine) / 2.0;
+			biquad->b1 = 1.0 - cosine;
+			biquad->b2 = (1.0 - cosine) / 2.0;
+			break;
+		case DSP_FILTER_HIGH_PASS:
+			biquad->b0 = (1.0 + cosine) / 2.0;
+			biquad->b1 = -(1.0 + cosine);
+			biquad->b2 = (1.0 + cosine) / 2.0;
+			break;
+		case DSP_FILTER_BAND_PASS:
+			biquad->b0 = alpha;
+			biquad->b1 = 0.0;
+			biquad->b2 = -alpha;
+			break;
+		case DSP_FILTER_BAND_STOP:
+			biquad->b0 = 1.0;
+			biquad->b1 = -2.0 * cosine;
+			biquad->b2 = 1.0;
+			break;
+		default:
+			assert (0);
+	}
+	a0 = 1.0 + alpha;
+	biquad->b0 /= a0;
+	biquad->b1 /= a0;
+	biquad->b2 /= a0;
+	biquad->a1 = -2.0 * cosine / a0;
+	biquad->a2 = (1.0 - alpha) / a0;
+}
+
+/**
+ * Prepare an empty cascade of `channels` that passes the signal as it is.
+ */
+void dsp_sos_init(DspSos *sos, int channels)
+{
+	assert (sos != NULL);
+	assert (channels > 0 && channels <= MAX_MICS);
+
+	memset(sos, 0, sizeof(DspSos));
+	sos->channels = channels;
+}
+
+/**
+ * Append the `biquad` to the end of cascade, from the silence.
+ */
+void dsp_sos_append(DspSos *sos, const DspBiquad *biquad)
+{
+	assert (sos != NULL && biquad != NULL);
+	assert (sos->sections < DSP_SOS_MAX_SECTIONS);
+
+	sos->biquads[sos->sections] = *biquad;
+	memset(sos->state[sos->sections], 0, sizeof(sos->state[0]));
+	sos->sections++;
+}
+
+/**
+ * Append the Butterworth low or high pass `filter` of even `order` at `fc`
+ * Hz. A band is a high pass at its lower edge and a low pass at its upper.
+ */
+void dsp_sos_butterworth(DspSos *sos, DspFilter filter, int order,
+	double fc, double fs)
+{
+	int k;
+	DspBiquad biquad;
+
+	assert (sos != NULL);
+	assert (filter == DSP_FILTER_LOW_PASS || filter == DSP_FILTER_HIGH_PASS);
+	assert (order > 0 && order % 2 == 0);
+	assert (sos->sections + order / 2 <= DSP_SOS_MAX_SECTIONS);
+
+	for (k = 0; k < order / 2; k++)
+	{
+		dsp_biquad_design(&biquad, filter, fc, fs,
+			1.0 / (2.0 * sin((2 * k + 1) * M_PI / (2.0 * order))));
+		dsp_sos_append(sos, &biquad);
+	}
+}
+
+/**
+ * Forget the state of all sections and channels.
+ */
+void dsp_sos_reset(DspSos *sos)
+{
+	assert (sos != NULL);
+
+	memset(sos->state, 0, sizeof(sos->state));
+}
+
+/**
+ * Filter the frame of each channel, `inputs[c]` into `outputs[c]`, through
+ * the sections. The state is carried over to the next call. An output may
+ * be its own input.
+ */
+void dsp_sos_process(DspSos *sos, const DspTimeView *inputs,
+	DspTimeView *outputs)
+{
+	int c, k;
+	len_t n;
+	double x, y, s1, s2;
+	const double *source;
+	const DspBiquad *biquad;
+	const DspTimeView *input;
+	DspTimeView *output;
+
+	assert (sos != NULL && inputs != NULL && outputs != NULL);
+
+	for (c = 0; c < sos->channels; c++)
+	{
+		input = &inputs[c];
+		output = &outputs[c];
+		assert_view(input);
+		assert (output->capacity >= input->length);
+
+		/* The first section reads the input, the others the output. */
+		source = input->data;
+		for (k = 0; k < sos->sections; k++)
+		{
+			biquad = &sos->biquads[k];
+			s1 = sos->state[k][c][0];
+			s2 = sos->state[k][c][1];
+			for (n = 0; n < input->length; n++)
+			{
+				x = source[n];
+				y = biquad->b0 * x + s1;
+				s1 = biquad->b1 * x - biquad->a1 * y + s2;
+				s2 = biquad->b2 * x - biquad->a2 * y;
+				output->data[n] = y;
+			}
+			sos->state[k][c][0] = s1;
+			sos->state[k][c][1] = s2;
+			source = output->data;
+		}
+		if (sos->sections == 0 && output->data != input->data)
+		{
+			memcpy(output->data, input->data, input->length * sizeof(double));
+		}
+		output->length = input->length;
+	}
+}
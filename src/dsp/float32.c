@@ -0,0 +1,432 @@
+/**
+ ******************************************************************************
+ * @file 	float32.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Single-precision time, frequency, window and filter methods.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+
+/*	The methods have the same semantics of their double counterparts in the
+	DSP library, only on single-precision views. The mic channels are int8,
+	so float keeps all of their precision with half of the memory traffic,
+	and it's the only precision of the FPU on the embedded side. */
+
+/**
+ * Convert the int8 PCM `data` of `length` samples to the view.
+ */
+void dsp_time_f32_from_int8(const int8_t *data, len_t length,
+	DspTimeViewF32 *result)
+{
+	len_t i;
+
+	assert (data != NULL && result != NULL && result->data != NULL);
+	assert_length(length);
+	assert (length <= result->capacity);
+
+	for (i = 0; i < length; i++)
+	{
+		result->data[i] = (float) data[i];
+	}
+	result->length = length;
+}
+
+/**
+ * Convert the double-precision `sample` to the view.
+ */
+void dsp_time_f32_from_double(const DspTime *sample, DspTimeViewF32 *result)
+{
+	len_t i;
+
+	assert_sample(sample);
+	assert (result != NULL && result->data != NULL);
+	assert (sample->length <= result->capacity);
+
+	for (i = 0; i < sample->length; i++)
+	{
+		result->data[i] = (float) sample->data[i];
+	}
+	result->length = sample->length;
+}
+
+/**
+ * Convert the view back to the double-precision `result`.
+ */
+void dsp_time_f32_to_double(const DspTimeViewF32 *sample, DspTime *result)
+{
+	len_t i;
+
+	assert_view(sample);
+	assert (result != NULL);
+
+	for (i = 0; i < sample->length; i++)
+	{
+		result->data[i] = (double) sample->data[i];
+	}
+	result->length = sample->length;
+}
+
+/**
+ * Return the maximum value of sample.
+ */
+float dsp_time_f32_max(const DspTimeViewF32 *sample)
+{
+	len_t i;
+	float max;
+
+	assert_view(sample);
+
+	max = sample->data[0];
+	for (i = 1; i < sample->length; i++)
+	{
+		if (sample->data[i] > max)
+		{
+			max = sample->data[i];
+		}
+	}
+	return max;
+}
+
+/**
+ * Return the minimum value of sample.
+ */
+float dsp_time_f32_min(const DspTimeViewF32 *sample)
+{
+	len_t i;
+	float min;
+
+	assert_view(sample);
+
+	min = sample->data[0];
+	for (i = 1; i < sample->length; i++)
+	{
+		if (sample->data[i] < min)
+		{
+			min = sample->data[i];
+		}
+	}
+	return min;
+}
+
+/**
+ * Return the maximum absolute value of sample.
+ */
+float dsp_time_f32_abs_max(const DspTimeViewF32 *sample)
+{
+	len_t i;
+	float max;
+
+	assert_view(sample);
+
+	max = fabsf(sample->data[0]);
+	for (i = 1; i < sample->length; i++)
+	{
+		if (fabsf(sample->data[i]) > max)
+		{
+			max = fabsf(sample->data[i]);
+		}
+	}
+	return max;
+}
+
+/**
+ * Return the index of first maximum value of sample.
+ */
+int dsp_time_f32_argmax(const DspTimeViewF32 *sample)
+{
+	len_t i;
+	int index = 0;
+
+	assert_view(sample);
+
+	for (i = 1; i < sample->length; i++)
+	{
+		if (sample->data[i] > sample->data[index])
+		{
+			index = (int) i;
+		}
+	}
+	return index;
+}
+
+/**
+ * Return the mean of sample.
+ */
+float dsp_time_f32_mean(const DspTimeViewF32 *sample)
+{
+	len_t i;
+	float sum = 0.0f;
+
+	assert_view(sample);
+
+	for (i = 0; i < sample->length; i++)
+	{
+		sum += sample->data[i];
+	}
+	return sum / sample->length;
+}
+
+/**
+ * Return the energy of sample.
+ */
+float dsp_time_f32_energy(const DspTimeViewF32 *sample)
+{
+	len_t i;
+	float energy = 0.0f;
+
+	assert_view(sample);
+
+	for (i = 0; i < sample->length; i++)
+	{
+		energy += sample->data[i] * sample->data[i];
+	}
+	return energy;
+}
+
+/**
+ * Return the average power of sample.
+ */
+float dsp_time_f32_power(const DspTimeViewF32 *sample)
+{
+	return dsp_time_f32_energy(sample) / sample->length;
+}
+
+/**
+ * Return the root mean square of sample.
+ */
+float dsp_time_f32_rms(const DspTimeViewF32 *sample)
+{
+	return sqrtf(dsp_time_f32_power(sample));
+}
+
+/**
+ * Return the population standard deviation of sample.
+ */
+float dsp_time_f32_stddev(const DspTimeViewF32 *sample)
+{
+	return sqrtf(dsp_time_f32_variance(sample));
+}
+
+/**
+ * Return the population variance of sample. The deviations from the mean
+ * are summed in a second pass, so float doesn't lose them.
+ */
+float dsp_time_f32_variance(const DspTimeViewF32 *sample)
+{
+	len_t i;
+	float mean, diff, sum = 0.0f;
+
+	mean = dsp_time_f32_mean(sample);
+	for (i = 0; i < sample->length; i++)
+	{
+		diff = sample->data[i] - mean;
+		sum += diff * diff;
+	}
+	return sum / sample->length;
+}
+
+/**
+ * Scale the sample so that its maximum absolute value is `scale`.
+ */
+void dsp_time_f32_scale(const DspTimeViewF32 *sample, float scale,
+	DspTimeViewF32 *result)
+{
+	len_t i;
+	float max;
+
+	assert_view(sample);
+	assert (result != NULL && result->capacity >= sample->length);
+
+	max = dsp_time_f32_abs_max(sample);
+	for (i = 0; i < sample->length; i++)
+	{
+		result->data[i] = (max > 0.0f) ? sample->data[i] * scale / max : 0.0f;
+	}
+	result->length = sample->length;
+}
+
+/**
+ * Calculate the magnitudes of the bins.
+ */
+void dsp_freq_f32_magnitude(const DspFreqViewF32 *sample,
+	DspTimeViewF32 *result)
+{
+	len_t i;
+
+	assert_view(sample);
+	assert (result != NULL && result->capacity >= sample->length);
+
+	for (i = 0; i < sample->length; i++)
+	{
+		result->data[i] = hypotf(sample->data[i][0], sample->data[i][1]);
+	}
+	result->length = sample->length;
+}
+
+/**
+ * Multiply the sample by the cached window of its length.
+ */
+static void __window_f32_table(const DspTimeViewF32 *sample, DspWindow type,
+	DspTimeViewF32 *result)
+{
+	assert_view(sample);
+	assert (result != NULL && result->capacity >= sample->length);
+
+	if (result->data != sample->data)
+	{
+		memcpy(result->data, sample->data, sample->length * sizeof(float));
+	}
+	result->length = sample->length;
+	dsp_window_apply_f32(type, 0, result);
+}
+
+/**
+ * Apply the Hamming window to the sample.
+ */
+void dsp_window_f32_hamming(const DspTimeViewF32 *sample,
+	DspTimeViewF32 *result)
+{
+	__window_f32_table(sample, DSP_WINDOW_HAMMING, result);
+}
+
+/**
+ * Apply the Hanning window to the sample.
+ */
+void dsp_window_f32_hanning(const DspTimeViewF32 *sample,
+	DspTimeViewF32 *result)
+{
+	__window_f32_table(sample, DSP_WINDOW_HANNING, result);
+}
+
+/**
+ * Apply the Blackman window to the sample.
+ */
+void dsp_window_f32_blackman(const DspTimeViewF32 *sample,
+	DspTimeViewF32 *result)
+{
+	__window_f32_table(sample, DSP_WINDOW_BLACKMAN, result);
+}
+
+/**
+ * Fill the Blackman-windowed sinc of normalized cutoff `fn` into `h`.
+ */
+static void __fir_f32_sinc(float fn, int taps, float *h)
+{
+	int i;
+	float x, phase;
+
+	for (i = 0; i < taps; i++)
+	{
+		x = i - (taps - 1) / 2.0f;
+		h[i] = (x == 0.0f) ? 2.0f * fn :
+			sinf(2.0f * (float) M_PI * fn * x) / ((float) M_PI * x);
+		if (taps > 1)
+		{
+			phase = 2.0f * (float) M_PI * i / (taps - 1);
+			h[i] *= 0.42f - 0.5f * cosf(phase) + 0.08f * cosf(2.0f * phase);
+		}
+	}
+}
+
+/**
+ * Convolve the sample with the `h` of `taps` centered on each sample, so
+ * the result has the same length of sample.
+ */
+static void __fir_f32_apply(const DspTimeViewF32 *sample, const float *h,
+	int taps, DspTimeViewF32 *result)
+{
+	len_t i;
+	int k;
+	long j;
+	float sum;
+
+	assert (result->data != sample->data);
+
+	for (i = 0; i < sample->length; i++)
+	{
+		sum = 0.0f;
+		for (k = 0; k < taps; k++)
+		{
+			j = (long) i + (taps - 1) / 2 - k;
+			if (j >= 0 && j < (long) sample->length)
+			{
+				sum += h[k] * sample->data[j];
+			}
+		}
+		result->data[i] = sum;
+	}
+	result->length = sample->length;
+}
+
+/**
+ * Apply the FIR low pass filter of odd `taps` coefficients. The coefficients
+ * are normalized to the unity gain at DC and taken from the `arena`.
+ */
+void dsp_filter_f32_fir_low_pass(const DspTimeViewF32 *sample, float fc,
+	float fs, int taps, DspTimeViewF32 *result, DspArena *arena)
+{
+	int i;
+	size_t mark;
+	float *h, sum = 0.0f;
+
+	assert_view(sample);
+	assert (result != NULL && result->capacity >= sample->length);
+	assert (taps > 0 && taps % 2 == 1);
+	assert (fs > 0.0f && fc > 0.0f && fc < fs / 2.0f);
+
+	mark = dsp_arena_mark(arena);
+	h = dsp_arena_alloc(arena, taps * sizeof(float));
+
+	__fir_f32_sinc(fc / fs, taps, h);
+	for (i = 0; i < taps; i++)
+	{
+		sum += h[i];
+	}
+	for (i = 0; i < taps; i++)
+	{
+		h[i] /= sum;
+	}
+	__fir_f32_apply(sample, h, taps, result);
+
+	dsp_arena_rewind(arena, mark);
+}
+
+/**
+ * Apply the FIR high pass filter of odd `taps` coefficients. It's the spectral
+ * inversion of the low pass one.
+ */
+void dsp_filter_f32_fir_high_pass(const DspTimeViewF32 *sample, float fc,
+	float fs, int taps, DspTimeViewF32 *result, DspArena *arena)
+{
+	int i;
+	size_t mark;
+	float *h;
+
+	assert_view(sample);
+	assert (result != NULL && result->capacity >= sample->length);
+	assert (taps > 0 && taps % 2 == 1);
+	assert (fs > 0.0f && fc > 0.0f && fc < fs / 2.0f);
+
+	mark = dsp_arena_mark(arena);
+	h = dsp_arena_alloc(arena, taps * sizeof(float));
+
+	__fir_f32_sinc(fc / fs, taps, h);
+	for (i = 0; i < taps; i++)
+	{
+		h[i] = -h[i];
+	}
+	h[(taps - 1) / 2] += 1.0f;
+	__fir_f32_apply(sample, h, taps, result);
+
+	dsp_arena_rewind(arena, mark);
+}
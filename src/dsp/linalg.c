@@ -0,0 +1,239 @@
+/**
+ ******************************************************************************
+ * @file 	linalg.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Small dense linear algebra of the array processing methods.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+#include <float.h>
+
+/*	The matrices of a phased array are at most MAX_MICS x MAX_MICS, so they
+	are kept in fixed-size arrays and solved in place without any heap. */
+
+/**
+ * Eigendecomposition of the symmetric `n` x `n` matrix with the cyclic
+ * Jacobi rotations. The eigenvalues are sorted in ascending order like
+ * GSL_EIGEN_SORT_VAL_ASC and the eigenvectors are stored in columns.
+ */
+void dsp_linalg_eigen_symm(int n, const double matrix[][MAX_MICS],
+	double *values, double vectors[][MAX_MICS])
+{
+	int i, j, k, p, q, sweep;
+	double a[MAX_MICS][MAX_MICS];
+	double off, theta, t, c, s, tau, apq, value, column[MAX_MICS];
+
+	assert (n > 0 && n <= MAX_MICS);
+	assert (matrix != NULL && values != NULL && vectors != NULL);
+
+	for (i = 0; i < n; i++)
+	{
+		for (j = 0; j < n; j++)
+		{
+			a[i][j] = matrix[i][j];
+			vectors[i][j] = (i == j) ? 1.0 : 0.0;
+		}
+	}
+
+	for (sweep = 0; sweep < DSP_JACOBI_SWEEPS; sweep++)
+	{
+		off = 0.0;
+		for (p = 0; p < n; p++)
+		{
+			for (q = p + 1; q < n; q++)
+			{
+				off += a[p][q] * a[p][q];
+			}
+		}
+		if (off < DBL_MIN)
+		{
+			break;
+		}
+		for (p = 0; p < n; p++)
+		{
+			for (q = p + 1; q < n; q++)
+			{
+				apq = a[p][q];
+				if (fabs(apq) < DBL_MIN)
+				{
+					continue;
+				}
+
+				/* The rotation that zeroes a[p][q], with the smaller angle. */
+				theta = (a[q][q] - a[p][p]) / (2.0 * apq);
+				t = copysign(1.0, theta) / (fabs(theta) +
+					sqrt(theta * theta + 1.0));
+				c = 1.0 / sqrt(t * t + 1.0);
+				s = t * c;
+				tau = s / (1.0 + c);
+
+				a[p][p] -= t * apq;
+				a[q][q] += t * apq;
+				a[p][q] = a[q][p] = 0.0;
+				for (k = 0; k < n; k++)
+				{
+					if (k != p && k != q)
+					{
+						value = a[k][p];
+						a[k][p] = a[p][k] = value - s * (a[k][q] + tau * value);
+						a[k][q] = a[q][k] = a[k][q] + s * (value - tau * a[k][q]);
+					}
+					value = vectors[k][p];
+					vectors[k][p] = value - s * (vectors[k][q] + tau * value);
+					vectors[k][q] += s * (value - tau * vectors[k][q]);
+				}
+			}
+		}
+	}
+
+	/* Sort the eigenpairs by insertion, n is small. */
+	for (i = 0; i < n; i++)
+	{
+		values[i] = a[i][i];
+	}
+	for (i = 1; i < n; i++)
+	{
+		value = values[i];
+		for (k = 0; k < n; k++)
+		{
+			column[k] = vectors[k][i];
+		}
+		for (j = i - 1; j >= 0 && values[j] > value; j--)
+		{
+			values[j + 1] = values[j];
+			for (k = 0; k < n; k++)
+			{
+				vectors[k][j + 1] = vectors[k][j];
+			}
+		}
+		values[j + 1] = value;
+		for (k = 0; k < n; k++)
+		{
+			vectors[k][j + 1] = column[k];
+		}
+	}
+}
+
+/**
+ * Orthonormalize the first `cols` columns of `n` x `cols` matrix in place
+ * with the modified Gram-Schmidt. Return the number of independent columns
+ * that are moved to the front.
+ */
+int dsp_linalg_orthonormalize(int n, int cols, double matrix[][MAX_MICS])
+{
+	int i, j, k, rank = 0;
+	double dot, norm;
+
+	assert (n > 0 && n <= MAX_MICS && cols >= 0 && cols <= n);
+	assert (matrix != NULL);
+
+	for (j = 0; j < cols; j++)
+	{
+		for (k = 0; k < rank; k++)
+		{
+			dot = 0.0;
+			for (i = 0; i < n; i++)
+			{
+				dot += matrix[i][k] * matrix[i][j];
+			}
+			for (i = 0; i < n; i++)
+			{
+				matrix[i][j] -= dot * matrix[i][k];
+			}
+		}
+		norm = 0.0;
+		for (i = 0; i < n; i++)
+		{
+			norm += matrix[i][j] * matrix[i][j];
+		}
+		norm = sqrt(norm);
+		if (norm < DSP_LINALG_EPSILON)
+		{
+			continue;		/* dependent on the previous columns */
+		}
+		for (i = 0; i < n; i++)
+		{
+			matrix[i][rank] = matrix[i][j] / norm;
+		}
+		rank++;
+	}
+	return rank;
+}
+
+/**
+ * Factorize the symmetric positive definite `n` x `n` matrix in place as
+ * L * L^T, the lower triangle keeps L. Return 0 if it isn't positive
+ * definite, otherwise 1.
+ */
+int dsp_linalg_cholesky(int n, double matrix[][MAX_MICS])
+{
+	int i, j, k;
+	double sum;
+
+	assert (n > 0 && n <= MAX_MICS);
+	assert (matrix != NULL);
+
+	for (j = 0; j < n; j++)
+	{
+		sum = matrix[j][j];
+		for (k = 0; k < j; k++)
+		{
+			sum -= matrix[j][k] * matrix[j][k];
+		}
+		if (sum <= 0.0)
+		{
+			return 0;
+		}
+		matrix[j][j] = sqrt(sum);
+		for (i = j + 1; i < n; i++)
+		{
+			sum = matrix[i][j];
+			for (k = 0; k < j; k++)
+			{
+				sum -= matrix[i][k] * matrix[j][k];
+			}
+			matrix[i][j] = sum / matrix[j][j];
+		}
+	}
+	return 1;
+}
+
+/**
+ * Solve L * L^T * x = b with the factor of dsp_linalg_cholesky(). The
+ * `vector` is b on entry and x on return.
+ */
+void dsp_linalg_cholesky_solve(int n, const double factor[][MAX_MICS],
+	double *vector)
+{
+	int i, k;
+
+	assert (n > 0 && n <= MAX_MICS);
+	assert (factor != NULL && vector != NULL);
+
+	for (i = 0; i < n; i++)
+	{
+		for (k = 0; k < i; k++)
+		{
+			vector[i] -= factor[i][k] * vector[k];
+		}
+		vector[i] /= factor[i][i];
+	}
+	for (i = n - 1; i >= 0; i--)
+	{
+		for (k = i + 1; k < n; k++)
+		{
+			vector[i] -= factor[k][i] * vector[k];
+		}
+		vector[i] /= factor[i][i];
+	}
+}
@@ -0,0 +1,179 @@
+/**
+ ******************************************************************************
+ * @file 	moments.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Single-pass statistics of the samples.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+
+/*	The central moments are accumulated with the updates of Welford and
+	Terriberry, which don't lose the small deviations of a big mean like
+	the sums of powers do. Each lane takes every DSP_MOMENTS_LANES-th
+	sample, so the lanes have no dependency between each other and the
+	compiler can run them in the vector registers. The lanes are merged
+	with the pairwise formulas of Chan and Pebay at the end. */
+
+typedef struct _DspMomentsLanes
+{
+	double count[DSP_MOMENTS_LANES];
+	double mean[DSP_MOMENTS_LANES];
+	double m2[DSP_MOMENTS_LANES];			/* sum of squared deviations */
+	double m3[DSP_MOMENTS_LANES];
+	double m4[DSP_MOMENTS_LANES];
+	double energy[DSP_MOMENTS_LANES];
+	double max[DSP_MOMENTS_LANES];
+	double min[DSP_MOMENTS_LANES];
+} DspMomentsLanes;
+
+/**
+ * Push the sample `x` into the lane `j` that has `n` samples after it.
+ */
+static inline void __moments_push(DspMomentsLanes *lanes, int j, double x,
+	double n)
+{
+	double delta, deltaN, deltaN2, term;
+
+	delta = x - lanes->mean[j];
+	deltaN = delta / n;
+	deltaN2 = deltaN * deltaN;
+	term = delta * deltaN * (n - 1.0);
+
+	lanes->mean[j] += deltaN;
+	lanes->m4[j] += term * deltaN2 * (n * n - 3.0 * n + 3.0) +
+		6.0 * deltaN2 * lanes->m2[j] - 4.0 * deltaN * lanes->m3[j];
+	lanes->m3[j] += term * deltaN * (n - 2.0) - 3.0 * deltaN * lanes->m2[j];
+	lanes->m2[j] += term;
+	lanes->energy[j] += x * x;
+	lanes->max[j] = (x > lanes->max[j]) ? x : lanes->max[j];
+	lanes->min[j] = (x < lanes->min[j]) ? x : lanes->min[j];
+	lanes->count[j] = n;
+}
+
+/**
+ * Merge the lane `j` into the lane 0.
+ */
+static void __moments_merge(DspMomentsLanes *lanes, int j)
+{
+	double na, nb, n, delta, delta2, m2, m3;
+
+	na = lanes->count[0];
+	nb = lanes->count[j];
+	if (nb == 0.0)
+	{
+		return;
+	}
+	n = na + nb;
+	delta = lanes->mean[j] - lanes->mean[0];
+	delta2 = delta * delta;
+	m2 = lanes->m2[0];
+	m3 = lanes->m3[0];
+
+	lanes->m4[0] += lanes->m4[j] + delta2 * delta2 * na * nb *
+		(na * na - na * nb + nb * nb) / (n * n * n) + 6.0 * delta2 *
+		(na * na * lanes->m2[j] + nb * nb * m2) / (n * n) + 4.0 * delta *
+		(na * lanes->m3[j] - nb * m3) / n;
+	lanes->m3[0] += lanes->m3[j] + delta2 * delta * na * nb * (na - nb) /
+		(n * n) + 3.0 * delta * (na * lanes->m2[j] - nb * m2) / n;
+	lanes->m2[0] += lanes->m2[j] + delta2 * na * nb / n;
+	lanes->mean[0] += delta * nb / n;
+	lanes->energy[0] += lanes->energy[j];
+	lanes->max[0] = (lanes->max[j] > lanes->max[0]) ?
+		lanes->max[j] : lanes->max[0];
+	lanes->min[0] = (lanes->min[j] < lanes->min[0]) ?
+		lanes->min[j] : lanes->min[0];
+	lanes->count[0] = n;
+}
+
+/**
+ * Calculate all statistics of `length` samples of `data` in one pass.
+ */
+static void __moments(const double *data, len_t length, DspMoments *result)
+{
+	int j;
+	len_t i, blocks;
+	double n, variance;
+	DspMomentsLanes lanes;
+
+	memset(&lanes, 0, sizeof(DspMomentsLanes));
+	for (j = 0; j < DSP_MOMENTS_LANES; j++)
+	{
+		lanes.max[j] = -INFINITY;
+		lanes.min[j] = INFINITY;
+	}
+
+	/* All lanes have the same count in the blocks, the rest of samples
+		goes to the first lanes. */
+	blocks = length / DSP_MOMENTS_LANES;
+	for (i = 0; i < blocks; i++)
+	{
+		n = (double) (i + 1);
+		for (j = 0; j < DSP_MOMENTS_LANES; j++)
+		{
+			__moments_push(&lanes, j, data[i * DSP_MOMENTS_LANES + j], n);
+		}
+	}
+	for (j = 0; j < (int) (length % DSP_MOMENTS_LANES); j++)
+	{
+		__moments_push(&lanes, j, data[blocks * DSP_MOMENTS_LANES + j],
+			(double) (blocks + 1));
+	}
+	for (j = 1; j < DSP_MOMENTS_LANES; j++)
+	{
+		__moments_merge(&lanes, j);
+	}
+
+	/* The variance and the standard deviation are of the population. A
+		constant signal has no shape, so its skewness and kurtosis are 0. */
+	variance = lanes.m2[0] / length;
+	result->count = length;
+	result->max = lanes.max[0];
+	result->min = lanes.min[0];
+	result->absMax = fmax(fabs(lanes.max[0]), fabs(lanes.min[0]));
+	result->mean = lanes.mean[0];
+	result->variance = variance;
+	result->stddev = sqrt(variance);
+	result->energy = lanes.energy[0];
+	result->power = lanes.energy[0] / length;
+	result->rms = sqrt(result->power);
+	result->crestFactor = (result->rms > 0.0) ?
+		result->absMax / result->rms : 0.0;
+	result->skewness = (variance > 0.0) ?
+		(lanes.m3[0] / length) / (variance * result->stddev) : 0.0;
+	result->kurtosis = (variance > 0.0) ?
+		(lanes.m4[0] / length) / (variance * variance) - 3.0 : 0.0;
+}
+
+/**
+ * Calculate the statistics of sample in one pass. They're the same of
+ * dsp_time_max() ... dsp_time_kurtosis() functions, and the kurtosis is
+ * the excess one.
+ */
+void dsp_time_moments(const DspTime *sample, DspMoments *result)
+{
+	assert_sample(sample);
+	assert (result != NULL);
+
+	__moments(sample->data, sample->length, result);
+}
+
+/**
+ * Calculate the statistics of the view in one pass.
+ */
+void dsp_view_moments(const DspTimeView *sample, DspMoments *result)
+{
+	assert_view(sample);
+	assert (result != NULL);
+
+	__moments(sample->data, sample->length, result);
+}
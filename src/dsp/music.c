@@ -0,0 +1,303 @@
+/**
+ ******************************************************************************
+ * @file 	music.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	MUSIC with the covariance and subspace tracked across frames.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+
+/*	dsp_arrival_music() builds the covariance of each frame from scratch
+	and decomposes it. The tracker keeps the covariance with exponential
+	forgetting instead, and follows the signal subspace snapshot by
+	snapshot with PAST (Projection Approximation Subspace Tracking) of
+	Yang, which costs O(mics x sources) per snapshot. The subspace drifts
+	from orthogonality slowly, so the covariance is decomposed again at
+	every `refresh` frames. The array model is the same of the library:
+
+		R = X * X^T / N,	a(theta)_m = exp(-j*2*pi*f*r*cos(theta - phi_m)/c)
+
+	and the pseudo-spectrum 1 / (a^H * En * En^H * a) is searched with the
+	cached steering vectors, where En * En^H = I - Es * Es^T of the signal
+	subspace. */
+
+/**
+ * Prepare the tracker. The `forget` is the weight of past frames in the
+ * covariance, 0 forgets them at once. The `refresh` is the number of
+ * frames between the full decompositions.
+ */
+void dsp_music_tracker_init(DspMusicTracker *tracker, double forget,
+	int refresh)
+{
+	assert (tracker != NULL);
+	assert (forget >= 0.0 && forget < 1.0 && refresh > 0);
+
+	memset(tracker, 0, sizeof(DspMusicTracker));
+	tracker->forget = forget;
+	tracker->refresh = refresh;
+}
+
+/**
+ * Forget the covariance and subspace, the next frame starts over.
+ */
+void dsp_music_tracker_reset(DspMusicTracker *tracker)
+{
+	assert (tracker != NULL);
+
+	tracker->frames = 0;
+}
+
+/**
+ * Calculate the covariance of the mics over the frame, R = X * X^T / N,
+ * into `covariance`. It's the one of MUSIC, so the beamformer can take it
+ * instead of building its own.
+ */
+void dsp_covariance(const DspArrival *arrival, double covariance[][MAX_MICS])
+{
+	int i, j;
+	len_t t, length;
+	double sum;
+
+	assert_arrival(arrival);
+	assert (covariance != NULL);
+	length = arrival->samples[0]->length;
+	for (i = 1; i < arrival->mics; i++)
+	{
+		assert (arrival->samples[i]->length == length);
+	}
+
+	for (i = 0; i < arrival->mics; i++)
+	{
+		for (j = i; j < arrival->mics; j++)
+		{
+			sum = 0.0;
+			for (t = 0; t < length; t++)
+			{
+				sum += arrival->samples[i]->data[t] *
+					arrival->samples[j]->data[t];
+			}
+			covariance[i][j] = sum / length;
+			covariance[j][i] = covariance[i][j];
+		}
+	}
+}
+
+/**
+ * Blend the covariance of frame into the tracked one.
+ */
+static void __update_covariance(DspMusicTracker *tracker,
+	const DspArrival *arrival, int cold)
+{
+	int i, j;
+	double weight, frame[MAX_MICS][MAX_MICS];
+
+	dsp_covariance(arrival, frame);
+	weight = cold ? 1.0 : 1.0 - tracker->forget;
+	for (i = 0; i < arrival->mics; i++)
+	{
+		for (j = 0; j < arrival->mics; j++)
+		{
+			tracker->covariance[i][j] = (1.0 - weight) *
+				tracker->covariance[i][j] + weight * frame[i][j];
+		}
+	}
+}
+
+/**
+ * Decompose the covariance and restart PAST from its signal subspace.
+ */
+static void __decompose(DspMusicTracker *tracker, double beta)
+{
+	int i, j, k, mics, sources;
+	double values[MAX_MICS], vectors[MAX_MICS][MAX_MICS];
+
+	mics = tracker->mics;
+	sources = tracker->sources;
+	dsp_linalg_eigen_symm(mics, (const double (*)[MAX_MICS])
+		tracker->covariance, values, vectors);
+
+	/* The biggest eigenvalues are at the end. The inverse correlation of
+		PAST is diagonal in the eigenvectors, and the correlation is summed
+		over the snapshots, so it's the covariance over (1 - beta). */
+	for (k = 0; k < sources; k++)
+	{
+		for (i = 0; i < mics; i++)
+		{
+			tracker->subspace[i][k] = vectors[i][mics - 1 - k];
+		}
+		for (j = 0; j < sources; j++)
+		{
+			tracker->inverse[k][j] = 0.0;
+		}
+		tracker->inverse[k][k] = (values[mics - 1 - k] > DSP_LINALG_EPSILON) ?
+			(1.0 - beta) / values[mics - 1 - k] : 1.0;
+	}
+}
+
+/**
+ * Track the signal subspace over the snapshots of frame with PAST.
+ */
+static void __track_subspace(DspMusicTracker *tracker,
+	const DspArrival *arrival, double beta)
+{
+	int i, j, k, mics, sources;
+	len_t t, length;
+	double x[MAX_MICS], y[MAX_SOURCES], h[MAX_SOURCES], g[MAX_SOURCES];
+	double e, norm;
+
+	mics = tracker->mics;
+	sources = tracker->sources;
+	length = arrival->samples[0]->length;
+	for (t = 0; t < length; t++)
+	{
+		for (i = 0; i < mics; i++)
+		{
+			x[i] = arrival->samples[i]->data[t];
+		}
+
+		/* y = W^T x, h = P y, g = h / (beta + y^T h) */
+		norm = beta;
+		for (k = 0; k < sources; k++)
+		{
+			y[k] = 0.0;
+			for (i = 0; i < mics; i++)
+			{
+				y[k] += tracker->subspace[i][k] * x[i];
+			}
+		}
+		for (k = 0; k < sources; k++)
+		{
+			h[k] = 0.0;
+			for (j = 0; j < sources; j++)
+			{
+				h[k] += tracker->inverse[k][j] * y[j];
+			}
+			norm += y[k] * h[k];
+		}
+		for (k = 0; k < sources; k++)
+		{
+			g[k] = h[k] / norm;
+		}
+
+		/* P = (P - g h^T) / beta, kept symmetric */
+		for (k = 0; k < sources; k++)
+		{
+			for (j = k; j < sources; j++)
+			{
+				tracker->inverse[k][j] = (tracker->inverse[k][j] -
+					g[k] * h[j]) / beta;
+				tracker->inverse[j][k] = tracker->inverse[k][j];
+			}
+		}
+
+		/* W = W + (x - W y) g^T */
+		for (i = 0; i < mics; i++)
+		{
+			e = x[i];
+			for (k = 0; k < sources; k++)
+			{
+				e -= tracker->subspace[i][k] * y[k];
+			}
+			for (k = 0; k < sources; k++)
+			{
+				tracker->subspace[i][k] += e * g[k];
+			}
+		}
+	}
+}
+
+/**
+ * Return the angle of the biggest MUSIC pseudo-spectrum in degrees.
+ */
+static double __scan(const DspMusicTracker *tracker, const DspArrival *arrival)
+{
+	int i, j, k, rank;
+	double basis[MAX_MICS][MAX_MICS], projector[MAX_MICS][MAX_MICS];
+
+	/* En * En^H = I - Q * Q^T of the orthonormal signal subspace. */
+	for (i = 0; i < tracker->mics; i++)
+	{
+		for (k = 0; k < tracker->sources; k++)
+		{
+			basis[i][k] = tracker->subspace[i][k];
+		}
+	}
+	rank = dsp_linalg_orthonormalize(tracker->mics, tracker->sources, basis);
+	for (i = 0; i < tracker->mics; i++)
+	{
+		for (j = 0; j < tracker->mics; j++)
+		{
+			projector[i][j] = (i == j) ? 1.0 : 0.0;
+			for (k = 0; k < rank; k++)
+			{
+				projector[i][j] -= basis[i][k] * basis[j][k];
+			}
+		}
+	}
+	return dsp_steering_search(arrival, (const double (*)[MAX_MICS]) projector);
+}
+
+/**
+ * Calculate the arrival of angle like dsp_arrival_music(), with the
+ * covariance and subspace of the previous frames. The array geometry and
+ * the number of sources must stay the same, otherwise the tracker starts
+ * over.
+ */
+int dsp_arrival_music_track(DspMusicTracker *tracker,
+	const DspArrival *arrival)
+{
+	int i, cold;
+	double beta;
+
+	assert (tracker != NULL && tracker->refresh > 0);
+	assert_arrival(arrival);
+	assert (arrival->sources < arrival->mics);
+	for (i = 1; i < arrival->mics; i++)
+	{
+		assert (arrival->samples[i]->length == arrival->samples[0]->length);
+	}
+
+	if (tracker->mics != arrival->mics || tracker->sources != arrival->sources)
+	{
+		tracker->mics = arrival->mics;
+		tracker->sources = arrival->sources;
+		tracker->frames = 0;
+	}
+	cold = (tracker->frames == 0);
+
+	/* The forgetting of a frame is spread over its snapshots for PAST. */
+	beta = pow(tracker->forget, 1.0 / arrival->samples[0]->length);
+	if (beta <= 0.0)
+	{
+		beta = DSP_MUSIC_MIN_BETA;
+	}
+
+	__update_covariance(tracker, arrival, cold);
+	if (cold || tracker->frames >= tracker->refresh)
+	{
+		__decompose(tracker, beta);
+		tracker->frames = 0;
+		tracker->decompositions++;
+	}
+	else
+	{
+		__track_subspace(tracker, arrival, beta);
+	}
+	tracker->frames++;
+
+	/* The refined bearing is kept, the whole degrees are returned like the
+		library. */
+	tracker->bearing = __scan(tracker, arrival);
+
+	return (int) lround(tracker->bearing) % 360;
+}
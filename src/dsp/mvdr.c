@@ -0,0 +1,173 @@
+/**
+ ******************************************************************************
+ * @file 	mvdr.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	MVDR (Capon) beamformer on a shared covariance.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+#include <complex.h>
+
+/*	The MVDR beam passes the look direction without distortion and takes
+	the least power from the others
+
+		w = R^-1 * a / (a^H * R^-1 * a)
+
+	where a is the response of the array, a plane wave from theta reaches
+	the mic m earlier by r / c * cos(theta - phi_m), so its phase leads.
+	The covariance is the real one of MUSIC, R = X * X^T / N, so a frame
+	builds it once for both, or the tracker lends its own. It's loaded on
+	the diagonal and factored once with Cholesky, and each steering vector
+	costs two triangular solves of its real and imaginary parts instead of
+	an inverse. The weights are taken at every bin of the frame, so the
+	beam is distortionless over the whole band. The loading keeps the
+	factor well-conditioned when a few snapshots or a loud source make R
+	nearly singular, it widens the nulls for a steering that's a bit off. */
+
+/**
+ * Load the `covariance` of `mics` on the diagonal by `loading` times its
+ * mean power and factor it for the weights. Return 0 if it isn't positive
+ * definite, a silent frame without loading for one.
+ */
+int dsp_mvdr_init(DspMvdr *mvdr, int mics, const double covariance[][MAX_MICS],
+	double loading)
+{
+	int i, j;
+	double trace = 0.0;
+
+	assert (mvdr != NULL && covariance != NULL);
+	assert (mics > 1 && mics <= MAX_MICS && loading >= 0.0);
+
+	mvdr->mics = mics;
+	mvdr->loading = loading;
+	for (i = 0; i < mics; i++)
+	{
+		trace += covariance[i][i];
+	}
+	for (i = 0; i < mics; i++)
+	{
+		for (j = 0; j < mics; j++)
+		{
+			mvdr->factor[i][j] = covariance[i][j];
+		}
+		mvdr->factor[i][i] += loading * trace / mics;
+	}
+	return dsp_linalg_cholesky(mics, mvdr->factor);
+}
+
+/**
+ * Calculate the MVDR weights of the look direction `theta` in degrees at
+ * `freq` Hz into `weights`, for the mics on the circle of `radius`.
+ */
+void dsp_mvdr_weights(const DspMvdr *mvdr, double radius, double freq,
+	double theta, double (*weights)[2])
+{
+	int i;
+	double phase, gain;
+	double real[MAX_MICS], imag[MAX_MICS];
+
+	assert (mvdr != NULL && mvdr->mics > 1);
+	assert (radius > 0.0 && freq >= 0.0 && weights != NULL);
+
+	for (i = 0; i < mvdr->mics; i++)
+	{
+		phase = 2.0 * M_PI * freq * radius / SOUND_SPEED *
+			cos(theta * M_PI / 180.0 - 2.0 * M_PI * i / mvdr->mics);
+		real[i] = weights[i][0] = cos(phase);
+		imag[i] = weights[i][1] = sin(phase);
+	}
+	dsp_linalg_cholesky_solve(mvdr->mics, mvdr->factor, real);
+	dsp_linalg_cholesky_solve(mvdr->mics, mvdr->factor, imag);
+
+	/* a^H * R^-1 * a is real and positive for the real R. */
+	gain = 0.0;
+	for (i = 0; i < mvdr->mics; i++)
+	{
+		gain += weights[i][0] * real[i] + weights[i][1] * imag[i];
+	}
+	for (i = 0; i < mvdr->mics; i++)
+	{
+		weights[i][0] = real[i] / gain;
+		weights[i][1] = imag[i] / gain;
+	}
+}
+
+/**
+ * Make the MVDR beamforming of the mics toward `theta` of beamform with
+ * the factored covariance of `mvdr`. The output has unit gain in the look
+ * direction, the delay-and-sum of library sums the mics instead. The
+ * `fs` is the sample frequency of the mics. The `freq` of beamform is not
+ * used, each bin has its own weights. The spectrums are taken from the
+ * `arena`.
+ */
+void dsp_beamform_capon(const DspBeamform *beamform, const DspMvdr *mvdr,
+	double fs, DspTime *result, DspArena *arena)
+{
+	int i;
+	len_t k, length;
+	size_t mark;
+	double weights[MAX_MICS][2];
+	DspTimeView samples[MAX_MICS];
+	DspFreqView spectrums[MAX_MICS];
+	const DspFFTPlan *plan;
+	double complex *beam, *output, bin;
+
+	assert_beamform(beamform);
+	assert (beamform->radius > 0.0 && fs > 0.0);
+	assert (mvdr != NULL && mvdr->mics == beamform->mics);
+	assert (result != NULL);
+	assert_arena(arena);
+	length = beamform->samples[0]->length;
+	for (i = 1; i < beamform->mics; i++)
+	{
+		assert (beamform->samples[i]->length == length);
+	}
+
+	mark = dsp_arena_mark(arena);
+	for (i = 0; i < beamform->mics; i++)
+	{
+		samples[i] = dsp_time_view_of(beamform->samples[i]);
+		spectrums[i] = dsp_freq_view_new(arena, length / 2 + 1);
+	}
+	dsp_view_rfft_batch(samples, beamform->mics, spectrums, arena);
+
+	/* Y(k) = w(f_k)^H * X(k), the other half is its conjugate. */
+	plan = dsp_fft_plan(length);
+	beam = dsp_arena_alloc(arena, length * sizeof(double complex));
+	output = dsp_arena_alloc(arena, length * sizeof(double complex));
+	for (k = 0; k <= length / 2; k++)
+	{
+		dsp_mvdr_weights(mvdr, beamform->radius,
+			fs * k / length, beamform->theta, weights);
+		bin = 0.0;
+		for (i = 0; i < beamform->mics; i++)
+		{
+			bin += (weights[i][0] - I * weights[i][1]) *
+				(spectrums[i].data[k][0] + I * spectrums[i].data[k][1]);
+		}
+		beam[k] = bin;
+		if (k > 0 && k < length - k)
+		{
+			beam[length - k] = conj(bin);
+		}
+	}
+	dsp_fft_complex(plan, (const double (*)[2]) beam,
+		(double (*)[2]) output, 1);
+
+	for (k = 0; k < length; k++)
+	{
+		result->data[k] = creal(output[k]) / length;
+	}
+	result->length = length;
+	dsp_arena_rewind(arena, mark);
+}
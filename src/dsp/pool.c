@@ -0,0 +1,153 @@
+/**
+ ******************************************************************************
+ * @file 	pool.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Persistent thread pool for the parallel loops of DSP methods.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+
+/*	The workers are started once and sleep between the loops, so a loop
+	of a frame doesn't pay for the thread creation. The caller takes the
+	indexes too, so a pool of no workers runs the loop serially. */
+
+/**
+ * Take the indexes of current loop until there is no more.
+ */
+static void __pool_drain(DspPool *pool)
+{
+	int index;
+
+	while ((index = atomic_fetch_add(&pool->next, 1)) < pool->count)
+	{
+		pool->task(pool->arg, index);
+	}
+}
+
+/**
+ * Run the loops of the pool until it's freed.
+ */
+static void *__pool_worker(void *arg)
+{
+	DspPool *pool = arg;
+	unsigned long seen = 0;
+
+	pthread_mutex_lock(&pool->mutex);
+	for (;;)
+	{
+		while (!pool->stop && pool->generation == seen)
+		{
+			pthread_cond_wait(&pool->start, &pool->mutex);
+		}
+		if (pool->stop)
+		{
+			break;
+		}
+		seen = pool->generation;
+		pthread_mutex_unlock(&pool->mutex);
+
+		__pool_drain(pool);
+
+		pthread_mutex_lock(&pool->mutex);
+		if (--pool->active == 0)
+		{
+			pthread_cond_signal(&pool->done);
+		}
+	}
+	pthread_mutex_unlock(&pool->mutex);
+
+	return NULL;
+}
+
+/**
+ * Start the `workers` threads of the pool besides the caller.
+ */
+void dsp_pool_init(DspPool *pool, int workers)
+{
+	int i;
+
+	assert (pool != NULL);
+	assert (workers >= 0 && workers <= DSP_POOL_MAX_WORKERS);
+
+	memset(pool, 0, sizeof(DspPool));
+	pthread_mutex_init(&pool->mutex, NULL);
+	pthread_cond_init(&pool->start, NULL);
+	pthread_cond_init(&pool->done, NULL);
+	for (i = 0; i < workers; i++)
+	{
+		if (pthread_create(&pool->threads[i], NULL, __pool_worker, pool) != 0)
+		{
+			break;		/* run with the started ones */
+		}
+	}
+	pool->workers = i;
+}
+
+/**
+ * Call the `task` for each index of [0, `count`) on the pool and wait for
+ * all of them. The order of indexes is unspecified.
+ */
+void dsp_pool_run(DspPool *pool, DspPoolTask task, void *arg, int count)
+{
+	assert (pool != NULL && task != NULL && count >= 0);
+
+	pthread_mutex_lock(&pool->mutex);
+	pool->task = task;
+	pool->arg = arg;
+	pool->count = count;
+	atomic_store(&pool->next, 0);
+	pool->active = pool->workers;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->start);
+	pthread_mutex_unlock(&pool->mutex);
+
+	__pool_drain(pool);
+
+	pthread_mutex_lock(&pool->mutex);
+	while (pool->active > 0)
+	{
+		pthread_cond_wait(&pool->done, &pool->mutex);
+	}
+	pthread_mutex_unlock(&pool->mutex);
+}
+
+/**
+ * Return the number of threads that run the loops, the caller included.
+ */
+int dsp_pool_size(const DspPool *pool)
+{
+	return (pool != NULL) ? pool->workers + 1 : 1;
+}
+
+/**
+ * Stop and join the workers of the pool.
+ */
+void dsp_pool_free(DspPool *pool)
+{
+	int i;
+
+	assert (pool != NULL);
+
+	pthread_mutex_lock(&pool->mutex);
+	pool->stop = 1;
+	pthread_cond_broadcast(&pool->start);
+	pthread_mutex_unlock(&pool->mutex);
+
+	for (i = 0; i < pool->workers; i++)
+	{
+		pthread_join(pool->threads[i], NULL);
+	}
+	pthread_mutex_destroy(&pool->mutex);
+	pthread_cond_destroy(&pool->start);
+	pthread_cond_destroy(&pool->done);
+}
@@ -0,0 +1,130 @@
+/**
+ ******************************************************************************
+ * @file 	scan.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Steered power map of the circular array in frequency domain.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+#include <complex.h>
+
+/*	The delay-and-sum beam of each look direction is a phase shift of the
+	mic spectrums, so the beams of all directions at a bin are a single
+	matrix product of the steering (angles x mics) and the bin of mics,
+	and the map is the power of beams summed over the band
+
+		P(theta) = sum_k | sum_m X_m(k) * a_m(theta, f_k) |^2
+
+	The phases are linear in the bin, a_m(theta, f_k+1) = a_m(theta, f_k) *
+	a_m(theta, df), so the steering of the next bin is one multiplication
+	away and only the first bin and the step take the sine and cosine. The
+	recurrence drifts by the rounding of a few hundred products, which is
+	far below the width of a beam. */
+
+/**
+ * Calculate the steered response power of `angles` look directions evenly
+ * spaced from 0 degrees, into `power`, from the bins of [`low`, `high`] Hz.
+ * The `fs` is the sample frequency of the mics. The spectrums are taken
+ * from the `arena`. The `freq` and `sources` of arrival are not used.
+ * Return the index of the loudest direction.
+ */
+int dsp_beam_scan(const DspArrival *arrival, double fs, double low,
+	double high, int angles, double *power, DspArena *arena)
+{
+	int i, a, best;
+	len_t k, first, last, length;
+	size_t mark;
+	double theta, scale, delay;
+	DspTimeView samples[MAX_MICS];
+	DspFreqView spectrums[MAX_MICS];
+	double complex *steering, *step, *bins, beam;
+
+	assert_arrival(arrival);
+	assert (arrival->mics > 1 && arrival->radius > 0.0 && fs > 0.0);
+	assert (low >= 0.0 && low <= high);
+	assert (angles > 0 && power != NULL);
+	assert_arena(arena);
+	length = arrival->samples[0]->length;
+	for (i = 1; i < arrival->mics; i++)
+	{
+		assert (arrival->samples[i]->length == length);
+	}
+
+	for (a = 0; a < angles; a++)
+	{
+		power[a] = 0.0;
+	}
+
+	/* The band is clipped to the bins above DC and below Nyquist. */
+	first = (len_t) ceil(low * length / fs);
+	last = (len_t) floor(high * length / fs) + 1;
+	first = (first < 1) ? 1 : first;
+	last = (last > length / 2) ? length / 2 : last;
+	if (last <= first)
+	{
+		return 0;
+	}
+
+	mark = dsp_arena_mark(arena);
+	for (i = 0; i < arrival->mics; i++)
+	{
+		samples[i] = dsp_time_view_of(arrival->samples[i]);
+		spectrums[i] = dsp_freq_view_new(arena, length / 2 + 1);
+	}
+	dsp_view_rfft_batch(samples, arrival->mics, spectrums, arena);
+
+	/* The steering of the first bin and its step to the next bin. */
+	steering = dsp_arena_alloc(arena,
+		angles * arrival->mics * sizeof(double complex));
+	step = dsp_arena_alloc(arena,
+		angles * arrival->mics * sizeof(double complex));
+	bins = dsp_arena_alloc(arena, arrival->mics * sizeof(double complex));
+	scale = 2.0 * M_PI * fs / length;
+	for (a = 0; a < angles; a++)
+	{
+		theta = 2.0 * M_PI * a / angles;
+		for (i = 0; i < arrival->mics; i++)
+		{
+			delay = arrival->radius / SOUND_SPEED *
+				cos(theta - 2.0 * M_PI * i / arrival->mics);
+			steering[a * arrival->mics + i] = cexp(-I * scale * first * delay);
+			step[a * arrival->mics + i] = cexp(-I * scale * delay);
+		}
+	}
+
+	for (k = first; k < last; k++)
+	{
+		for (i = 0; i < arrival->mics; i++)
+		{
+			bins[i] = spectrums[i].data[k][0] + I * spectrums[i].data[k][1];
+		}
+		for (a = 0; a < angles; a++)
+		{
+			beam = 0.0;
+			for (i = 0; i < arrival->mics; i++)
+			{
+				beam += steering[a * arrival->mics + i] * bins[i];
+				steering[a * arrival->mics + i] *= step[a * arrival->mics + i];
+			}
+			power[a] += creal(beam) * creal(beam) + cimag(beam) * cimag(beam);
+		}
+	}
+	dsp_arena_rewind(arena, mark);
+
+	best = 0;
+	for (a = 1; a < angles; a++)
+	{
+		best = (power[a] > power[best]) ? a : best;
+	}
+	return best;
+}
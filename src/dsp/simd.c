@@ -0,0 +1,680 @@
+/**
+ ******************************************************************************
+ * @file 	simd.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Elementwise methods with the runtime-dispatched SIMD kernels.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DSP_SIMD_X86
+#endif
+
+/*	Each kernel has a scalar reference and SSE2, AVX2 and AVX-512 versions
+	that are compiled with their own target attributes. So the binary is
+	built for the baseline instruction set, and the widest kernels that the
+	CPU supports are selected with CPUID at the first call. The vector
+	loops leave the rest of samples to the scalar reference. */
+
+typedef struct _DspSimdOps
+{
+	DspSimdLevel level;
+	void (*add)(const double *, const double *, double *, len_t);
+	void (*mul)(const double *, const double *, double *, len_t);
+	void (*scalarMul)(const double *, double, double *, len_t);
+	void (*abs)(const double *, double *, len_t);
+	void (*clip)(const double *, double, double, double *, len_t);
+	double (*absMax)(const double *, len_t);
+	void (*magnitude)(const double (*)[2], double *, len_t);
+} DspSimdOps;
+
+/* Scalar Reference Kernels */
+
+static void __add_scalar(const double *a, const double *b, double *out,
+	len_t n)
+{
+	len_t i;
+
+	for (i = 0; i < n; i++)
+	{
+		out[i] = a[i] + b[i];
+	}
+}
+
+static void __mul_scalar(const double *a, const double *b, double *out,
+	len_t n)
+{
+	len_t i;
+
+	for (i = 0; i < n; i++)
+	{
+		out[i] = a[i] * b[i];
+	}
+}
+
+static void __scalar_mul_scalar(const double *a, double k, double *out,
+	len_t n)
+{
+	len_t i;
+
+	for (i = 0; i < n; i++)
+	{
+		out[i] = a[i] * k;
+	}
+}
+
+static void __abs_scalar(const double *a, double *out, len_t n)
+{
+	len_t i;
+
+	for (i = 0; i < n; i++)
+	{
+		out[i] = fabs(a[i]);
+	}
+}
+
+static void __clip_scalar(const double *a, double lo, double hi,
+	double *out, len_t n)
+{
+	len_t i;
+
+	for (i = 0; i < n; i++)
+	{
+		out[i] = (a[i] > hi) ? hi : (a[i] < lo) ? lo : a[i];
+	}
+}
+
+static double __abs_max_scalar(const double *a, len_t n)
+{
+	len_t i;
+	double max = 0.0;
+
+	for (i = 0; i < n; i++)
+	{
+		max = (fabs(a[i]) > max) ? fabs(a[i]) : max;
+	}
+	return max;
+}
+
+static void __magnitude_scalar(const double (*a)[2], double *out, len_t n)
+{
+	len_t i;
+
+	for (i = 0; i < n; i++)
+	{
+		out[i] = sqrt(a[i][0] * a[i][0] + a[i][1] * a[i][1]);
+	}
+}
+
+static const DspSimdOps simdScalar = {
+	DSP_SIMD_SCALAR, __add_scalar, __mul_scalar, __scalar_mul_scalar,
+	__abs_scalar, __clip_scalar, __abs_max_scalar, __magnitude_scalar
+};
+
+#ifdef DSP_SIMD_X86
+
+/* SSE2 Kernels, 2 doubles per register */
+
+#define SSE2 __attribute__((target("sse2")))
+
+SSE2 static void __add_sse2(const double *a, const double *b, double *out,
+	len_t n)
+{
+	len_t i;
+
+	for (i = 0; i + 2 <= n; i += 2)
+	{
+		_mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(a + i),
+			_mm_loadu_pd(b + i)));
+	}
+	__add_scalar(a + i, b + i, out + i, n - i);
+}
+
+SSE2 static void __mul_sse2(const double *a, const double *b, double *out,
+	len_t n)
+{
+	len_t i;
+
+	for (i = 0; i + 2 <= n; i += 2)
+	{
+		_mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(a + i),
+			_mm_loadu_pd(b + i)));
+	}
+	__mul_scalar(a + i, b + i, out + i, n - i);
+}
+
+SSE2 static void __scalar_mul_sse2(const double *a, double k, double *out,
+	len_t n)
+{
+	len_t i;
+	__m128d vk = _mm_set1_pd(k);
+
+	for (i = 0; i + 2 <= n; i += 2)
+	{
+		_mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(a + i), vk));
+	}
+	__scalar_mul_scalar(a + i, k, out + i, n - i);
+}
+
+SSE2 static void __abs_sse2(const double *a, double *out, len_t n)
+{
+	len_t i;
+	__m128d sign = _mm_set1_pd(-0.0);
+
+	for (i = 0; i + 2 <= n; i += 2)
+	{
+		_mm_storeu_pd(out + i, _mm_andnot_pd(sign, _mm_loadu_pd(a + i)));
+	}
+	__abs_scalar(a + i, out + i, n - i);
+}
+
+SSE2 static void __clip_sse2(const double *a, double lo, double hi,
+	double *out, len_t n)
+{
+	len_t i;
+	__m128d vlo = _mm_set1_pd(lo), vhi = _mm_set1_pd(hi);
+
+	for (i = 0; i + 2 <= n; i += 2)
+	{
+		_mm_storeu_pd(out + i, _mm_max_pd(_mm_min_pd(_mm_loadu_pd(a + i),
+			vhi), vlo));
+	}
+	__clip_scalar(a + i, lo, hi, out + i, n - i);
+}
+
+SSE2 static double __abs_max_sse2(const double *a, len_t n)
+{
+	len_t i;
+	double lanes[2], max;
+	__m128d sign = _mm_set1_pd(-0.0), vmax = _mm_setzero_pd();
+
+	for (i = 0; i + 2 <= n; i += 2)
+	{
+		vmax = _mm_max_pd(vmax, _mm_andnot_pd(sign, _mm_loadu_pd(a + i)));
+	}
+	_mm_storeu_pd(lanes, vmax);
+	max = fmax(lanes[0], lanes[1]);
+
+	return fmax(max, __abs_max_scalar(a + i, n - i));
+}
+
+SSE2 static void __magnitude_sse2(const double (*a)[2], double *out,
+	len_t n)
+{
+	len_t i;
+	__m128d c0, c1;
+
+	for (i = 0; i + 2 <= n; i += 2)
+	{
+		c0 = _mm_loadu_pd(a[i]);
+		c1 = _mm_loadu_pd(a[i + 1]);
+		c0 = _mm_mul_pd(c0, c0);
+		c1 = _mm_mul_pd(c1, c1);
+		_mm_storeu_pd(out + i, _mm_sqrt_pd(_mm_add_pd(
+			_mm_unpacklo_pd(c0, c1), _mm_unpackhi_pd(c0, c1))));
+	}
+	__magnitude_scalar(a + i, out + i, n - i);
+}
+
+static const DspSimdOps simdSse2 = {
+	DSP_SIMD_SSE2, __add_sse2, __mul_sse2, __scalar_mul_sse2,
+	__abs_sse2, __clip_sse2, __abs_max_sse2, __magnitude_sse2
+};
+
+/* AVX2 Kernels, 4 doubles per register */
+
+#define AVX2 __attribute__((target("avx2")))
+
+AVX2 static void __add_avx2(const double *a, const double *b, double *out,
+	len_t n)
+{
+	len_t i;
+
+	for (i = 0; i + 4 <= n; i += 4)
+	{
+		_mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(a + i),
+			_mm256_loadu_pd(b + i)));
+	}
+	__add_scalar(a + i, b + i, out + i, n - i);
+}
+
+AVX2 static void __mul_avx2(const double *a, const double *b, double *out,
+	len_t n)
+{
+	len_t i;
+
+	for (i = 0; i + 4 <= n; i += 4)
+	{
+		_mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(a + i),
+			_mm256_loadu_pd(b + i)));
+	}
+	__mul_scalar(a + i, b + i, out + i, n - i);
+}
+
+AVX2 static void __scalar_mul_avx2(const double *a, double k, double *out,
+	len_t n)
+{
+	len_t i;
+	__m256d vk = _mm256_set1_pd(k);
+
+	for (i = 0; i + 4 <= n; i += 4)
+	{
+		_mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), vk));
+	}
+	__scalar_mul_scalar(a + i, k, out + i, n - i);
+}
+
+AVX2 static void __abs_avx2(const double *a, double *out, len_t n)
+{
+	len_t i;
+	__m256d sign = _mm256_set1_pd(-0.0);
+
+	for (i = 0; i + 4 <= n; i += 4)
+	{
+		_mm256_storeu_pd(out + i, _mm256_andnot_pd(sign,
+			_mm256_loadu_pd(a + i)));
+	}
+	__abs_scalar(a + i, out + i, n - i);
+}
+
+AVX2 static void __clip_avx2(const double *a, double lo, double hi,
+	double *out, len_t n)
+{
+	len_t i;
+	__m256d vlo = _mm256_set1_pd(lo), vhi = _mm256_set1_pd(hi);
+
+	for (i = 0; i + 4 <= n; i += 4)
+	{
+		_mm256_storeu_pd(out + i, _mm256_max_pd(_mm256_min_pd(
+			_mm256_loadu_pd(a + i), vhi), vlo));
+	}
+	__clip_scalar(a + i, lo, hi, out + i, n - i);
+}
+
+AVX2 static double __abs_max_avx2(const double *a, len_t n)
+{
+	len_t i;
+	double lanes[4], max;
+	__m256d sign = _mm256_set1_pd(-0.0), vmax = _mm256_setzero_pd();
+
+	for (i = 0; i + 4 <= n; i += 4)
+	{
+		vmax = _mm256_max_pd(vmax, _mm256_andnot_pd(sign,
+			_mm256_loadu_pd(a + i)));
+	}
+	_mm256_storeu_pd(lanes, vmax);
+	max = fmax(fmax(lanes[0], lanes[1]), fmax(lanes[2], lanes[3]));
+
+	return fmax(max, __abs_max_scalar(a + i, n - i));
+}
+
+AVX2 static void __magnitude_avx2(const double (*a)[2], double *out,
+	len_t n)
+{
+	len_t i;
+	__m256d c0, c1, sum;
+
+	for (i = 0; i + 4 <= n; i += 4)
+	{
+		c0 = _mm256_loadu_pd(a[i]);
+		c1 = _mm256_loadu_pd(a[i + 2]);
+		c0 = _mm256_mul_pd(c0, c0);
+		c1 = _mm256_mul_pd(c1, c1);
+
+		/* The sums come in the order of 0, 2, 1, 3. */
+		sum = _mm256_hadd_pd(c0, c1);
+		_mm256_storeu_pd(out + i, _mm256_sqrt_pd(
+			_mm256_permute4x64_pd(sum, _MM_SHUFFLE(3, 1, 2, 0))));
+	}
+	__magnitude_scalar(a + i, out + i, n - i);
+}
+
+static const DspSimdOps simdAvx2 = {
+	DSP_SIMD_AVX2, __add_avx2, __mul_avx2, __scalar_mul_avx2,
+	__abs_avx2, __clip_avx2, __abs_max_avx2, __magnitude_avx2
+};
+
+/* AVX-512 Kernels, 8 doubles per register */
+
+#define AVX512 __attribute__((target("avx512f")))
+
+AVX512 static void __add_avx512(const double *a, const double *b,
+	double *out, len_t n)
+{
+	len_t i;
+
+	for (i = 0; i + 8 <= n; i += 8)
+	{
+		_mm512_storeu_pd(out + i, _mm512_add_pd(_mm512_loadu_pd(a + i),
+			_mm512_loadu_pd(b + i)));
+	}
+	__add_scalar(a + i, b + i, out + i, n - i);
+}
+
+AVX512 static void __mul_avx512(const double *a, const double *b,
+	double *out, len_t n)
+{
+	len_t i;
+
+	for (i = 0; i + 8 <= n; i += 8)
+	{
+		_mm512_storeu_pd(out + i, _mm512_mul_pd(_mm512_loadu_pd(a + i),
+			_mm512_loadu_pd(b + i)));
+	}
+	__mul_scalar(a + i, b + i, out + i, n - i);
+}
+
+AVX512 static void __scalar_mul_avx512(const double *a, double k,
+	double *out, len_t n)
+{
+	len_t i;
+	__m512d vk = _mm512_set1_pd(k);
+
+	for (i = 0; i + 8 <= n; i += 8)
+	{
+		_mm512_storeu_pd(out + i, _mm512_mul_pd(_mm512_loadu_pd(a + i), vk));
+	}
+	__scalar_mul_scalar(a + i, k, out + i, n - i);
+}
+
+AVX512 static void __abs_avx512(const double *a, double *out, len_t n)
+{
+	len_t i;
+
+	for (i = 0; i + 8 <= n; i += 8)
+	{
+		_mm512_storeu_pd(out + i, _mm512_abs_pd(_mm512_loadu_pd(a + i)));
+	}
+	__abs_scalar(a + i, out + i, n - i);
+}
+
+AVX512 static void __clip_avx512(const double *a, double lo, double hi,
+	double *out, len_t n)
+{
+	len_t i;
+	__m512d vlo = _mm512_set1_pd(lo), vhi = _mm512_set1_pd(hi);
+
+	for (i = 0; i + 8 <= n; i += 8)
+	{
+		_mm512_storeu_pd(out + i, _mm512_max_pd(_mm512_min_pd(
+			_mm512_loadu_pd(a + i), vhi), vlo));
+	}
+	__clip_scalar(a + i, lo, hi, out + i, n - i);
+}
+
+AVX512 static double __abs_max_avx512(const double *a, len_t n)
+{
+	len_t i;
+	double max;
+	__m512d vmax = _mm512_setzero_pd();
+
+	for (i = 0; i + 8 <= n; i += 8)
+	{
+		vmax = _mm512_max_pd(vmax, _mm512_abs_pd(_mm512_loadu_pd(a + i)));
+	}
+	max = _mm512_reduce_max_pd(vmax);
+
+	return fmax(max, __abs_max_scalar(a + i, n - i));
+}
+
+AVX512 static void __magnitude_avx512(const double (*a)[2], double *out,
+	len_t n)
+{
+	len_t i;
+	__m512d c0, c1;
+	const __m512i real = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+	const __m512i imag = _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+
+	for (i = 0; i + 8 <= n; i += 8)
+	{
+		c0 = _mm512_loadu_pd(a[i]);
+		c1 = _mm512_loadu_pd(a[i + 4]);
+		c0 = _mm512_mul_pd(c0, c0);
+		c1 = _mm512_mul_pd(c1, c1);
+		_mm512_storeu_pd(out + i, _mm512_sqrt_pd(_mm512_add_pd(
+			_mm512_permutex2var_pd(c0, real, c1),
+			_mm512_permutex2var_pd(c0, imag, c1))));
+	}
+	__magnitude_scalar(a + i, out + i, n - i);
+}
+
+static const DspSimdOps simdAvx512 = {
+	DSP_SIMD_AVX512, __add_avx512, __mul_avx512, __scalar_mul_avx512,
+	__abs_avx512, __clip_avx512, __abs_max_avx512, __magnitude_avx512
+};
+
+#endif /* DSP_SIMD_X86 */
+
+/* The kernels are selected once and then shared by the threads. */
+
+static _Atomic(const DspSimdOps *) simdOps = NULL;
+static pthread_once_t simdOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * Return the kernels of given level.
+ */
+static const DspSimdOps *__simd_ops(DspSimdLevel level)
+{
+	switch (level)
+	{
+#ifdef DSP_SIMD_X86
+		case DSP_SIMD_AVX512: return &simdAvx512;
+		case DSP_SIMD_AVX2: return &simdAvx2;
+		case DSP_SIMD_SSE2: return &simdSse2;
+#endif
+		default: return &simdScalar;
+	}
+}
+
+/**
+ * Select the widest kernels of the CPU.
+ */
+static void __simd_init(void)
+{
+	atomic_store(&simdOps, __simd_ops(dsp_simd_detect()));
+}
+
+/**
+ * Return the selected kernels.
+ */
+static const DspSimdOps *__simd(void)
+{
+	pthread_once(&simdOnce, __simd_init);
+
+	return atomic_load(&simdOps);
+}
+
+/**
+ * Return the widest instruction set that the CPU and OS support.
+ */
+DspSimdLevel dsp_simd_detect(void)
+{
+#ifdef DSP_SIMD_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+	{
+		return DSP_SIMD_AVX512;
+	}
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return DSP_SIMD_AVX2;
+	}
+	if (__builtin_cpu_supports("sse2"))
+	{
+		return DSP_SIMD_SSE2;
+	}
+#endif
+	return DSP_SIMD_SCALAR;
+}
+
+/**
+ * Return the instruction set of the selected kernels.
+ */
+DspSimdLevel dsp_simd_level(void)
+{
+	return __simd()->level;
+}
+
+/**
+ * Select the kernels of `level` such as the scalar reference for a
+ * benchmark. It's capped at the level of CPU, which is returned.
+ */
+DspSimdLevel dsp_simd_select(DspSimdLevel level)
+{
+	DspSimdLevel best;
+
+	assert (level >= DSP_SIMD_SCALAR && level <= DSP_SIMD_AVX512);
+
+	pthread_once(&simdOnce, __simd_init);
+	best = dsp_simd_detect();
+	if (level > best)
+	{
+		level = best;
+	}
+	atomic_store(&simdOps, __simd_ops(level));
+
+	return level;
+}
+
+/**
+ * Return the name of the instruction set.
+ */
+const char *dsp_simd_name(DspSimdLevel level)
+{
+	switch (level)
+	{
+		case DSP_SIMD_SSE2: return "SSE2";
+		case DSP_SIMD_AVX2: return "AVX2";
+		case DSP_SIMD_AVX512: return "AVX-512";
+		default: return "scalar";
+	}
+}
+
+/**
+ * Add two views sample by sample.
+ */
+void dsp_view_add(const DspTimeView *fsample, const DspTimeView *ssample,
+	DspTimeView *result)
+{
+	assert_view(fsample);
+	assert_view(ssample);
+	assert (fsample->length == ssample->length);
+	assert (result != NULL && result->capacity >= fsample->length);
+
+	__simd()->add(fsample->data, ssample->data, result->data,
+		fsample->length);
+	result->length = fsample->length;
+}
+
+/**
+ * Multiply two views sample by sample.
+ */
+void dsp_view_dot_mul(const DspTimeView *fsample, const DspTimeView *ssample,
+	DspTimeView *result)
+{
+	assert_view(fsample);
+	assert_view(ssample);
+	assert (fsample->length == ssample->length);
+	assert (result != NULL && result->capacity >= fsample->length);
+
+	__simd()->mul(fsample->data, ssample->data, result->data,
+		fsample->length);
+	result->length = fsample->length;
+}
+
+/**
+ * Multiply the view by the `scalar`.
+ */
+void dsp_view_scalar_mul(const DspTimeView *sample, double scalar,
+	DspTimeView *result)
+{
+	assert_view(sample);
+	assert (result != NULL && result->capacity >= sample->length);
+
+	__simd()->scalarMul(sample->data, scalar, result->data, sample->length);
+	result->length = sample->length;
+}
+
+/**
+ * Scale the view so that its maximum absolute value is `scale`.
+ */
+void dsp_view_scale(const DspTimeView *sample, double scale,
+	DspTimeView *result)
+{
+	double max;
+
+	assert_view(sample);
+	assert (result != NULL && result->capacity >= sample->length);
+
+	max = __simd()->absMax(sample->data, sample->length);
+	__simd()->scalarMul(sample->data, (max > 0.0) ? scale / max : 0.0,
+		result->data, sample->length);
+	result->length = sample->length;
+}
+
+/**
+ * Take the absolute values of the view.
+ */
+void dsp_view_abs(const DspTimeView *sample, DspTimeView *result)
+{
+	assert_view(sample);
+	assert (result != NULL && result->capacity >= sample->length);
+
+	__simd()->abs(sample->data, result->data, sample->length);
+	result->length = sample->length;
+}
+
+/**
+ * Clip the view into [`min`, `max`].
+ */
+void dsp_view_clip(const DspTimeView *sample, double min, double max,
+	DspTimeView *result)
+{
+	assert_view(sample);
+	assert (min <= max);
+	assert (result != NULL && result->capacity >= sample->length);
+
+	__simd()->clip(sample->data, min, max, result->data, sample->length);
+	result->length = sample->length;
+}
+
+/**
+ * Apply the window coefficients of the same length to the view.
+ */
+void dsp_view_window(const DspTimeView *sample, const double *window,
+	DspTimeView *result)
+{
+	assert_view(sample);
+	assert (window != NULL);
+	assert (result != NULL && result->capacity >= sample->length);
+
+	__simd()->mul(sample->data, window, result->data, sample->length);
+	result->length = sample->length;
+}
+
+/**
+ * Calculate the magnitudes of the bins.
+ */
+void dsp_view_magnitude(const DspFreqView *sample, DspTimeView *result)
+{
+	assert_view(sample);
+	assert (result != NULL && result->capacity >= sample->length);
+
+	__simd()->magnitude((const double (*)[2]) sample->data, result->data,
+		sample->length);
+	result->length = sample->length;
+}
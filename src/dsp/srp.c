@@ -0,0 +1,207 @@
+/**
+ ******************************************************************************
+ * @file 	srp.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Wideband arrival of angle with the steered response power.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+
+/*	MUSIC looks at a single frequency, but the rotor noise spreads over
+	the whole band. SRP-PHAT whitens the spectrum of each mic, so every bin
+	only brings its phase, and sums the steered power of the bins
+
+		P(theta) = sum_k | sum_m X_m(k) / |X_m(k)| * a_m(theta, f_k) |^2
+
+	where a is the steering vector of the library. The bins are split into
+	chunks that the pool sums into their own coarse grids, and the biggest
+	peak of the total is refined with a parabola. */
+
+typedef struct _SrpTask
+{
+	int mics;
+	int chunks;
+	len_t low;									/* first bin of band */
+	len_t high;									/* one past the last bin */
+	double fs;
+	double radius;
+	len_t length;								/* samples of transform */
+	const DspFreqView *spectrums;			/* whitened bins of each mic */
+	const DspSteering **tables;			/* steering of each bin */
+	double (*partial)[DSP_STEERING_ANGLES];	/* coarse grid of each chunk */
+} SrpTask;
+
+/**
+ * Sum the steered power of the bins of `chunk` on the coarse grid.
+ */
+static void __srp_chunk(void *arg, int chunk)
+{
+	int i, k;
+	len_t bin, first, last;
+	double re, im, freq, vector[MAX_MICS][2];
+	const double (*steering)[2];
+	SrpTask *task = arg;
+
+	first = task->low + (task->high - task->low) * chunk / task->chunks;
+	last = task->low + (task->high - task->low) * (chunk + 1) / task->chunks;
+	memset(task->partial[chunk], 0, sizeof(task->partial[chunk]));
+	for (bin = first; bin < last; bin++)
+	{
+		freq = (double) bin * task->fs / task->length;
+		for (k = 0; k < DSP_STEERING_ANGLES; k++)
+		{
+			if (task->tables[bin - task->low] != NULL)
+			{
+				steering = (const double (*)[2])
+					task->tables[bin - task->low]->vectors + k * task->mics;
+			}
+			else
+			{
+				for (i = 0; i < task->mics; i++)
+				{
+					re = -(2.0 * M_PI * freq / SOUND_SPEED) * task->radius *
+						cos(k * DSP_STEERING_STEP * M_PI / 180.0 -
+						2.0 * M_PI * i / task->mics);
+					vector[i][0] = cos(re);
+					vector[i][1] = sin(re);
+				}
+				steering = (const double (*)[2]) vector;
+			}
+
+			re = 0.0;
+			im = 0.0;
+			for (i = 0; i < task->mics; i++)
+			{
+				re += task->spectrums[i].data[bin][0] * steering[i][0] -
+					task->spectrums[i].data[bin][1] * steering[i][1];
+				im += task->spectrums[i].data[bin][0] * steering[i][1] +
+					task->spectrums[i].data[bin][1] * steering[i][0];
+			}
+			task->partial[chunk][k] += re * re + im * im;
+		}
+	}
+}
+
+/**
+ * Calculate the arrival of angle in degrees within [0, 360) from the bins
+ * of [`low`, `high`] Hz. The `fs` is the sample frequency of the mics. The
+ * bins are summed on the `pool`, or serially if it's NULL. The spectrums
+ * are taken from the `arena`. The `freq` and `sources` of arrival are not
+ * used.
+ */
+double dsp_arrival_srp_phat(const DspArrival *arrival, double fs, double low,
+	double high, DspPool *pool, DspArena *arena)
+{
+	int i, k, best;
+	len_t bin, length;
+	size_t mark;
+	double magnitude, total[DSP_STEERING_ANGLES], prev, next, curve, offset;
+	double partial[DSP_POOL_MAX_WORKERS + 1][DSP_STEERING_ANGLES];
+	DspTimeView samples[MAX_MICS];
+	DspFreqView spectrums[MAX_MICS];
+	SrpTask task;
+
+	assert_arrival(arrival);
+	assert (arrival->mics > 1 && arrival->radius > 0.0 && fs > 0.0);
+	assert (low >= 0.0 && low <= high);
+	assert_arena(arena);
+	length = arrival->samples[0]->length;
+	for (i = 1; i < arrival->mics; i++)
+	{
+		assert (arrival->samples[i]->length == length);
+	}
+
+	mark = dsp_arena_mark(arena);
+	for (i = 0; i < arrival->mics; i++)
+	{
+		samples[i] = dsp_time_view_of(arrival->samples[i]);
+		spectrums[i] = dsp_freq_view_new(arena, length / 2 + 1);
+	}
+	dsp_view_rfft_batch(samples, arrival->mics, spectrums, arena);
+
+	/* The band is clipped to the bins above DC and below Nyquist. */
+	task.low = (len_t) ceil(low * length / fs);
+	task.high = (len_t) floor(high * length / fs) + 1;
+	task.low = (task.low < 1) ? 1 : task.low;
+	task.high = (task.high > length / 2) ? length / 2 : task.high;
+	if (task.high <= task.low)
+	{
+		dsp_arena_rewind(arena, mark);
+		return 0.0;
+	}
+
+	/* PHAT weighting, the silent bins are left out. */
+	for (i = 0; i < arrival->mics; i++)
+	{
+		for (bin = task.low; bin < task.high; bin++)
+		{
+			magnitude = hypot(spectrums[i].data[bin][0],
+				spectrums[i].data[bin][1]);
+			magnitude = (magnitude > DSP_LINALG_EPSILON) ? 1.0 / magnitude : 0.0;
+			spectrums[i].data[bin][0] *= magnitude;
+			spectrums[i].data[bin][1] *= magnitude;
+		}
+	}
+
+	/* The tables are looked up here, so the workers don't take the lock
+		of steering cache. */
+	task.tables = dsp_arena_alloc(arena,
+		(task.high - task.low) * sizeof(const DspSteering *));
+	for (bin = task.low; bin < task.high; bin++)
+	{
+		task.tables[bin - task.low] = dsp_steering_table(arrival->mics,
+			arrival->radius, (double) bin * fs / length);
+	}
+
+	task.mics = arrival->mics;
+	task.fs = fs;
+	task.radius = arrival->radius;
+	task.length = length;
+	task.spectrums = spectrums;
+	task.partial = partial;
+	task.chunks = dsp_pool_size(pool);
+	if ((len_t) task.chunks > task.high - task.low)
+	{
+		task.chunks = (int) (task.high - task.low);
+	}
+	if (pool != NULL)
+	{
+		dsp_pool_run(pool, __srp_chunk, &task, task.chunks);
+	}
+	else
+	{
+		__srp_chunk(&task, 0);
+	}
+
+	/* The chunks are summed in order, so the result doesn't depend on
+		the number of workers, except the rounding. */
+	best = 0;
+	for (k = 0; k < DSP_STEERING_ANGLES; k++)
+	{
+		total[k] = 0.0;
+		for (i = 0; i < task.chunks; i++)
+		{
+			total[k] += partial[i][k];
+		}
+		best = (total[k] > total[best]) ? k : best;
+	}
+	dsp_arena_rewind(arena, mark);
+
+	/* The vertex of parabola through the peak and its neighbours. */
+	prev = total[(best + DSP_STEERING_ANGLES - 1) % DSP_STEERING_ANGLES];
+	next = total[(best + 1) % DSP_STEERING_ANGLES];
+	curve = prev - 2.0 * total[best] + next;
+	offset = (curve < 0.0) ? 0.5 * (prev - next) / curve : 0.0;
+
+	return fmod((best + offset) * DSP_STEERING_STEP + 360.0, 360.0);
+}
@@ -0,0 +1,261 @@
+/**
+ ******************************************************************************
+ * @file 	steering.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Cached steering vectors and coarse-to-fine search of MUSIC.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+#include <pthread.h>
+
+/*	The geometry of the array is fixed and the dominant frequency jumps
+	between a few bins, so the steering vectors of the coarse grid are
+	computed once per (mics, radius, frequency) and then shared read-only.
+	The pseudo-spectrum is scanned on the coarse grid, and its biggest
+	peaks are refined with the golden-section search, where the steering
+	vectors are computed on the fly. */
+
+static DspSteering *steeringTables[DSP_STEERING_MAX_TABLES];
+static int steeringTableCount = 0;
+static pthread_mutex_t steeringMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Calculate the steering vector of `theta` in radians like the library,
+ * exp(-j*2*pi*f*r*cos(theta - phi_m)/c) of each mic.
+ */
+static void __steering_vector(int mics, double radius, double freq,
+	double theta, double (*vector)[2])
+{
+	int i;
+	double phase;
+
+	for (i = 0; i < mics; i++)
+	{
+		phase = -(2.0 * M_PI * freq / SOUND_SPEED) * radius *
+			cos(theta - 2.0 * M_PI * i / mics);
+		vector[i][0] = cos(phase);
+		vector[i][1] = sin(phase);
+	}
+}
+
+/**
+ * Create a new table with the steering vectors of the coarse grid.
+ */
+static DspSteering *__steering_new(int mics, double radius, double freq)
+{
+	int k;
+	DspSteering *steering;
+
+	steering = calloc(1, sizeof(DspSteering));
+	assert (steering != NULL);
+
+	steering->mics = mics;
+	steering->radius = radius;
+	steering->freq = freq;
+	steering->vectors = malloc(DSP_STEERING_ANGLES * mics * sizeof(double [2]));
+	assert (steering->vectors != NULL);
+
+	for (k = 0; k < DSP_STEERING_ANGLES; k++)
+	{
+		__steering_vector(mics, radius, freq,
+			k * DSP_STEERING_STEP * M_PI / 180.0, steering->vectors + k * mics);
+	}
+	return steering;
+}
+
+/**
+ * Get the shared steering table of the array at `freq`. It returns NULL
+ * when the cache is full, then the vectors are computed at each call.
+ */
+const DspSteering *dsp_steering_table(int mics, double radius, double freq)
+{
+	int i;
+	DspSteering *steering = NULL;
+
+	assert (mics > 1 && mics <= MAX_MICS && radius > 0.0 && freq >= 0.0);
+
+	pthread_mutex_lock(&steeringMutex);
+	for (i = 0; i < steeringTableCount; i++)
+	{
+		if (steeringTables[i]->mics == mics &&
+			steeringTables[i]->radius == radius &&
+			steeringTables[i]->freq == freq)
+		{
+			steering = steeringTables[i];
+			break;
+		}
+	}
+	if (steering == NULL && steeringTableCount < DSP_STEERING_MAX_TABLES)
+	{
+		steering = __steering_new(mics, radius, freq);
+		steeringTables[steeringTableCount++] = steering;
+	}
+	pthread_mutex_unlock(&steeringMutex);
+
+	return steering;
+}
+
+/**
+ * Return the denominator of MUSIC pseudo-spectrum, a^H * P * a of the
+ * real symmetric noise projector.
+ */
+static double __music_denominator(int mics, const double projector[][MAX_MICS],
+	const double (*vector)[2])
+{
+	int i, j;
+	double re, im, denom = 0.0;
+
+	for (i = 0; i < mics; i++)
+	{
+		re = 0.0;
+		im = 0.0;
+		for (j = 0; j < mics; j++)
+		{
+			re += projector[i][j] * vector[j][0];
+			im += projector[i][j] * vector[j][1];
+		}
+		denom += vector[i][0] * re + vector[i][1] * im;
+	}
+	return denom;
+}
+
+/**
+ * Return the denominator of MUSIC pseudo-spectrum at `degree`.
+ */
+static double __music_denominator_at(const DspArrival *arrival,
+	const double projector[][MAX_MICS], double degree)
+{
+	double vector[MAX_MICS][2];
+
+	__steering_vector(arrival->mics, arrival->radius, arrival->freq,
+		degree * M_PI / 180.0, vector);
+
+	return __music_denominator(arrival->mics, projector,
+		(const double (*)[2]) vector);
+}
+
+/**
+ * Find the minimum of denominator in [`low`, `high`] degrees with the
+ * golden-section search, the peak is unimodal in a coarse step.
+ */
+static double __golden_section(const DspArrival *arrival,
+	const double projector[][MAX_MICS], double low, double high,
+	double *denom)
+{
+	const double ratio = (sqrt(5.0) - 1.0) / 2.0;
+	double fpoint, spoint, fdenom, sdenom;
+
+	fpoint = high - ratio * (high - low);
+	spoint = low + ratio * (high - low);
+	fdenom = __music_denominator_at(arrival, projector, fpoint);
+	sdenom = __music_denominator_at(arrival, projector, spoint);
+	while (high - low > DSP_STEERING_TOLERANCE)
+	{
+		if (fdenom < sdenom)
+		{
+			high = spoint;
+			spoint = fpoint;
+			sdenom = fdenom;
+			fpoint = high - ratio * (high - low);
+			fdenom = __music_denominator_at(arrival, projector, fpoint);
+		}
+		else
+		{
+			low = fpoint;
+			fpoint = spoint;
+			fdenom = sdenom;
+			spoint = low + ratio * (high - low);
+			sdenom = __music_denominator_at(arrival, projector, spoint);
+		}
+	}
+	*denom = (fdenom < sdenom) ? fdenom : sdenom;
+
+	return (fdenom < sdenom) ? fpoint : spoint;
+}
+
+/**
+ * Return the angle of the biggest MUSIC pseudo-spectrum in degrees within
+ * [0, 360). The `projector` is the noise subspace En * En^H of the array,
+ * which is real for the real covariance of library.
+ */
+double dsp_steering_search(const DspArrival *arrival,
+	const double projector[][MAX_MICS])
+{
+	int i, k, prev, next, peaks[DSP_STEERING_PEAKS], count = 0;
+	double coarse[DSP_STEERING_ANGLES], vector[MAX_MICS][2];
+	double center, point, denom, best = INFINITY, angle = 0.0;
+	const DspSteering *steering;
+
+	assert (arrival != NULL && projector != NULL);
+
+	/* Scan the coarse grid with the cached vectors if there is a table. */
+	steering = dsp_steering_table(arrival->mics, arrival->radius,
+		arrival->freq);
+	for (k = 0; k < DSP_STEERING_ANGLES; k++)
+	{
+		if (steering != NULL)
+		{
+			coarse[k] = __music_denominator(arrival->mics, projector,
+				(const double (*)[2]) steering->vectors + k * arrival->mics);
+		}
+		else
+		{
+			__steering_vector(arrival->mics, arrival->radius, arrival->freq,
+				k * DSP_STEERING_STEP * M_PI / 180.0, vector);
+			coarse[k] = __music_denominator(arrival->mics, projector,
+				(const double (*)[2]) vector);
+		}
+	}
+
+	/* Keep the deepest local minima of the circular grid, sorted. */
+	for (k = 0; k < DSP_STEERING_ANGLES; k++)
+	{
+		prev = (k + DSP_STEERING_ANGLES - 1) % DSP_STEERING_ANGLES;
+		next = (k + 1) % DSP_STEERING_ANGLES;
+		if (coarse[k] > coarse[prev] || coarse[k] > coarse[next])
+		{
+			continue;
+		}
+		for (i = count; i > 0 && coarse[peaks[i - 1]] > coarse[k]; i--)
+		{
+			if (i < DSP_STEERING_PEAKS)
+			{
+				peaks[i] = peaks[i - 1];
+			}
+		}
+		if (i < DSP_STEERING_PEAKS)
+		{
+			peaks[i] = k;
+			count += (count < DSP_STEERING_PEAKS);
+		}
+	}
+
+	/* A flat spectrum has no strict peak, the first angle is taken. */
+	if (count == 0)
+	{
+		peaks[count++] = 0;
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		center = peaks[i] * DSP_STEERING_STEP;
+		point = __golden_section(arrival, projector,
+			center - DSP_STEERING_STEP, center + DSP_STEERING_STEP, &denom);
+		if (denom < best)
+		{
+			best = denom;
+			angle = point;
+		}
+	}
+	return fmod(angle + 360.0, 360.0);
+}
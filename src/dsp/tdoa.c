@@ -0,0 +1,226 @@
+/**
+ ******************************************************************************
+ * @file 	tdoa.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Time difference of arrival with GCC-PHAT and its bearing.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+#include <complex.h>
+
+/*	The generalized cross-correlation of a pair with PHAT weighting is the
+	inverse transform of the whitened cross spectrum
+
+		r_ij(l) = IFFT( X_j(k) * conj(X_i(k)) / |X_j(k)| / |X_i(k)| )
+
+	so each spectrum is whitened once and reused by all pairs of the mic.
+	The correlations are real, so two pairs share a complex inverse
+	transform, one in the real and one in the imaginary part. The delays
+	of the array are only a few samples, so the circular correlation is
+	used without zero padding, the wrap only leaks the edge samples.
+
+	A plane wave from azimuth phi reaches the mic n at gamma_n later by
+
+		-r / c * cos(elevation) * cos(phi - gamma_n)
+
+	so the delays of pairs are linear in u = cos(elevation) * (cos(phi),
+	sin(phi)), which is solved in least squares weighted by the peaks. */
+
+/**
+ * Return the circular correlation at `lag` from the real or imaginary part.
+ */
+static double __gcc_at(const double complex *corr, len_t length,
+	int imaginary, int lag)
+{
+	double complex value = corr[(lag + (int) length) % (int) length];
+
+	return imaginary ? cimag(value) : creal(value);
+}
+
+/**
+ * Find the peak of circular correlation within `lags` samples of zero and
+ * refine it with a parabola. Return the lag in samples.
+ */
+static double __gcc_peak(const double complex *corr, len_t length, int lags,
+	int imaginary, double *height)
+{
+	int l, best = -lags;
+	double prev, next, curve;
+
+	for (l = -lags + 1; l <= lags; l++)
+	{
+		if (__gcc_at(corr, length, imaginary, l) >
+			__gcc_at(corr, length, imaginary, best))
+		{
+			best = l;
+		}
+	}
+	*height = __gcc_at(corr, length, imaginary, best);
+	prev = __gcc_at(corr, length, imaginary, best - 1);
+	next = __gcc_at(corr, length, imaginary, best + 1);
+	curve = prev - 2.0 * *height + next;
+
+	return (curve < 0.0) ? best + 0.5 * (prev - next) / curve : best;
+}
+
+/**
+ * Calculate the time difference of arrival of each pair of mics with
+ * GCC-PHAT. The `fs` is the sample frequency of the mics. The spectrums
+ * are taken from the `arena`. The `freq` and `sources` of arrival are not
+ * used. Return the number of pairs.
+ */
+int dsp_tdoa_gcc_phat(const DspArrival *arrival, double fs, DspTdoa *result,
+	DspArena *arena)
+{
+	int i, j, p, q, lags;
+	len_t k, length, bins;
+	size_t mark;
+	double magnitude, height;
+	const DspFFTPlan *plan;
+	DspTimeView samples[MAX_MICS];
+	DspFreqView spectrums[MAX_MICS];
+	double complex *cross, *corr, first, second;
+
+	assert_arrival(arrival);
+	assert (arrival->mics > 1 && arrival->radius > 0.0 && fs > 0.0);
+	assert (result != NULL);
+	assert_arena(arena);
+	length = arrival->samples[0]->length;
+	for (i = 1; i < arrival->mics; i++)
+	{
+		assert (arrival->samples[i]->length == length);
+	}
+
+	/* The delay of a pair can't be longer than the diameter. */
+	lags = (int) ceil(2.0 * arrival->radius / SOUND_SPEED * fs) + 1;
+	assert (2 * lags + 1 < (int) length);
+
+	mark = dsp_arena_mark(arena);
+	bins = length / 2 + 1;
+	for (i = 0; i < arrival->mics; i++)
+	{
+		samples[i] = dsp_time_view_of(arrival->samples[i]);
+		spectrums[i] = dsp_freq_view_new(arena, bins);
+	}
+	dsp_view_rfft_batch(samples, arrival->mics, spectrums, arena);
+
+	/* PHAT weighting of each mic, the silent bins are left out. */
+	for (i = 0; i < arrival->mics; i++)
+	{
+		for (k = 0; k < bins; k++)
+		{
+			magnitude = hypot(spectrums[i].data[k][0], spectrums[i].data[k][1]);
+			magnitude = (magnitude > DSP_LINALG_EPSILON) ? 1.0 / magnitude : 0.0;
+			spectrums[i].data[k][0] *= magnitude;
+			spectrums[i].data[k][1] *= magnitude;
+		}
+	}
+
+	result->mics = arrival->mics;
+	result->pairs = 0;
+	for (i = 0; i < arrival->mics; i++)
+	{
+		for (j = i + 1; j < arrival->mics; j++)
+		{
+			result->first[result->pairs] = i;
+			result->second[result->pairs] = j;
+			result->pairs++;
+		}
+	}
+
+	plan = dsp_fft_plan(length);
+	cross = dsp_arena_alloc(arena, length * sizeof(double complex));
+	corr = dsp_arena_alloc(arena, length * sizeof(double complex));
+	for (p = 0; p < result->pairs; p += 2)
+	{
+		/* The pair q rides on the imaginary part, if there is one. */
+		q = (p + 1 < result->pairs) ? p + 1 : -1;
+		for (k = 0; k < bins; k++)
+		{
+			first = spectrums[result->second[p]].data[k][0] +
+				I * spectrums[result->second[p]].data[k][1];
+			first *= spectrums[result->first[p]].data[k][0] -
+				I * spectrums[result->first[p]].data[k][1];
+			second = 0.0;
+			if (q >= 0)
+			{
+				second = spectrums[result->second[q]].data[k][0] +
+					I * spectrums[result->second[q]].data[k][1];
+				second *= spectrums[result->first[q]].data[k][0] -
+					I * spectrums[result->first[q]].data[k][1];
+			}
+			cross[k] = first + I * second;
+			if (k > 0 && length - k >= bins)
+			{
+				cross[length - k] = conj(first) + I * conj(second);
+			}
+		}
+		dsp_fft_complex(plan, (const double (*)[2]) cross,
+			(double (*)[2]) corr, 1);
+
+		/* The peak of a coherent pair is 1 after the normalization. */
+		result->delay[p] = __gcc_peak(corr, length, lags, 0, &height) / fs;
+		result->weight[p] = fmax(height / length, 0.0);
+		if (q >= 0)
+		{
+			result->delay[q] = __gcc_peak(corr, length, lags, 1, &height) / fs;
+			result->weight[q] = fmax(height / length, 0.0);
+		}
+	}
+	dsp_arena_rewind(arena, mark);
+
+	return result->pairs;
+}
+
+/**
+ * Calculate the direction of a plane wave from the delays of pairs in
+ * weighted least squares. The mics must be evenly spaced on the circle of
+ * `radius`, in the order of the library. Return 0 if the delays don't
+ * have any direction.
+ */
+int dsp_arrival_tdoa(const DspTdoa *tdoa, double radius, DspDirection *result)
+{
+	int p;
+	double dx, dy, w, xx = 0.0, xy = 0.0, yy = 0.0, xt = 0.0, yt = 0.0;
+	double det, ux, uy;
+
+	assert (tdoa != NULL && tdoa->mics > 1 && radius > 0.0);
+	assert (result != NULL);
+
+	/* delay = r / c * (dx * ux + dy * uy) of the pair (i, j), where
+		dx = cos(gamma_i) - cos(gamma_j) and dy likewise. */
+	for (p = 0; p < tdoa->pairs; p++)
+	{
+		dx = cos(2.0 * M_PI * tdoa->first[p] / tdoa->mics) -
+			cos(2.0 * M_PI * tdoa->second[p] / tdoa->mics);
+		dy = sin(2.0 * M_PI * tdoa->first[p] / tdoa->mics) -
+			sin(2.0 * M_PI * tdoa->second[p] / tdoa->mics);
+		w = tdoa->weight[p];
+		xx += w * dx * dx;
+		xy += w * dx * dy;
+		yy += w * dy * dy;
+		xt += w * dx * tdoa->delay[p] * SOUND_SPEED / radius;
+		yt += w * dy * tdoa->delay[p] * SOUND_SPEED / radius;
+	}
+	det = xx * yy - xy * xy;
+	if (det <= DSP_LINALG_EPSILON)
+	{
+		return 0;
+	}
+	ux = (yy * xt - xy * yt) / det;
+	uy = (xx * yt - xy * xt) / det;
+
+	result->azimuth = fmod(atan2(uy, ux) * 180.0 / M_PI + 360.0, 360.0);
+	result->elevation = acos(fmin(hypot(ux, uy), 1.0)) * 180.0 / M_PI;
+	return 1;
+}
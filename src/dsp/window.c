@@ -0,0 +1,243 @@
+/**
+ ******************************************************************************
+ * @file 	window.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Cached window tables applied in place.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./dsp_ext.h"
+#include <pthread.h>
+
+/*	The windows of library compute the cosines, or the Bessel functions of
+	Kaiser, for each sample at each call, although the frames of all
+	channels have the same length. The tables here are computed once per
+	(type, length, factor) in both precisions, like the twiddles of the FFT
+	plans, and then shared read-only. The cosine and Chebyshev windows are
+	the ones of library. Kaiser uses the modified Bessel function I0 with
+	the shape of the stop band attenuation:
+
+		w(n) = I0(beta * sqrt(1 - x^2)) / I0(beta),	x = 2n / (N - 1) - 1
+
+	A window of a single sample is 1. */
+
+static DspWindowTable *windowTables[DSP_WINDOW_MAX_TABLES];
+static int windowTableCount = 0;
+static pthread_mutex_t windowMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Return the modified Bessel function I0(x) from its power series.
+ */
+static double __bessel_i0(double x)
+{
+	int k;
+	double term = 1.0, sum = 1.0;
+
+	for (k = 1; k < 256 && term > 1e-16 * sum; k++)
+	{
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+/**
+ * Return the shape of Kaiser window for the attenuation of `factor` dB.
+ */
+static double __kaiser_beta(int factor)
+{
+	if (factor > 50)
+	{
+		return 0.1102 * (factor - 8.7);
+	}
+	if (factor > 21)
+	{
+		return 0.5842 * pow(factor - 21, 0.4) + 0.07886 * (factor - 21);
+	}
+	return 0.0;
+}
+
+/**
+ * Fill the `length` coefficients of the window into `coeffs`.
+ */
+static void __window_fill(DspWindow type, len_t length, int factor,
+	double *coeffs)
+{
+	len_t n;
+	double phase, x, beta;
+
+	if (length == 1)
+	{
+		coeffs[0] = 1.0;
+		return;
+	}
+	beta = 0.0;
+	if (type == DSP_WINDOW_CHEBYSHEV)
+	{
+		beta = acosh(pow(10.0, factor / 20.0));
+	}
+	else if (type == DSP_WINDOW_KAISER)
+	{
+		beta = __kaiser_beta(factor);
+	}
+
+	for (n = 0; n < length; n++)
+	{
+		phase = 2.0 * M_PI * n / (length - 1.0);
+		switch (type)
+		{
+			case DSP_WINDOW_HAMMING:
+				coeffs[n] = 0.54 - 0.46 * cos(phase);
+				break;
+			case DSP_WINDOW_HANNING:
+				coeffs[n] = 0.5 - 0.5 * cos(phase);
+				break;
+			case DSP_WINDOW_BLACKMAN:
+				coeffs[n] = 0.42 - 0.5 * cos(phase) + 0.08 * cos(2.0 * phase);
+				break;
+			case DSP_WINDOW_CHEBYSHEV:
+				coeffs[n] = cosh(beta * cos(M_PI * (2.0 * n - length + 1.0) /
+					(2.0 * length)));
+				break;
+			case DSP_WINDOW_KAISER:
+				x = 2.0 * n / (length - 1.0) - 1.0;
+				coeffs[n] = __bessel_i0(beta * sqrt(fmax(1.0 - x * x, 0.0))) /
+					__bessel_i0(beta);
+				break;
+			default:
+				assert (0);
+		}
+	}
+}
+
+/**
+ * Create a new table with the coefficients of both precisions.
+ */
+static DspWindowTable *__window_new(DspWindow type, len_t length, int factor)
+{
+	len_t n;
+	DspWindowTable *table;
+
+	table = calloc(1, sizeof(DspWindowTable));
+	assert (table != NULL);
+
+	table->type = type;
+	table->length = length;
+	table->factor = factor;
+	table->coeffs = malloc(length * sizeof(double));
+	table->coeffsF32 = malloc(length * sizeof(float));
+	assert (table->coeffs != NULL && table->coeffsF32 != NULL);
+
+	__window_fill(type, length, factor, table->coeffs);
+	for (n = 0; n < length; n++)
+	{
+		table->coeffsF32[n] = (float) table->coeffs[n];
+	}
+	return table;
+}
+
+/**
+ * Get the shared table of the window of `length` samples. The `factor` is
+ * the attenuation in dB of Chebyshev and Kaiser windows, and it's ignored
+ * by the others. It returns NULL when the cache is full, then the window
+ * is computed at each call.
+ */
+const DspWindowTable *dsp_window_table(DspWindow type, len_t length,
+	int factor)
+{
+	int i;
+	DspWindowTable *table = NULL;
+
+	assert_length(length);
+	assert (type >= DSP_WINDOW_HAMMING && type <= DSP_WINDOW_KAISER);
+
+	/* A single key for the windows without a factor. */
+	if (type != DSP_WINDOW_CHEBYSHEV && type != DSP_WINDOW_KAISER)
+	{
+		factor = 0;
+	}
+
+	pthread_mutex_lock(&windowMutex);
+	for (i = 0; i < windowTableCount; i++)
+	{
+		if (windowTables[i]->type == type &&
+			windowTables[i]->length == length &&
+			windowTables[i]->factor == factor)
+		{
+			table = windowTables[i];
+			break;
+		}
+	}
+	if (table == NULL && windowTableCount < DSP_WINDOW_MAX_TABLES)
+	{
+		table = __window_new(type, length, factor);
+		windowTables[windowTableCount++] = table;
+	}
+	pthread_mutex_unlock(&windowMutex);
+
+	return table;
+}
+
+/**
+ * Multiply the sample by the window of its length in place.
+ */
+void dsp_window_apply(DspWindow type, int factor, DspTimeView *sample)
+{
+	double *coeffs;
+	const DspWindowTable *table;
+
+	assert_view(sample);
+
+	table = dsp_window_table(type, sample->length, factor);
+	if (table != NULL)
+	{
+		dsp_view_window(sample, table->coeffs, sample);
+		return;
+	}
+
+	coeffs = malloc(sample->length * sizeof(double));
+	assert (coeffs != NULL);
+	__window_fill(type, sample->length, factor, coeffs);
+	dsp_view_window(sample, coeffs, sample);
+	free(coeffs);
+}
+
+/**
+ * Multiply the single-precision sample by the window in place.
+ */
+void dsp_window_apply_f32(DspWindow type, int factor, DspTimeViewF32 *sample)
+{
+	len_t n;
+	double *coeffs;
+	const DspWindowTable *table;
+
+	assert_view(sample);
+
+	table = dsp_window_table(type, sample->length, factor);
+	if (table != NULL)
+	{
+		for (n = 0; n < sample->length; n++)
+		{
+			sample->data[n] *= table->coeffsF32[n];
+		}
+		return;
+	}
+
+	coeffs = malloc(sample->length * sizeof(double));
+	assert (coeffs != NULL);
+	__window_fill(type, sample->length, factor, coeffs);
+	for (n = 0; n < sample->length; n++)
+	{
+		sample->data[n] *= (float) coeffs[n];
+	}
+	free(coeffs);
+}
@@ -0,0 +1,361 @@
+/**
+ ******************************************************************************
+ * @file 	logger.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Asynchronous system logger of AeroSONAR.
+ * 
+ ******************************************************************************
+ * @attention
+ * 
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ * 
+ * This software is licensed under the MIT License.
+ * 
+ ******************************************************************************
+ */
+
+#include "main.h"
+
+/* Global and Shared Variables */
+
+LogLevel logLevel = LOG_LEVEL_INFO;
+
+static LogQueue logQueue;
+static pthread_t loggerThread;
+static pthread_mutex_t loggerMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t loggerCond = PTHREAD_COND_INITIALIZER;
+static const char *loggerPath = NULL;
+static int loggerFd = -1;
+static off_t loggerSize = 0;						/* current file size */
+static atomic_bool loggerRunning = false;
+
+static const char *levelNames[] = {"DEBUG", "INFO", "WARNING", "ERROR"};
+
+/**
+ * Return the name of log level.
+ */
+const char *log_level_name(LogLevel level)
+{
+	return levelNames[level];
+}
+
+/**
+ * Push a log line into the queue. It's called by any thread and never
+ * blocks, so the line is dropped if the queue is full.
+ */
+static gboolean __log_push(LogLevel level, const char *buffer, size_t size)
+{
+	size_t head;
+	ptrdiff_t lag;
+	LogSlot *slot;
+
+	head = atomic_load_explicit(&logQueue.head, memory_order_relaxed);
+	for (;;)
+	{
+		slot = &logQueue.slots[head & (LOG_QUEUE_CAPACITY - 1)];
+		lag = (ptrdiff_t) (atomic_load_explicit(&slot->sequence,
+			memory_order_acquire) - head);
+		if (lag == 0)
+		{
+			/* The slot is free, try to claim it for this producer. */
+			if (atomic_compare_exchange_weak_explicit(&logQueue.head, &head,
+					head + 1, memory_order_relaxed, memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (lag < 0)
+		{
+			atomic_fetch_add_explicit(&logQueue.dropped, 1,
+				memory_order_relaxed);
+			return FALSE;		/* the logger is too slow */
+		}
+		else
+		{
+			head = atomic_load_explicit(&logQueue.head, memory_order_relaxed);
+		}
+	}
+	slot->level = level;
+	slot->size = (size < BUFFER_SIZE) ? size : BUFFER_SIZE;
+	memcpy(slot->text, buffer, slot->size);
+	atomic_store_explicit(&slot->sequence, head + 1, memory_order_release);
+
+	/* Wake up the logger early when the lines pile up. */
+	if (((head + 1) & (LOG_QUEUE_CAPACITY / 4 - 1)) == 0)
+	{
+		pthread_cond_signal(&loggerCond);
+	}
+	return TRUE;
+}
+
+/**
+ * Pop a log line from the queue. It's only called by the logger thread.
+ */
+static LogSlot *__log_peek(void)
+{
+	size_t tail;
+	LogSlot *slot;
+
+	tail = logQueue.tail;
+	slot = &logQueue.slots[tail & (LOG_QUEUE_CAPACITY - 1)];
+	if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != tail + 1)
+	{
+		return NULL;		/* there is no complete line yet */
+	}
+	return slot;
+}
+
+/**
+ * Release the popped slot to producers.
+ */
+static void __log_release(LogSlot *slot)
+{
+	atomic_store_explicit(&slot->sequence, logQueue.tail + LOG_QUEUE_CAPACITY,
+		memory_order_release);
+	logQueue.tail++;
+}
+
+/**
+ * Open the log file in append mode and get its size.
+ */
+static void __log_open(void)
+{
+	struct stat st;
+
+	loggerFd = open(loggerPath, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC,
+		0644);
+	if (loggerFd == -1)
+		syscallError();
+
+	if (fstat(loggerFd, &st) == -1)
+		syscallError();
+
+	loggerSize = st.st_size;
+}
+
+/**
+ * Rotate the log files as 'system.log.1', 'system.log.2' and so on. The
+ * oldest one is overwritten.
+ */
+static void __log_rotate(void)
+{
+	int i;
+	char oldPath[PATH_MAX], newPath[PATH_MAX];
+
+	if (fsync(loggerFd) == -1 || close(loggerFd) == -1)
+		syscallError();
+
+	for (i = LOG_ROTATE_COUNT - 1; i >= 1; i--)
+	{
+		snprintf(oldPath, PATH_MAX, "%s.%d", loggerPath, i);
+		snprintf(newPath, PATH_MAX, "%s.%d", loggerPath, i + 1);
+		if (rename(oldPath, newPath) == -1 && errno != ENOENT)
+			syscallError();
+	}
+	snprintf(newPath, PATH_MAX, "%s.1", loggerPath);
+	if (rename(loggerPath, newPath) == -1)
+		syscallError();
+
+	__log_open();
+}
+
+/**
+ * Write the batch into log file. Rotate the file if it's too big.
+ */
+static void __log_write(const char *batch, size_t size)
+{
+	ssize_t numWritten;
+
+	while (size > 0)
+	{
+		numWritten = write(loggerFd, batch, size);
+		if (numWritten == -1)
+		{
+			if (errno == EINTR)
+				continue;
+			syscallError();
+		}
+		batch += numWritten;
+		size -= numWritten;
+		loggerSize += numWritten;
+	}
+	if (loggerSize >= LOG_ROTATE_SIZE)
+	{
+		__log_rotate();
+	}
+}
+
+/**
+ * Drain the queue into log file on its own thread. The lines are written
+ * in batches and synced periodically, on errors or after enough bytes.
+ */
+static void *__logger(void *arg)
+{
+	static char batch[LOG_BATCH_SIZE];
+	size_t size, unsynced = 0;
+	gboolean urgent = FALSE, running = TRUE;
+	gint64 lastSync;
+	struct timespec deadline;
+	LogSlot *slot;
+
+	lastSync = g_get_monotonic_time();
+	while (running)
+	{
+		/* Sleep until the next flush or until the logger is stopped. */
+		pthread_mutex_lock(&loggerMutex);
+		if (atomic_load(&loggerRunning))
+		{
+			clock_gettime(CLOCK_REALTIME, &deadline);
+			deadline.tv_nsec += LOG_FLUSH_INTERVAL * 1000000L;
+			deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+			deadline.tv_nsec %= 1000000000L;
+			pthread_cond_timedwait(&loggerCond, &loggerMutex, &deadline);
+		}
+		running = atomic_load(&loggerRunning);
+		pthread_mutex_unlock(&loggerMutex);
+
+		/* Gather the complete lines into a single write. */
+		size = 0;
+		while ((slot = __log_peek()) != NULL)
+		{
+			if (size + slot->size > LOG_BATCH_SIZE)
+			{
+				__log_write(batch, size);
+				unsynced += size;
+				size = 0;
+			}
+			memcpy(batch + size, slot->text, slot->size);
+			size += slot->size;
+			urgent |= (slot->level >= LOG_LEVEL_ERROR);
+			__log_release(slot);
+		}
+		if (size > 0)
+		{
+			__log_write(batch, size);
+			unsynced += size;
+		}
+
+		/* Sync the written lines when they are worth it. */
+		if (unsynced > 0 && (urgent || !running ||
+			unsynced >= LOG_SYNC_SIZE ||
+			g_get_monotonic_time() - lastSync >= LOG_SYNC_INTERVAL * 1000))
+		{
+			if (fdatasync(loggerFd) == -1)
+				syscallError();
+
+			unsynced = 0;
+			urgent = FALSE;
+			lastSync = g_get_monotonic_time();
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Write the system logs into required file. The line is queued for the
+ * logger thread if it's running, otherwise it's written directly.
+ */
+void logging(LogLevel level, const char *buffer, size_t size)
+{
+	int fd;
+
+	if (atomic_load(&loggerRunning))
+	{
+		__log_push(level, buffer, size);
+		return;
+	}
+	fd = open(SYSTEM_LOG_PATH, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+	if (fd == -1)
+		syscallError();
+
+	if (write(fd, buffer, size) == -1)	/* write the logs. */
+		syscallError();
+
+	if (close(fd) == -1)
+		syscallError();
+}
+
+/**
+ * Start the logger thread of the log file. The level is taken from the
+ * SONAR_LOG_LEVEL environment variable (DEBUG, INFO, WARNING or ERROR).
+ */
+void start_logger(const char *filepath)
+{
+	int i, err;
+	const char *level;
+
+	if (atomic_load(&loggerRunning))
+	{
+		return;		/* there is already a running logger */
+	}
+	level = getenv("SONAR_LOG_LEVEL");
+	for (i = LOG_LEVEL_DEBUG; level != NULL && i <= LOG_LEVEL_ERROR; i++)
+	{
+		if (strcasecmp(level, levelNames[i]) == 0)
+		{
+			logLevel = (LogLevel) i;
+		}
+	}
+	for (i = 0; i < LOG_QUEUE_CAPACITY; i++)
+	{
+		atomic_store(&logQueue.slots[i].sequence, i);
+	}
+	atomic_store(&logQueue.head, 0);
+	atomic_store(&logQueue.dropped, 0);
+	logQueue.tail = 0;
+
+	loggerPath = filepath;
+	__log_open();
+
+	atomic_store(&loggerRunning, true);
+	err = pthread_create(&loggerThread, NULL, __logger, NULL);
+	if (err != 0)
+	{
+		errno = err;
+		syscallError();
+	}
+	atexit(stop_logger);		/* flush the queue on every exit */
+}
+
+/**
+ * Stop the logger thread after the queued lines are written.
+ */
+void stop_logger(void)
+{
+	int err, length;
+	size_t dropped;
+	char buffer[BUFFER_SIZE];
+
+	if (!atomic_load(&loggerRunning) ||
+		pthread_equal(pthread_self(), loggerThread))
+	{
+		return;		/* the logger thread itself exits on an error */
+	}
+	pthread_mutex_lock(&loggerMutex);
+	atomic_store(&loggerRunning, false);
+	pthread_cond_signal(&loggerCond);
+	pthread_mutex_unlock(&loggerMutex);
+
+	err = pthread_join(loggerThread, NULL);
+	if (err != 0)
+	{
+		errno = err;
+		syscallError();
+	}
+
+	/* The summary goes to the file of logger before it's closed. */
+	dropped = atomic_load(&logQueue.dropped);
+	if (dropped > 0 && LOG_LEVEL_WARNING >= logLevel)
+	{
+		length = snprintf(buffer, BUFFER_SIZE,
+			"[PID=%d][%s][%s] the logger dropped %zu lines\n", getpid(),
+			get_time(TIME_FORMAT), log_level_name(LOG_LEVEL_WARNING), dropped);
+		__log_write(buffer, (length < BUFFER_SIZE) ? length : BUFFER_SIZE - 1);
+		printf("%s", buffer);
+	}
+	if (fdatasync(loggerFd) == -1 || close(loggerFd) == -1)
+		syscallError();
+
+	loggerFd = -1;
+}
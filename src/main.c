@@ -22,6 +22,49 @@
 HeaderButton headerButton;
 CurrentPage currentPage = PAGE_MICROPHONE;
 
+static char *replayPath = NULL;
+static double replaySpeed = 1.0;
+
+static GOptionEntry replayOptions[] =
+{
+	{"replay", 'r', 0, G_OPTION_ARG_FILENAME, &replayPath,
+		"Replay the recorded session (database or raw capture)", "FILE"},
+	{"speed", 's', 0, G_OPTION_ARG_DOUBLE, &replaySpeed,
+		"Replay speed as multiple of real-time, 0 is as fast as possible", "X"},
+	{NULL}
+};
+
+/**
+ * Replay the recorded session without any window if it's requested.
+ */
+int on_handle_local_options(GApplication *app, GVariantDict *options,
+	gpointer user_data)
+{
+	ReplayStats stats;
+
+	if (replayPath == NULL)
+	{
+		return -1;		/* continue with the GUI */
+	}
+	if (replaySpeed < 0.0)
+	{
+		printWarning("the replay speed can't be negative");
+		return EXIT_FAILURE;
+	}
+	replay_run(replayPath, replaySpeed, &stats);
+
+	g_print("%" G_GUINT64_FORMAT " frames, %.1f frames/s, %.1fx real-time\n",
+		stats.frames, stats.frames / MAX(stats.elapsed / 1e6, 1e-9),
+		stats.recorded / (double) MAX(stats.elapsed, 1));
+
+	return EXIT_SUCCESS;
+}
+
+void on_startup(GtkApplication *app, gpointer user_data)
+{
+	adw_init();
+}
+
 void on_activate(GtkApplication *app, gpointer user_data)
 {
 	GtkWidget *window, *headerBar;
@@ -132,8 +175,14 @@ int main(int argc, char *argv[])
 	int status;
 	GtkApplication *app;
 
-	adw_init();
+	/* Write the logs on their own thread from now on. */
+	start_logger(SYSTEM_LOG_PATH);
+
 	app = gtk_application_new("com.example.SmartBP", G_APPLICATION_DEFAULT_FLAGS);
+	g_application_add_main_option_entries(G_APPLICATION(app), replayOptions);
+	g_signal_connect(app, "handle-local-options",
+		G_CALLBACK(on_handle_local_options), NULL);
+	g_signal_connect(app, "startup", G_CALLBACK(on_startup), NULL);
 	g_signal_connect(app, "activate", G_CALLBACK(on_activate), NULL);
 
 	status = g_application_run(G_APPLICATION(app), argc, argv);
@@ -45,6 +45,10 @@ extern "C" {
 #include <limits.h>
 #include <sys/types.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <poll.h>
 #include <check.h>
 #include <cairo/cairo.h>
 #include <adwaita.h>
@@ -52,6 +56,10 @@ extern "C" {
 #include <sqlite3.h>
 // #include "../lib/include/alat.h"
 #include "../lib/include/dsp.h"
+#include "./dsp/dsp_ext.h"
+#include "../common/protocol.h"
+#include "../common/payload.h"
+#include "./pipeline.h"
 
 /* Global macro definitions */
 
@@ -62,10 +70,24 @@ extern "C" {
 #define GPS_SIZE								64
 #define INTERPRETER							"/bin/python3"
 #define SYSTEM_LOG_PATH						"./logs/system.log"
-#define MAGIC_WORD							0xDEADBEEF
+#define LOG_QUEUE_CAPACITY					1024		/* power of 2 */
+#define LOG_BATCH_SIZE						65536		/* bytes per write */
+#define LOG_FLUSH_INTERVAL					100		/* ms */
+#define LOG_SYNC_INTERVAL					1000		/* ms */
+#define LOG_SYNC_SIZE						65536		/* bytes */
+#define LOG_ROTATE_SIZE						( 4 * 1024 * 1024 )	/* bytes */
+#define LOG_ROTATE_COUNT					3
 
 #define DB_SENSOR_DATA_PATH				"./db/sensor_data.db"
 #define DB_SENSOR_DATA_TABLE				"SensorData"
+#define DB_SCHEMA_VERSION					2
+#define DB_MIC_RAW							0			/* channel-major int8 */
+#define DB_MIC_ENCODED						1			/* common/payload.h */
+#define DB_MIC_ENCODING						DB_MIC_RAW
+#define DB_MIC_SIZE							( PAYLOAD_MIC_COUNT * PAYLOAD_MIC_SIZE )
+#define DB_SYNCHRONOUS						"NORMAL"	/* OFF, NORMAL or FULL */
+#define DB_COMMIT_ROWS						64			/* rows per transaction */
+#define DB_COMMIT_INTERVAL					1000		/* ms */
 
 #define MAX_COMM_CHANNEL					3
 #define MAX_BUFFER_SIZE						( BUFFER_SIZE * 200 )
@@ -78,6 +100,15 @@ extern "C" {
 #define MAX_MODEL_LAYER_NUMBER			48
 #define MAX_CAMERA_FILE						16	
 
+#define RING_CAPACITY						16		/* frames, power of two */
+#define ANALYSIS_PRECISION					PIPELINE_FLOAT32	/* or PIPELINE_FLOAT64 */
+#define ANALYSIS_MUSIC_FORGET				0.8		/* weight of previous frames */
+#define ANALYSIS_MUSIC_REFRESH			32			/* frames between eigensolves */
+#define ANALYSIS_WIDEBAND					0			/* SRP-PHAT instead of MUSIC */
+#define ANALYSIS_SRP_WORKERS				3			/* threads besides GTK loop */
+#define ANALYSIS_MVDR						0			/* MVDR instead of delay-and-sum */
+#define ANALYSIS_BAND_ORDER				0			/* Butterworth band limiting, e.g. 4 */
+
 #define BUTTON_WIDTH							100 	/* pixel */	
 #define BUTTON_HEIGHT						40  	/* pixel */	
 #define PAGE_BOX_MARGIN_WIDTH				20  	/* pixel */	
@@ -93,9 +124,6 @@ extern "C" {
 #define MIC_PLOT_MARGIN						40		/* pixel */
 #define MIC_PLOT_GRID						20 	/* pixel */
 #define MIC_SIGNAL_NUM						15
-#define MIC_COUNT								8
-#define MIC_RADIUS							0.1		/* 0.1 meter */
-#define MIC_SAMPLE_FREQ						12000		/* 12kHz */
 
 #define MODEL_DATASET_PATH					"/home/can/Datasets/"
 #define MODEL_DATASET_SUFFIX				".csv"
@@ -116,13 +144,17 @@ extern "C" {
 #define GPS_INIT_LONG						28.9784
 #define GPS_MODULE							"E22 900T22D"
 
-#define TIMEOUT_DEVICE_READ				2000		/* ms */
+#define TIMEOUT_DEVICE_READ				100		/* ms */
 #define TIMEOUT_PLOT_REDRAW				2000		/* ms */
 #define TIMEOUT_MODEL_LOG					10000		/* ms */
-#define TIMEOUT_DATA_RECORD				10000		/* ms */
+#define TIMEOUT_DATA_RECORD				DB_COMMIT_INTERVAL
 #define TIMEOUT_NAV_UPDATE					2000		/* ms */ 
 #define TIMEOUT_GPS_UPDATE					2000		/* ms */
 
+#define REPLAY_CAPTURE_PERIOD				TIMEOUT_DEVICE_READ	/* ms */
+#define REPLAY_BUFFER_SIZE					( BUFFER_SIZE * 16 )
+#define REPLAY_MAX_GAP						1000		/* ms */
+
 /* Attribute and built-in macro definitions  */
 
 #define FILE									__FILE__
@@ -138,18 +170,30 @@ extern "C" {
 
 /* Maro function definitions */
 
-#define printLog(msg, ...)																	\
+#define printLevelLog(level, msg, ...)													\
 {																									\
 	char buffer[BUFFER_SIZE];																\
+	int length;																					\
 																									\
-	memset(buffer, 0, BUFFER_SIZE);														\
-	sprintf(buffer, "[PID=%d][%s] " msg "\n", getpid(), 							\
-		get_time(TIME_FORMAT), ##__VA_ARGS__);											\
-																									\
-	logging(buffer, strlen(buffer));		/* write the logs */						\
-	printf("%s", buffer);		/* print the log buffer to "stdout" */			\
+	if ((level) >= logLevel)																\
+	{																								\
+		length = snprintf(buffer, BUFFER_SIZE, "[PID=%d][%s][%s] " msg "\n",		\
+			getpid(), get_time(TIME_FORMAT), log_level_name(level),					\
+			##__VA_ARGS__);																	\
+		if (length >= BUFFER_SIZE)															\
+		{																							\
+			length = BUFFER_SIZE - 1;		/* keep the truncated line */			\
+			buffer[length - 1] = '\n';														\
+		}																							\
+		logging(level, buffer, length);		/* queue the logs */					\
+		printf("%s", buffer);		/* print the log buffer to "stdout" */		\
+	}																								\
 }
 
+#define printLog(msg, ...)			printLevelLog(LOG_LEVEL_INFO, msg, ##__VA_ARGS__)
+#define printDebug(msg, ...)		printLevelLog(LOG_LEVEL_DEBUG, msg, ##__VA_ARGS__)
+#define printWarning(msg, ...)	printLevelLog(LOG_LEVEL_WARNING, msg, ##__VA_ARGS__)
+
 #define syscallError()																		\
 {                                      												\
 	fprintf(stderr, "\n*** %s (%s::%d in %s()) ***\n", strerror(errno),		\
@@ -213,6 +257,14 @@ typedef enum _HeaderButton
 	HEADER_BUTTON_AVATAR
 } HeaderButton;
 
+typedef enum _LogLevel
+{
+	LOG_LEVEL_DEBUG,
+	LOG_LEVEL_INFO,
+	LOG_LEVEL_WARNING,
+	LOG_LEVEL_ERROR
+} LogLevel;
+
 typedef enum _Database
 {
 	DATABASE_SENSOR_DATA,
@@ -341,47 +393,89 @@ typedef enum _GPSButton
 	GPS_BUTTON_START
 } GPSButton;
 
+/* Replay enumerations */
+
+typedef enum _ReplayKind
+{
+	REPLAY_DATABASE,							/* sensor database */
+	REPLAY_CAPTURE								/* raw byte stream of device */
+} ReplayKind;
+
 /*****************************************************************************/
 /*****************************************************************************/
 
 /* Global structures */
 
-typedef struct PACKED _PayloadData
+typedef struct _PayloadRing
+{
+	/* The single-producer/single-consumer ring of the frames that passed
+		the CRC check. The indexes are free-running, so they are only 
+		masked while accessing frames. */
+
+	ALIGNED(64) atomic_size_t head;	/* written by the reader thread */
+	ALIGNED(64) atomic_size_t tail;	/* written by the GTK main loop */
+	ALIGNED(64) atomic_size_t dropped;	/* frames dropped on overrun */
+	PayloadData frames[RING_CAPACITY];
+} PayloadRing;
+
+typedef struct _LogSlot
 {
-	/* The microphone sensors payload data  */
-
-	int8_t micNorth[DATA_SIZE];
-	int8_t micNorthEast[DATA_SIZE];
-	int8_t micEast[DATA_SIZE];
-	int8_t micSouthEast[DATA_SIZE];
-	int8_t micSouth[DATA_SIZE];
-	int8_t micSouthWest[DATA_SIZE];
-	int8_t micWest[DATA_SIZE];
-	int8_t micNorthWest[DATA_SIZE];
-
-	/* The GPS module payload data */
-
-	char gpsUTCTime[GPS_SIZE];
-	char gpsLatitude[GPS_SIZE];
-	char gpsLongitude[GPS_SIZE];
-	char gpsQuality[GPS_SIZE];
-	char gpsNumSat[GPS_SIZE];
-	char gpsAltitude[GPS_SIZE];
-	char gpsStatus[GPS_SIZE];
-	char gpsSpeed[GPS_SIZE];			/* knots */
-	char gpsCourse[GPS_SIZE];			/* degrees */
-	char gpsDate[GPS_SIZE];
-
-	/* The IMU sensor payload data */
-	
-	float imuAccelX;						/* m/s^2 */
-	float imuAccelY;						/* m/s^2 */
-	float imuAccelZ;						/* m/s^2 */
-	float imuGyroX;						/* dps */
-	float imuGyroY;						/* dps */
-	float imuGyroZ;						/* dps */
-	float imuTemp;							/* C */ 
-} PayloadData;
+	atomic_size_t sequence;					/* owner of slot (Vyukov's queue) */
+	LogLevel level;
+	size_t size;
+	char text[BUFFER_SIZE];
+} LogSlot;
+
+typedef struct _LogQueue
+{
+	/* The multi-producer/single-consumer queue of the log lines. The 
+		producers claim a slot with CAS on head and publish it with its 
+		sequence, so the logger only takes the complete lines. */
+
+	ALIGNED(64) atomic_size_t head;	/* claimed by any thread */
+	ALIGNED(64) size_t tail;			/* owned by the logger thread */
+	ALIGNED(64) atomic_size_t dropped;	/* lines dropped on overrun */
+	LogSlot slots[LOG_QUEUE_CAPACITY];
+} LogQueue;
+
+typedef struct _DbRecorder
+{
+	/* The sensor data recorder of a session. The insertion is prepared
+		once and the rows are batched in the explicit transactions. */
+
+	sqlite3 *db;
+	sqlite3_stmt *insert;					/* cached INSERT statement */
+	int pending;								/* rows in open transaction */
+	gint64 began;								/* monotonic time of BEGIN (us) */
+	gint64 sequence;							/* next frame sequence */
+	guint64 rows;								/* recorded rows */
+	guint64 commits;							/* committed transactions */
+} DbRecorder;
+
+typedef struct _ReplaySource
+{
+	/* The recorded session that is fed into the analysis pipeline again. */
+
+	ReplayKind kind;
+	sqlite3 *db;
+	sqlite3_stmt *select;					/* rows in sequence order */
+	int fd;										/* raw capture file */
+	ProtocolParser parser;
+	PayloadData frame;						/* keeps the absent sections */
+	uint8_t buffer[REPLAY_BUFFER_SIZE];
+	size_t filled;								/* bytes read into buffer */
+	size_t offset;								/* bytes fed into parser */
+	gint64 frames;								/* decoded capture frames */
+} ReplaySource;
+
+typedef struct _ReplayStats
+{
+	guint64 frames;							/* analyzed frames */
+	gint64 elapsed;							/* wall-clock time (us) */
+	gint64 recorded;							/* replayed session time (us) */
+	gint64 busy;								/* time in analysis (us) */
+	gint64 maxBusy;							/* slowest frame (us) */
+} ReplayStats;
 
 /*****************************************************************************/
 /*****************************************************************************/
@@ -391,6 +485,8 @@ typedef struct PACKED _PayloadData
 extern HeaderButton headerButton;
 extern CurrentPage currentPage;
 extern PayloadData payloadData;
+extern PayloadRing payloadRing;
+extern LogLevel logLevel;
 
 /* Microphone shared widgets and variables */
 
@@ -450,9 +546,11 @@ extern guint navTimeout;
 
 /* Signal analysis shared widgets and variables */
 
-extern DspTime sigSamples[MIC_COUNT];
 extern DspTime sigBeamformed;
 extern guint sigVolumest;
+extern double sigFrequency;
+extern int sigArrival;
+extern double sigPower[PIPELINE_SCAN_ANGLES];
 
 /*****************************************************************************/
 /*****************************************************************************/
@@ -481,6 +579,7 @@ extern void mic_plot_polar_frame(cairo_t *, int, int);
 extern void mic_plot_polar_label(cairo_t *, int, int);
 extern void mic_plot_polar_fill(cairo_t *, int, int, double, double);
 extern void mic_plot_polar_sector(cairo_t *, int, int, int);
+extern void mic_plot_polar_power(cairo_t *, int, int, const double *, int);
 
 /* AI Model function prototypes */
 
@@ -511,17 +610,22 @@ extern void gps_map_area_markers(ShumateMarkerLayer *, double, double);
 
 extern sqlite3 *db_open(const char *);
 extern void db_create_table(struct sqlite3 *, Database);
-extern void db_bind_data(struct sqlite3 *, Database);
+extern void db_migrate_table(struct sqlite3 *);
 extern void db_query_data(struct sqlite3 *, Database);
 extern void db_close(struct sqlite3 *);
+extern void db_recorder_open(DbRecorder *, const char *, const char *);
+extern void db_recorder_write(DbRecorder *, const PayloadData *);
+extern void db_recorder_commit(DbRecorder *, gboolean);
+extern void db_recorder_close(DbRecorder *);
+extern size_t db_pack_mics(const PayloadData *, int8_t *);
+extern gboolean db_unpack_mics(const void *, int, int, PayloadData *);
 
 /* Common utility function prototypes */
 
-extern void logging(const char *, size_t);
 extern char *get_time(const char *);
 extern int get_device_nodes(MicChannel);
 extern int open_device_node(MicChannel, const char *);
-extern void read_device_node(int);
+extern ssize_t read_device_node(int, uint8_t *, size_t);
 extern int get_model_datasets(void);
 extern void set_serial_attributes(int, struct termios *);
 extern int run_keras_script(const char *);
@@ -529,6 +633,28 @@ extern void abort_keras_script(int);
 extern int is_keras_script_running(int);
 extern char *get_keras_script_logs(const char *);
 
+/* Logger function prototypes */
+
+extern void logging(LogLevel, const char *, size_t);
+extern const char *log_level_name(LogLevel);
+extern void start_logger(const char *);
+extern void stop_logger(void);
+
+/* Acquisition function prototypes */
+
+extern gboolean ring_push(PayloadRing *, const PayloadData *);
+extern gboolean ring_pop(PayloadRing *, PayloadData *);
+extern void start_device_reader(int);
+extern void stop_device_reader(void);
+extern int drain_device_frames(PayloadData *, DbRecorder *);
+
+/* Replay function prototypes */
+
+extern void replay_open(ReplaySource *, const char *);
+extern gboolean replay_next(ReplaySource *, PayloadData *, gint64 *);
+extern void replay_close(ReplaySource *);
+extern void replay_run(const char *, double, ReplayStats *);
+
 /* Timeout utility function prototypes */
 
 extern gboolean timeout_device_node(gpointer);
@@ -558,12 +684,8 @@ extern GtkWidget *__generic_button_new(const char *, const char *);
 
 /* Signal analysis function prototypes */
 
-extern void convert_payload_to_sample(void);
-extern double find_dominant_freq(void);
-extern int calculate_arrival(double);
-extern DspTime do_beamforming(double, double);
 extern void make_signal_analysis(DspTime *, int);
-extern int select_sector(void);
+extern void analyze_payload(void);
 extern NavAccel select_accel_direction(void);
 extern NavGyro select_gyro_rotation(void);
 extern void update_nav_data(void);
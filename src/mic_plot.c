@@ -297,6 +297,51 @@ void mic_plot_polar_sector(cairo_t *cr, int width, int height, int mic)
 	}
 }
 
+/**
+ * Draw the steered power of `angles` look directions from the north as a
+ * closed curve, scaled to its loudest direction.
+ */
+void mic_plot_polar_power(cairo_t *cr, int width, int height, 
+								  const double *power, int angles)
+{
+	int i, center_x, center_y;
+	double radius, biggest = 0.0, length, compass;
+
+	center_x = width / 2;
+	center_y = height / 2;
+	radius = (height - 2 * MIC_PLOT_MARGIN) / 2;
+
+	for (i = 0; i < angles; i++)
+	{
+		biggest = (power[i] > biggest) ? power[i] : biggest;
+	}
+	if (biggest <= 0.0)
+	{
+		return;		/* nothing is scanned yet */
+	}
+
+	cairo_set_source_rgb(cr, 1.0, 0.0, 0.0);	/* red power curve */
+	cairo_set_line_width(cr, 2.0);
+
+	for (i = 0; i < angles; i++)
+	{
+		length = radius * power[i] / biggest;
+		compass = 2.0 * M_PI * i / angles;
+		if (i == 0)
+		{
+			cairo_move_to(cr, center_x + length * sin(compass),
+				center_y - length * cos(compass));
+		}
+		else
+		{
+			cairo_line_to(cr, center_x + length * sin(compass),
+				center_y - length * cos(compass));
+		}
+	}
+	cairo_close_path(cr);
+	cairo_stroke(cr);
+}
+
 /**
  * Draw the polar plot area.
  */
@@ -311,5 +356,7 @@ void mic_plot_polar(GtkDrawingArea *area, cairo_t *cr, int width,
 	mic_plot_polar_label(cr, width, height);	/* put the labels */
 	mic_plot_polar_sector(cr, width, height, 
 		sigVolumest);									/* fill the sector */
+	mic_plot_polar_power(cr, width, height, 
+		sigPower, PIPELINE_SCAN_ANGLES);				/* steered power */
 }
  
\ No newline at end of file
@@ -0,0 +1,461 @@
+/**
+ ******************************************************************************
+ * @file 	pipeline.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	GUI-free acoustic analysis pipeline of AeroSONAR.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "./pipeline.h"
+#include <stddef.h>
+
+/**
+ * Prepare the pipeline before its first frame. The `precision` selects the
+ * kernels of the spectral stages, MUSIC and the beamformer are double-only.
+ */
+void pipeline_init(Pipeline *pipeline, PipelinePrecision precision)
+{
+	assert (pipeline != NULL);
+	assert (precision == PIPELINE_FLOAT64 || precision == PIPELINE_FLOAT32);
+
+	/* Everything but the scratch, which is left to the arena. */
+	memset(pipeline, 0, offsetof(Pipeline, scratch));
+	dsp_arena_init(&pipeline->arena, pipeline->scratch, PIPELINE_ARENA_SIZE);
+	pipeline->precision = precision;
+}
+
+/**
+ * Track the covariance of MUSIC across the frames, instead of taking the
+ * arrival from each frame alone. The `forget` is the weight of previous
+ * frames and the subspace is decomposed again at each `refresh` frames.
+ * The frames must come in order.
+ */
+void pipeline_track(Pipeline *pipeline, double forget, int refresh)
+{
+	assert (pipeline != NULL);
+
+	dsp_music_tracker_init(&pipeline->tracker, forget, refresh);
+	pipeline->doa = PIPELINE_MUSIC_TRACK;
+}
+
+/**
+ * Take the arrival of angle with UCA-ESPRIT instead of MUSIC. It needs no
+ * angular grid, and falls back to MUSIC at the frequencies that the array
+ * can't resolve.
+ */
+void pipeline_esprit(Pipeline *pipeline)
+{
+	assert (pipeline != NULL);
+
+	pipeline->doa = PIPELINE_ESPRIT;
+}
+
+/**
+ * Take the arrival of angle with wideband SRP-PHAT instead of MUSIC. It
+ * doesn't use the dominant frequency, but sums the whole band of
+ * PIPELINE_BAND_LOW and PIPELINE_BAND_HIGH. The bins are summed on the
+ * `pool`, or serially if it's NULL. The pool may be shared by the
+ * pipelines that don't run at the same time.
+ */
+void pipeline_srp(Pipeline *pipeline, DspPool *pool)
+{
+	assert (pipeline != NULL);
+
+	pipeline->doa = PIPELINE_SRP_PHAT;
+	pipeline->pool = pool;
+}
+
+/**
+ * Take the arrival of angle from the GCC-PHAT delays of mic pairs instead
+ * of MUSIC. The bearing is fitted to the delays of all pairs, without the
+ * dominant frequency.
+ */
+void pipeline_tdoa(Pipeline *pipeline)
+{
+	assert (pipeline != NULL);
+
+	pipeline->doa = PIPELINE_GCC_PHAT;
+}
+
+/**
+ * Beamform toward the arrival with MVDR instead of delay-and-sum. The
+ * covariance is loaded on the diagonal by `loading` times the mean power
+ * of mics. It's the one of MUSIC tracker if there is one, so the frame
+ * doesn't build it twice. A silent frame without loading falls back to
+ * delay-and-sum.
+ */
+void pipeline_mvdr(Pipeline *pipeline, double loading)
+{
+	assert (pipeline != NULL && loading >= 0.0);
+
+	pipeline->beam = PIPELINE_MVDR;
+	pipeline->loading = loading;
+}
+
+/**
+ * Limit the mic channels to the band of PIPELINE_BAND_LOW and
+ * PIPELINE_BAND_HIGH with the Butterworth filters of even `order` at each
+ * edge. The sections keep their state across the frames, so the frames
+ * must come in order.
+ */
+void pipeline_band(Pipeline *pipeline, int order)
+{
+	assert (pipeline != NULL);
+
+	dsp_sos_init(&pipeline->band, MIC_COUNT);
+	dsp_sos_butterworth(&pipeline->band, DSP_FILTER_HIGH_PASS, order,
+		PIPELINE_BAND_LOW, MIC_SAMPLE_FREQ);
+	dsp_sos_butterworth(&pipeline->band, DSP_FILTER_LOW_PASS, order,
+		PIPELINE_BAND_HIGH, MIC_SAMPLE_FREQ);
+}
+
+/**
+ * Convert the mic channels of frame to 'DspTime' objects.
+ */
+void pipeline_load_samples(Pipeline *pipeline, const PayloadData *frame)
+{
+	int i, j;
+	const int8_t *channels[MIC_COUNT] = {
+		frame->micNorth, frame->micNorthEast, frame->micEast,
+		frame->micSouthEast, frame->micSouth, frame->micSouthWest,
+		frame->micWest, frame->micNorthWest
+	};
+
+	assert (pipeline != NULL && frame != NULL);
+
+	for (i = 0; i < MIC_COUNT; i++)
+	{
+		pipeline->samples[i].length = PIPELINE_DATA_SIZE;
+		for (j = 0; j < PIPELINE_DATA_SIZE; j++)
+		{
+			pipeline->samples[i].data[j] = (double) channels[i][j];
+		}
+	}
+}
+
+/**
+ * Return the frequency of the biggest bin of mic spectrums in double.
+ */
+static double __dominant_freq_f64(Pipeline *pipeline)
+{
+	int i;
+	len_t k, index;
+	double power, biggest, freq, maxFreq = 0.0;
+	DspTimeView samples[MIC_COUNT];
+	DspFreqView spectrums[MIC_COUNT];
+
+	for (i = 0; i < MIC_COUNT; i++)
+	{
+		samples[i] = dsp_time_view_of(&pipeline->samples[i]);
+		spectrums[i] = dsp_freq_view_new(&pipeline->arena,
+			PIPELINE_DATA_SIZE / 2 + 1);
+	}
+
+	/* Convert the time domain signals into frequency domain. The mic
+		channels are real, so only the half spectrums are computed. */
+	dsp_view_rfft_batch(samples, MIC_COUNT, spectrums, &pipeline->arena);
+
+	/* Find the maximum frequencies and corresponding bins. The squared
+		magnitudes peak at the same bin, and the DC bias is passed. */
+	for (i = 0; i < MIC_COUNT; i++)
+	{
+		index = 0;
+		biggest = 0.0;
+		for (k = 1; k < spectrums[i].length; k++)
+		{
+			power = spectrums[i].data[k][0] * spectrums[i].data[k][0] +
+				spectrums[i].data[k][1] * spectrums[i].data[k][1];
+			if (power > biggest)
+			{
+				biggest = power;
+				index = k;
+			}
+		}
+		freq = (double) MIC_SAMPLE_FREQ / PIPELINE_DATA_SIZE * index;
+		if (freq > maxFreq)
+		{
+			maxFreq = freq;
+		}
+	}
+	return maxFreq;
+}
+
+/**
+ * Return the frequency of the biggest bin of mic spectrums in float.
+ */
+static double __dominant_freq_f32(Pipeline *pipeline)
+{
+	int i;
+	len_t k, index;
+	float power, biggest;
+	double freq, maxFreq = 0.0;
+	DspTimeViewF32 samples[MIC_COUNT];
+	DspFreqViewF32 spectrums[MIC_COUNT];
+
+	/* The int8 channels are exact in float, so the same samples are
+		transformed with half of the memory traffic. */
+	for (i = 0; i < MIC_COUNT; i++)
+	{
+		samples[i] = dsp_time_view_f32_new(&pipeline->arena,
+			PIPELINE_DATA_SIZE);
+		dsp_time_f32_from_double(&pipeline->samples[i], &samples[i]);
+		spectrums[i] = dsp_freq_view_f32_new(&pipeline->arena,
+			PIPELINE_DATA_SIZE / 2 + 1);
+	}
+	dsp_view_rfft_batch_f32(samples, MIC_COUNT, spectrums, &pipeline->arena);
+
+	for (i = 0; i < MIC_COUNT; i++)
+	{
+		index = 0;
+		biggest = 0.0f;
+		for (k = 1; k < spectrums[i].length; k++)
+		{
+			power = spectrums[i].data[k][0] * spectrums[i].data[k][0] +
+				spectrums[i].data[k][1] * spectrums[i].data[k][1];
+			if (power > biggest)
+			{
+				biggest = power;
+				index = k;
+			}
+		}
+		freq = (double) MIC_SAMPLE_FREQ / PIPELINE_DATA_SIZE * index;
+		if (freq > maxFreq)
+		{
+			maxFreq = freq;
+		}
+	}
+	return maxFreq;
+}
+
+/**
+ * Find the dominant frequency around the mic outputs.
+ */
+double pipeline_dominant_freq(Pipeline *pipeline)
+{
+	double freq;
+
+	assert (pipeline != NULL);
+
+	/* The spectrums only live for this call, the wideband stages take
+		their own ones from the same arena. */
+	dsp_arena_reset(&pipeline->arena);
+
+	if (pipeline->precision == PIPELINE_FLOAT32)
+	{
+		freq = __dominant_freq_f32(pipeline);
+	}
+	else
+	{
+		freq = __dominant_freq_f64(pipeline);
+	}
+	dsp_arena_reset(&pipeline->arena);
+
+	return freq;
+}
+
+/**
+ * Calculate the arrival of angle from coming signals.
+ */
+int pipeline_arrival(Pipeline *pipeline, double freq)
+{
+	int i;
+	DspArrival arrival;
+	DspDirection direction;
+
+	assert (pipeline != NULL);
+
+	arrival.mics = MIC_COUNT;
+	arrival.freq = freq;
+	arrival.radius = MIC_RADIUS;
+	arrival.sources = 1;
+	for (i = 0; i < MIC_COUNT; i++)
+	{
+		arrival.samples[i] = &pipeline->samples[i];
+	}
+	switch (pipeline->doa)
+	{
+		case PIPELINE_MUSIC_TRACK:
+			return dsp_arrival_music_track(&pipeline->tracker, &arrival);
+		case PIPELINE_ESPRIT:
+			if (dsp_arrival_esprit(&arrival, MIC_SAMPLE_FREQ, &direction) > 0)
+			{
+				return (int) lround(direction.azimuth) % 360;
+			}
+			break;
+		case PIPELINE_SRP_PHAT:
+			/* The bins of whole band need the whole arena. */
+			dsp_arena_reset(&pipeline->arena);
+			return (int) lround(dsp_arrival_srp_phat(&arrival, MIC_SAMPLE_FREQ,
+				PIPELINE_BAND_LOW, PIPELINE_BAND_HIGH, pipeline->pool,
+				&pipeline->arena)) % 360;
+		case PIPELINE_GCC_PHAT:
+			/* The cross spectrums of all pairs need the whole arena. */
+			dsp_arena_reset(&pipeline->arena);
+			dsp_tdoa_gcc_phat(&arrival, MIC_SAMPLE_FREQ, &pipeline->tdoa,
+				&pipeline->arena);
+			if (dsp_arrival_tdoa(&pipeline->tdoa, MIC_RADIUS, &direction))
+			{
+				return (int) lround(direction.azimuth) % 360;
+			}
+			break;
+		default:
+			break;
+	}
+	return dsp_arrival_music(&arrival);
+}
+
+/**
+ * Make the delay-and-sum beamforming, or MVDR if it's selected.
+ */
+void pipeline_beamform(Pipeline *pipeline, double freq, double arrival,
+	DspTime *result)
+{
+	int i;
+	len_t k;
+	DspBeamform beamform;
+	DspArrival frame;
+	DspMvdr mvdr;
+	double covariance[MAX_MICS][MAX_MICS];
+
+	assert (pipeline != NULL && result != NULL);
+
+	beamform.mics = MIC_COUNT;
+	beamform.freq = freq;
+	beamform.radius = MIC_RADIUS;
+	beamform.theta = arrival;
+	for (i = 0; i < MIC_COUNT; i++)
+	{
+		beamform.samples[i] = &pipeline->samples[i];
+	}
+	if (pipeline->beam == PIPELINE_MVDR)
+	{
+		/* The tracker has blended this frame into its covariance already. */
+		if (pipeline->doa == PIPELINE_MUSIC_TRACK)
+		{
+			memcpy(covariance, pipeline->tracker.covariance, sizeof(covariance));
+		}
+		else
+		{
+			frame.mics = MIC_COUNT;
+			frame.radius = MIC_RADIUS;
+			frame.freq = freq;
+			frame.sources = 1;
+			for (i = 0; i < MIC_COUNT; i++)
+			{
+				frame.samples[i] = &pipeline->samples[i];
+			}
+			dsp_covariance(&frame, covariance);
+		}
+		if (dsp_mvdr_init(&mvdr, MIC_COUNT,
+			(const double (*)[MAX_MICS]) covariance, pipeline->loading))
+		{
+			dsp_beamform_capon(&beamform, &mvdr, MIC_SAMPLE_FREQ, result,
+				&pipeline->arena);
+
+			/* The same amplitude as the sum of delay-and-sum. */
+			for (k = 0; k < result->length; k++)
+			{
+				result->data[k] *= MIC_COUNT;
+			}
+			return;
+		}
+	}
+	dsp_beamform_delay_sum(&beamform, result);
+}
+
+/**
+ * Scan the steered power of the band of PIPELINE_BAND_LOW and
+ * PIPELINE_BAND_HIGH over the whole circle into `power` of the pipeline,
+ * for the polar plot. Return the index of the loudest direction, which
+ * gives the sector.
+ */
+int pipeline_scan(Pipeline *pipeline)
+{
+	int i;
+	DspArrival arrival;
+
+	assert (pipeline != NULL);
+
+	arrival.mics = MIC_COUNT;
+	arrival.freq = pipeline->frequency;
+	arrival.radius = MIC_RADIUS;
+	arrival.sources = 1;
+	for (i = 0; i < MIC_COUNT; i++)
+	{
+		arrival.samples[i] = &pipeline->samples[i];
+	}
+	return dsp_beam_scan(&arrival, MIC_SAMPLE_FREQ, PIPELINE_BAND_LOW,
+		PIPELINE_BAND_HIGH, PIPELINE_SCAN_ANGLES, pipeline->power,
+		&pipeline->arena);
+}
+
+/**
+ * Return the sector of the loudest direction of the last scan. The
+ * sectors are centered on the mics, from the north clockwise.
+ */
+int pipeline_sector(const Pipeline *pipeline)
+{
+	int i, loudest = 0;
+	double bearing;
+
+	assert (pipeline != NULL);
+
+	for (i = 1; i < PIPELINE_SCAN_ANGLES; i++)
+	{
+		loudest = (pipeline->power[i] > pipeline->power[loudest]) ? i : loudest;
+	}
+	bearing = 360.0 * loudest / PIPELINE_SCAN_ANGLES;
+
+	return (int) lround(bearing * MIC_COUNT / 360.0) % MIC_COUNT + 1;
+}
+
+/**
+ * Run the whole signal chain on the frame.
+ */
+void pipeline_run(Pipeline *pipeline, const PayloadData *frame)
+{
+	int i;
+	DspTimeView beamformed, channels[MIC_COUNT];
+
+	pipeline_load_samples(pipeline, frame);
+	if (pipeline->band.sections > 0)
+	{
+		for (i = 0; i < MIC_COUNT; i++)
+		{
+			channels[i] = dsp_time_view_of(&pipeline->samples[i]);
+		}
+		dsp_sos_process(&pipeline->band, channels, channels);
+	}
+
+	pipeline->frequency = pipeline_dominant_freq(pipeline);
+	pipeline->arrival = pipeline_arrival(pipeline, pipeline->frequency);
+	pipeline_beamform(pipeline, pipeline->frequency, pipeline->arrival,
+		&pipeline->beamformed);
+	pipeline_scan(pipeline);
+	pipeline->sector = pipeline_sector(pipeline);
+
+	/* Make sure the amplitude of signal fits into the frame. */
+	beamformed = dsp_time_view_of(&pipeline->beamformed);
+	dsp_view_scale(&beamformed, PIPELINE_SCALE, &beamformed);
+}
+
+/**
+ * Calculate the statistics of the sample.
+ */
+void pipeline_stats(const DspTime *sample, PipelineStats *stats)
+{
+	assert (sample != NULL && stats != NULL);
+
+	/* A single pass replaces the eleven dsp_time_*() scans. It also has
+		the energy right, dsp_time_energy() doesn't clear its sum. */
+	dsp_time_moments(sample, stats);
+}
@@ -0,0 +1,129 @@
+/**
+ ******************************************************************************
+ * @file 	pipeline.h
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	GUI-free acoustic analysis pipeline of AeroSONAR.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Standard C Libraries */
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+/* Custom DSP Library */
+
+#include "./dsp/dsp_ext.h"
+#include "../common/payload.h"
+
+/*	The signal chain of a microphone frame, from the raw samples to the
+	beamformed signal. It doesn't depend on GTK, so both the ground station
+	and the headless CLI link it. Each `Pipeline` object keeps its own
+	buffers, so a thread per object can analyze the frames in parallel. */
+
+/* User-defined Constants */
+
+#define MIC_COUNT								PAYLOAD_MIC_COUNT
+#define MIC_RADIUS							0.1		/* 0.1 meter */
+#define MIC_SAMPLE_FREQ						12000		/* 12kHz */
+#define PIPELINE_DATA_SIZE					PAYLOAD_MIC_SIZE
+#define PIPELINE_SCALE						128.0		/* beamformed amplitude */
+#define PIPELINE_ARENA_SIZE				65536		/* scratch bytes per frame */
+#define PIPELINE_BAND_LOW					200.0		/* Hz, band of wideband methods */
+#define PIPELINE_BAND_HIGH					3000.0	/* Hz */
+#define PIPELINE_SCAN_ANGLES				72			/* look directions, 5 degrees */
+#define PIPELINE_MVDR_LOADING				0.05		/* of the mean mic power */
+
+/* User-defined Enumerations */
+
+typedef enum _PipelinePrecision
+{
+	PIPELINE_FLOAT64,							/* double kernels */
+	PIPELINE_FLOAT32							/* single-precision kernels */
+} PipelinePrecision;
+
+typedef enum _PipelineDoa
+{
+	PIPELINE_MUSIC,							/* MUSIC of each frame */
+	PIPELINE_MUSIC_TRACK,					/* MUSIC over the previous frames */
+	PIPELINE_ESPRIT,							/* closed-form UCA-ESPRIT */
+	PIPELINE_SRP_PHAT,						/* wideband steered power */
+	PIPELINE_GCC_PHAT							/* delays of the mic pairs */
+} PipelineDoa;
+
+typedef enum _PipelineBeam
+{
+	PIPELINE_DELAY_SUM,						/* delay-and-sum of library */
+	PIPELINE_MVDR								/* Capon on the MUSIC covariance */
+} PipelineBeam;
+
+/* User-defined Structures */
+
+/* The statistics of beamformed signal are computed in one pass. */
+
+typedef DspMoments PipelineStats;
+
+typedef struct _Pipeline
+{
+	/* The mic channels and beamformed signal are passed to MUSIC and the
+		beamformer of DSP library, so they keep the fixed-size objects. The
+		other buffers of a frame are taken from the arena. */
+
+	DspTime samples[MIC_COUNT];			/* mic channels of frame */
+	DspTime beamformed;						/* scaled by PIPELINE_SCALE */
+	PipelinePrecision precision;			/* kernels of spectral stages */
+	PipelineDoa doa;							/* method of arrival of angle */
+	PipelineBeam beam;						/* beamformer toward the arrival */
+	double loading;							/* diagonal loading of MVDR */
+	DspMusicTracker tracker;				/* covariance and subspace */
+	DspPool *pool;								/* bins of SRP-PHAT, or NULL */
+	DspTdoa tdoa;								/* delays of the last frame */
+	DspSos band;								/* band limiting, if sections */
+	double frequency;							/* dominant frequency in Hz */
+	int arrival;								/* arrival of angle in degrees */
+	int sector;									/* loudest sector, 1 to 8 */
+	double power[PIPELINE_SCAN_ANGLES];	/* steered power from north */
+	DspArena arena;							/* reset at each frame */
+	_Alignas(DSP_ARENA_ALIGN) unsigned char scratch[PIPELINE_ARENA_SIZE];
+} Pipeline;
+
+/* Pipeline Methods */
+
+extern void pipeline_init(Pipeline *pipeline, PipelinePrecision precision);
+extern void pipeline_load_samples(Pipeline *pipeline, const PayloadData *frame);
+extern double pipeline_dominant_freq(Pipeline *pipeline);
+extern void pipeline_track(Pipeline *pipeline, double forget, int refresh);
+extern void pipeline_esprit(Pipeline *pipeline);
+extern void pipeline_srp(Pipeline *pipeline, DspPool *pool);
+extern void pipeline_tdoa(Pipeline *pipeline);
+extern void pipeline_mvdr(Pipeline *pipeline, double loading);
+extern void pipeline_band(Pipeline *pipeline, int order);
+extern int pipeline_arrival(Pipeline *pipeline, double freq);
+extern void pipeline_beamform(Pipeline *pipeline, double freq, double arrival, DspTime *result);
+extern int pipeline_scan(Pipeline *pipeline);
+extern int pipeline_sector(const Pipeline *pipeline);
+extern void pipeline_run(Pipeline *pipeline, const PayloadData *frame);
+extern void pipeline_stats(const DspTime *sample, PipelineStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PIPELINE_H */
@@ -0,0 +1,272 @@
+/**
+ ******************************************************************************
+ * @file 	replay.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Offline replay of the recorded sessions of AeroSONAR.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include "main.h"
+
+/*	A replay source is either:
+
+		+ a sensor database	--> the frames that the recorder wrote
+		+ a raw capture		--> the framed byte stream of device node,
+										e.g. 'cat /dev/ttyUSB0 > flight.cap'
+
+	The database rows have their receive times. The raw capture doesn't, so
+	its frames are paced by REPLAY_CAPTURE_PERIOD. */
+
+#define REPLAY_SQLITE_MAGIC				"SQLite format 3"
+
+/**
+ * Open the sensor database for replay.
+ */
+static void __replay_open_database(ReplaySource *source, const char *path)
+{
+	int rc;
+
+	rc = sqlite3_open_v2(path, &source->db, SQLITE_OPEN_READONLY, NULL);
+	if (rc != SQLITE_OK)
+		dbError(source->db);
+
+	rc = sqlite3_prepare_v2(source->db, "SELECT Received, MicEncoding, "
+		"Microphones, AccelX, AccelY, AccelZ, GyroX, GyroY, GyroZ, "
+		"Temperature, UTCTime, Latitude, Longitude, Quality, NumSat, Altitude, "
+		"Status, Speed, Course, Date FROM " DB_SENSOR_DATA_TABLE
+		" ORDER BY Sequence;", -1, &source->select, 0);
+	if (rc != SQLITE_OK)
+		dbError(source->db);
+}
+
+/**
+ * Open the replay source. The kind of file is found from its content.
+ */
+void replay_open(ReplaySource *source, const char *path)
+{
+	char magic[16] = {0};
+
+	memset(source, 0, sizeof(ReplaySource));
+	source->fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (source->fd == -1)
+		syscallError();
+
+	if (read(source->fd, magic, sizeof(magic)) == -1)
+		syscallError();
+
+	if (memcmp(magic, REPLAY_SQLITE_MAGIC, sizeof(REPLAY_SQLITE_MAGIC)) == 0)
+	{
+		if (close(source->fd) == -1)
+			syscallError();
+
+		source->fd = -1;
+		source->kind = REPLAY_DATABASE;
+		__replay_open_database(source, path);
+	}
+	else
+	{
+		if (lseek(source->fd, 0, SEEK_SET) == -1)
+			syscallError();
+
+		source->kind = REPLAY_CAPTURE;
+		protocol_parser_init(&source->parser);
+	}
+	printLog("opened the replay of '%s' (%s)", path,
+		(source->kind == REPLAY_DATABASE) ? "database" : "raw capture");
+}
+
+/**
+ * Copy the text column into GPS field, NULL becomes an empty text.
+ */
+static void __replay_gps(sqlite3_stmt *stmt, int column, char *text)
+{
+	const unsigned char *value;
+
+	value = sqlite3_column_text(stmt, column);
+	snprintf(text, PAYLOAD_GPS_SIZE, "%s", (value != NULL) ? (const char *) value : "");
+}
+
+/**
+ * Read the next row of database into `frame`.
+ */
+static gboolean __replay_next_row(ReplaySource *source, PayloadData *frame,
+	gint64 *time)
+{
+	int rc;
+	sqlite3_stmt *stmt = source->select;
+
+	while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+	{
+		if (!db_unpack_mics(sqlite3_column_blob(stmt, 2),
+				sqlite3_column_bytes(stmt, 2), sqlite3_column_int(stmt, 1), frame))
+		{
+			printWarning("skipped a row with malformed microphones");
+			continue;
+		}
+		*time = sqlite3_column_int64(stmt, 0);
+
+		frame->imuAccelX = sqlite3_column_double(stmt, 3);
+		frame->imuAccelY = sqlite3_column_double(stmt, 4);
+		frame->imuAccelZ = sqlite3_column_double(stmt, 5);
+		frame->imuGyroX = sqlite3_column_double(stmt, 6);
+		frame->imuGyroY = sqlite3_column_double(stmt, 7);
+		frame->imuGyroZ = sqlite3_column_double(stmt, 8);
+		frame->imuTemp = sqlite3_column_double(stmt, 9);
+
+		__replay_gps(stmt, 10, frame->gpsUTCTime);
+		__replay_gps(stmt, 11, frame->gpsLatitude);
+		__replay_gps(stmt, 12, frame->gpsLongitude);
+		__replay_gps(stmt, 13, frame->gpsQuality);
+		__replay_gps(stmt, 14, frame->gpsNumSat);
+		__replay_gps(stmt, 15, frame->gpsAltitude);
+		__replay_gps(stmt, 16, frame->gpsStatus);
+		__replay_gps(stmt, 17, frame->gpsSpeed);
+		__replay_gps(stmt, 18, frame->gpsCourse);
+		__replay_gps(stmt, 19, frame->gpsDate);
+
+		return TRUE;
+	}
+	if (rc != SQLITE_DONE)
+		dbError(source->db);
+
+	return FALSE;
+}
+
+/**
+ * Parse the next valid frame of raw capture into `frame`.
+ */
+static gboolean __replay_next_frame(ReplaySource *source, PayloadData *frame,
+	gint64 *time)
+{
+	ssize_t numRead;
+	ProtocolFrame parsed;
+
+	for (;;)
+	{
+		while (protocol_parser_next(&source->parser, &parsed))
+		{
+			if (payload_decode(parsed.payload, parsed.length, &source->frame) < 0)
+			{
+				printWarning("skipped a malformed payload of %u bytes",
+					parsed.length);
+				continue;
+			}
+			memcpy(frame, &source->frame, sizeof(PayloadData));
+			*time = source->frames++ * REPLAY_CAPTURE_PERIOD * 1000;
+
+			return TRUE;
+		}
+		if (source->offset < source->filled)
+		{
+			/* Feed the rest of buffer that the parser didn't take yet. */
+			source->offset += protocol_parser_feed(&source->parser,
+				source->buffer + source->offset, source->filled - source->offset);
+			continue;
+		}
+		numRead = read(source->fd, source->buffer, sizeof(source->buffer));
+		if (numRead == -1)
+		{
+			if (errno == EINTR)
+				continue;
+			syscallError();
+		}
+		if (numRead == 0)
+		{
+			return FALSE;		/* end of capture */
+		}
+		source->filled = numRead;
+		source->offset = 0;
+	}
+}
+
+/**
+ * Read the next frame of replay and its receive time in microseconds.
+ * Return FALSE at the end of source.
+ */
+gboolean replay_next(ReplaySource *source, PayloadData *frame, gint64 *time)
+{
+	if (source->kind == REPLAY_DATABASE)
+	{
+		return __replay_next_row(source, frame, time);
+	}
+	return __replay_next_frame(source, frame, time);
+}
+
+/**
+ * Close the replay source.
+ */
+void replay_close(ReplaySource *source)
+{
+	if (source->kind == REPLAY_DATABASE)
+	{
+		sqlite3_finalize(source->select);
+		db_close(source->db);
+	}
+	else if (close(source->fd) == -1)
+	{
+		syscallError();
+	}
+	source->db = NULL;
+	source->select = NULL;
+	source->fd = -1;
+}
+
+/**
+ * Replay the recorded session through the analysis pipeline. The `speed`
+ * is the multiple of real-time, 0 runs as fast as possible.
+ */
+void replay_run(const char *path, double speed, ReplayStats *stats)
+{
+	static ReplaySource source;
+	gint64 time, lastTime = 0, gap, started, remaining, before, busy;
+
+	memset(stats, 0, sizeof(ReplayStats));
+	replay_open(&source, path);
+
+	started = g_get_monotonic_time();
+	while (replay_next(&source, &payloadData, &time))
+	{
+		/* The idle time between the recorded sessions isn't replayed. */
+		gap = (stats->frames > 0) ? time - lastTime : 0;
+		stats->recorded += CLAMP(gap, 0, REPLAY_MAX_GAP * 1000);
+		lastTime = time;
+
+		/* Wait for the receive time of frame at the given speed. */
+		if (speed > 0.0)
+		{
+			remaining = started + (gint64) (stats->recorded / speed) -
+				g_get_monotonic_time();
+			if (remaining > 0)
+			{
+				g_usleep(remaining);
+			}
+		}
+		before = g_get_monotonic_time();
+		analyze_payload();
+		busy = g_get_monotonic_time() - before;
+
+		stats->busy += busy;
+		stats->maxBusy = MAX(stats->maxBusy, busy);
+		stats->frames++;
+		printDebug("replayed a frame (%.1f Hz, %d degrees, sector %u)",
+			sigFrequency, sigArrival, sigVolumest);
+	}
+	stats->elapsed = g_get_monotonic_time() - started;
+	replay_close(&source);
+
+	printLog("replayed %" G_GUINT64_FORMAT " frames in %.3f s "
+		"(%.1f frames/s, %.1fx real-time, %.1f us mean and %" G_GINT64_FORMAT
+		" us max analysis)", stats->frames, stats->elapsed / 1e6,
+		stats->frames / MAX(stats->elapsed / 1e6, 1e-9),
+		stats->recorded / (double) MAX(stats->elapsed, 1),
+		stats->busy / (double) MAX(stats->frames, 1), stats->maxBusy);
+}
@@ -355,7 +355,7 @@ void on_output_model_texted(GObject *gobject, GParamSpec *pspec, gpointer data)
 void on_mic_button_clicked(GtkButton *button, gpointer data)
 {
 	const char *label;
-	static sqlite3 *db = NULL;
+	static DbRecorder recorder = {0};
 	static int deviceFd = -1;
 
 	label = gtk_button_get_label(button);
@@ -384,35 +384,40 @@ void on_mic_button_clicked(GtkButton *button, gpointer data)
 		/* Open the selected device node. */
 		deviceFd = open_device_node(micChannel, micDeviceNode);
 
-		/* Open the 'sensor_data.db' database. */
-		db = db_open(DB_SENSOR_DATA_PATH);
-		db_create_table(db, DATABASE_SENSOR_DATA);
+		/* Open the 'sensor_data.db' database to record every frame. */
+		db_recorder_open(&recorder, DB_SENSOR_DATA_PATH, DB_SYNCHRONOUS);
+
+		/* Start reading the device node on its own thread. */
+		start_device_reader(deviceFd);
 
 		/* Add the timeout for updating "payloadData". */
 		if (!micTimeout) 
 		{
 			micTimeout = g_timeout_add(TIMEOUT_DEVICE_READ, 
-				timeout_device_node, GINT_TO_POINTER(deviceFd));
+				timeout_device_node, (gpointer) &recorder);
 		}
-		/* Add the timeout for recording sensor data into database. */
+		/* Add the timeout for committing the recorded sensor data. */
 		if (!recordTimeout)
 		{
 			recordTimeout = g_timeout_add(TIMEOUT_DATA_RECORD,
-				timeout_db_record, (gpointer) db);
+				timeout_db_record, (gpointer) &recorder);
 		}
 	} 
 	else if (micButton == MIC_BUTTON_STOP) 
 	{
-		/* Close the open database. */
-		if (db != NULL)
-		{
-			db_close(db);
-		}
-		/* Close also the open device node. */
+		/* Stop the reader first, so no frame comes after the last drain. */
+		stop_device_reader();
+		/* Drain the frames left in the ring into the recorder. */
+		timeout_device_node((gpointer) &recorder);
+		/* Commit the pending rows and close the open database. */
+		db_recorder_close(&recorder);
+		/* Close the open device node. */
 		if (deviceFd != -1)
 		{
 			if (close(deviceFd) == -1)
 			syscallError();
+
+			deviceFd = -1;
 		}
 
 		/* Stop the timeout for "payloadData". */
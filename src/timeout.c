@@ -18,38 +18,27 @@
 #include "main.h"
 
 /**
- * Set the timeout to get the device data simultenously.
+ * Set the timeout to analyze the device data simultenously.
  */
 gboolean timeout_device_node(gpointer data)
 {
-	double max_freq;
-	int arrival;
-	int deviceFd;
-
-	/* Read the device node to update 'payloadData' object. */
-	deviceFd = GPOINTER_TO_INT(data);
-	read_device_node(deviceFd);
-
-	/* Prepare the collected data for signal analysis. */
-	convert_payload_to_sample();
-
-	/* Extract the required calculations in here. */
-	max_freq = find_dominant_freq();
-	arrival = calculate_arrival(max_freq);
-	sigBeamformed = do_beamforming(max_freq, arrival);
-	sigVolumest = select_sector();
+	/* Take the latest frame that the reader thread received. */
+	if (drain_device_frames(&payloadData, (DbRecorder *) data) == 0)
+	{
+		return G_SOURCE_CONTINUE;	/* there is no new frame */
+	}
 
-	/* Make sure the amplitude of signal fits into the frame. */
-	dsp_time_scale(&sigBeamformed, 128.0, &sigBeamformed);
+	/* Run the analysis pipeline on the frame. */
+	analyze_payload();
 
 	/* Make the signal analysis. */
-	make_signal_analysis(&sigBeamformed, arrival);
-	printLog("completed the signal analysis operations");
+	make_signal_analysis(&sigBeamformed, sigArrival);
+	printDebug("completed the signal analysis operations");
 
 	/* Lastly, redraw the cartesian and polar plots. */
 	gtk_widget_queue_draw(micCarPlot);
 	gtk_widget_queue_draw(micPolarPlot);
-	printLog("requested the plot redraws");
+	printDebug("requested the plot redraws");
 
 	return G_SOURCE_CONTINUE;
 }
@@ -78,15 +67,12 @@ gboolean timeout_model_keras_log(gpointer data)
 }
 
 /**
- * Set the timeout to record the sensor data into database.
+ * Set the timeout to commit the recorded rows when frames stop arriving.
  */
 gboolean timeout_db_record(gpointer data)
 {
-	sqlite3 *db;
-
-	db = (sqlite3 *) data;
-	/* Bind the last sensor data. */
-	db_bind_data(db, DATABASE_SENSOR_DATA);
+	/* Commit the open transaction if it is old enough. */
+	db_recorder_commit((DbRecorder *) data, FALSE);
 
 	return G_SOURCE_CONTINUE;
 }
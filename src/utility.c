@@ -17,34 +17,12 @@
 
 #include "main.h"
 
-/**
- * Write the system logs into required file.
- */
-void logging(const char* buffer, size_t size)
-{
-	int fd;
-
-	fd = open(SYSTEM_LOG_PATH, O_WRONLY | O_APPEND);
-	if (fd == -1)
-		syscallError();
-
-	if (write(fd, buffer, size) == -1)	/* write the logs. */
-		syscallError();
-	
-	/* Make sure that each log is explicitly written. */
-	if (fsync(fd) == -1)
-		syscallError();
-
-	if (close(fd) == -1)
-		syscallError();
-}
-
 /**
  * Get the current time to show with handlers.
  */
 char *get_time(const char* format)
 {
-	static char buffer[64];
+	static _Thread_local char buffer[64];	/* printLog() runs on threads */
 	time_t t;
 	struct tm *tm;
 	
@@ -192,39 +170,22 @@ int open_device_node(MicChannel channel, const char *node)
 }
 
 /**
- * Read the selected channel's device node.
+ * Read the available bytes of the device node without blocking.
  */
-void read_device_node(int fd)
+ssize_t read_device_node(int fd, uint8_t *buffer, size_t size)
 {
-	ssize_t numRead, totalRead;
-	uint8_t *payloadPtr;
-	long payloadSize;
-
-	/* Initialize with NULLs. */
-	memset(&payloadData, 0, sizeof(payloadData));
-
-	payloadPtr = (uint8_t *) &payloadData;
-	payloadSize = sizeof(payloadData);
-	totalRead = 0;
-	/* Read the device node simulatenously. If the received data is 
-		bigger than kernel buffer size (defaultly, 4096 bytes), loop 
-		the read operations. */
-	while (totalRead < payloadSize)
+	ssize_t numRead;
+
+	numRead = read(fd, buffer, size);
+	if (numRead == -1) 
 	{
-		numRead = read(fd, payloadPtr+totalRead, payloadSize-totalRead);
-		if (numRead > 0) 
-		{
-			totalRead += numRead;
-			printLog("read %ld bytes from the node", numRead);
-		} 
-		else if (numRead == -1) 
-		{
-			if (errno != EAGAIN && errno != EWOULDBLOCK)
-				syscallError(); 
-				/* EAGAIN is normal (no data at this cycle) */
-		}
+		/* EAGAIN is normal (no data at this cycle) */
+		if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+			syscallError(); 
+
+		numRead = 0;
 	}
-	printLog("read total %ld bytes from the associated node", totalRead);
+	return numRead;
 }
 
 /**
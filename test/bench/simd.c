@@ -0,0 +1,127 @@
+/**
+ ******************************************************************************
+ * @file 	simd.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Benchmark of SIMD elementwise kernels against the scalar ones.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#define _GNU_SOURCE
+#include <time.h>
+#include "../../src/dsp/dsp_ext.h"
+
+#define BENCH_LENGTH							512		/* samples of a mic frame */
+#define BENCH_MIN_TIME							0.2		/* seconds per kernel */
+#define BENCH_KERNELS							8
+
+static DspTime fsample, ssample, output, window;
+static DspFreq spectrum;
+static DspTimeView fview, sview, result;
+static DspFreqView bins;
+
+static const char *kernels[BENCH_KERNELS] = {
+	"add", "dot_mul", "scalar_mul", "scale", "abs", "clip", "window",
+	"magnitude"
+};
+
+/**
+ * Return the seconds of monotonic clock.
+ */
+static double __seconds(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * Run the kernel of given index once.
+ */
+static void __run(int kernel)
+{
+	switch (kernel)
+	{
+		case 0: dsp_view_add(&fview, &sview, &result); break;
+		case 1: dsp_view_dot_mul(&fview, &sview, &result); break;
+		case 2: dsp_view_scalar_mul(&fview, 0.5, &result); break;
+		case 3: dsp_view_scale(&fview, 128.0, &result); break;
+		case 4: dsp_view_abs(&fview, &result); break;
+		case 5: dsp_view_clip(&fview, -0.5, 0.5, &result); break;
+		case 6: dsp_view_window(&fview, window.data, &result); break;
+		default: dsp_view_magnitude(&bins, &result); break;
+	}
+}
+
+/**
+ * Return the nanoseconds per call of the kernel.
+ */
+static double __measure(int kernel)
+{
+	long i, calls = 1024;
+	double started, elapsed;
+
+	for (;;)
+	{
+		started = __seconds();
+		for (i = 0; i < calls; i++)
+		{
+			__run(kernel);
+		}
+		elapsed = __seconds() - started;
+		if (elapsed >= BENCH_MIN_TIME)
+		{
+			return elapsed / calls * 1e9;
+		}
+		calls *= 2;
+	}
+}
+
+int main(void)
+{
+	int level, kernel;
+	DspSimdLevel best;
+	double scalar[BENCH_KERNELS], ns;
+
+	dsp_time_randn(BENCH_LENGTH, &fsample);
+	dsp_time_randn(BENCH_LENGTH, &ssample);
+	dsp_time_randn(BENCH_LENGTH, &window);
+	dsp_transform_fft(&fsample, &spectrum);
+	output.length = BENCH_LENGTH;
+	fview = dsp_time_view_of(&fsample);
+	sview = dsp_time_view_of(&ssample);
+	result = dsp_time_view_of(&output);
+	bins = dsp_freq_view_of(&spectrum);
+
+	best = dsp_simd_detect();
+	printf("%d samples, best instruction set is %s\n\n", BENCH_LENGTH,
+		dsp_simd_name(best));
+	printf("%-12s %-8s %12s %10s\n", "kernel", "level", "ns/call",
+		"speedup");
+
+	for (kernel = 0; kernel < BENCH_KERNELS; kernel++)
+	{
+		for (level = DSP_SIMD_SCALAR; level <= (int) best; level++)
+		{
+			dsp_simd_select(level);
+			ns = __measure(kernel);
+			if (level == DSP_SIMD_SCALAR)
+			{
+				scalar[kernel] = ns;
+			}
+			printf("%-12s %-8s %12.1f %9.2fx\n", kernels[kernel],
+				dsp_simd_name(level), ns, scalar[kernel] / ns);
+		}
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,175 @@
+/**
+ ******************************************************************************
+ * @file 	decimator.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Unit test for the multistage decimator.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <check.h>
+#include "../../../common/decimator.h"
+
+#define DFSDM_RATE							48828.125f	/* Hz, 3.125 MHz / 64 */
+#define RATIO									4
+#define PASSBAND								3000.0f	/* Hz */
+#define ATTENUATION							60.0f		/* dB */
+#define LENGTH									8192
+
+static Decimator decimator;
+static DecimatorChannel channel;
+static float input[LENGTH], output[LENGTH / RATIO + 1];
+
+/**
+ * Return the amplitude of the tone of `freq` Hz through the decimator,
+ * from the second half of the output.
+ */
+static double tone_gain(double freq)
+{
+	size_t i, count;
+	double peak = 0.0;
+
+	for (i = 0; i < LENGTH; i++)
+	{
+		input[i] = (float) sin(2.0 * M_PI * freq * i / DFSDM_RATE);
+	}
+	decimator_channel_reset(&channel);
+	count = decimator_process(&decimator, &channel, input, LENGTH, output);
+	ck_assert_uint_eq(count, LENGTH / RATIO);
+	for (i = count / 2; i < count; i++)
+	{
+		peak = fmax(peak, fabs(output[i]));
+	}
+	return peak;
+}
+
+START_TEST(decimator_design)
+{
+	printf("\n[TEST] Testing decimator_init()...\n");
+
+	/* The stages divide the ratio by its prime factors, biggest first. */
+	ck_assert_int_eq(decimator_init(&decimator, DFSDM_RATE, 4, PASSBAND,
+		ATTENUATION), 2);
+	ck_assert_int_eq(decimator.stage[0].ratio, 2);
+	ck_assert_int_eq(decimator.stage[1].ratio, 2);
+	ck_assert_int_eq(decimator.stage[1].taps % 2, 1);
+
+	ck_assert_int_eq(decimator_init(&decimator, 96000.0f, 12, PASSBAND,
+		ATTENUATION), 3);
+	ck_assert_int_eq(decimator.stage[0].ratio, 3);
+	ck_assert_int_eq(decimator.stage[2].ratio, 2);
+
+	/* The pass band must fit in the output rate and the filters in
+		their taps. */
+	ck_assert_int_eq(decimator_init(&decimator, DFSDM_RATE, 8, PASSBAND,
+		ATTENUATION), -1);
+	ck_assert_int_eq(decimator_init(&decimator, DFSDM_RATE, 4, 6000.0f,
+		ATTENUATION), -1);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(decimator_anti_alias)
+{
+	printf("\n[TEST] Testing decimator pass band and aliases...\n");
+
+	ck_assert_int_eq(decimator_init(&decimator, DFSDM_RATE, RATIO, PASSBAND,
+		ATTENUATION), 2);
+
+	/* The pass band is kept and the tones that would fold into it at
+		the 12.2 kHz output rate are stopped. */
+	ck_assert_double_eq_tol(tone_gain(100.0), 1.0, 0.01);
+	ck_assert_double_eq_tol(tone_gain(2500.0), 1.0, 0.01);
+	ck_assert_double_le(tone_gain(10000.0), 0.002);	/* to 2207 Hz */
+	ck_assert_double_le(tone_gain(22000.0), 0.002);	/* to 2414 Hz */
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(decimator_streams_frames)
+{
+	size_t i, start, count, total, length;
+	static float whole[LENGTH / RATIO + 1];
+
+	printf("\n[TEST] Testing decimator over frames...\n");
+
+	ck_assert_int_eq(decimator_init(&decimator, DFSDM_RATE, RATIO, PASSBAND,
+		ATTENUATION), 2);
+	srand(7);
+	for (i = 0; i < LENGTH; i++)
+	{
+		input[i] = (float) rand() / RAND_MAX - 0.5f;
+	}
+	decimator_channel_reset(&channel);
+	count = decimator_process(&decimator, &channel, input, LENGTH, whole);
+
+	/* The frames of odd lengths give the same outputs of a single call. */
+	decimator_channel_reset(&channel);
+	for (start = 0, total = 0; start < LENGTH; start += length)
+	{
+		length = (LENGTH - start < 37) ? LENGTH - start : 37;
+		total += decimator_process(&decimator, &channel, input + start,
+			length, output + total);
+	}
+	ck_assert_uint_eq(total, count);
+	for (i = 0; i < count; i++)
+	{
+		ck_assert_float_eq(output[i], whole[i]);
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+Suite *decimator_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Decimator");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, decimator_design);
+	tcase_add_test(tc_core, decimator_anti_alias);
+	tcase_add_test(tc_core, decimator_streams_frames);
+
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
+
+int main(int argc, char *argv[])
+{
+	int numFailed = 0;
+	Suite *s;
+	SRunner *sr;
+
+	s = decimator_suite();
+	sr = srunner_create(s);
+
+	srunner_run_all(sr, CK_NORMAL);
+
+	numFailed = srunner_ntests_failed(sr);
+
+	srunner_free(sr);
+
+	printf("numFailed = %d\n", numFailed);
+
+	return (numFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,203 @@
+/**
+ ******************************************************************************
+ * @file 	conv.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Unit test for fast convolution against the direct library.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include <check.h>
+#include "../../../src/dsp/dsp_ext.h"
+
+#define TOLERANCE								1e-9
+
+static DspTime white, fsample, ssample, expected;
+static unsigned char storage[262144];
+
+/**
+ * Fill the samples from two slices of a single draw, the draws of the
+ * library start from the same seed.
+ */
+static void draw_samples(len_t flength, len_t slength)
+{
+	len_t i;
+
+	dsp_time_randn(flength + slength, &white);
+	fsample.length = flength;
+	ssample.length = slength;
+	for (i = 0; i < flength; i++)
+	{
+		fsample.data[i] = white.data[i];
+	}
+	for (i = 0; i < slength; i++)
+	{
+		ssample.data[i] = white.data[flength + i];
+	}
+}
+
+/**
+ * Compare the result view with the expected output of the library.
+ */
+static void compare_with_library(const DspTimeView *result)
+{
+	len_t i;
+
+	ck_assert_uint_eq(result->length, expected.length);
+	for (i = 0; i < expected.length; i++)
+	{
+		ck_assert_double_eq_tol(result->data[i], expected.data[i], TOLERANCE);
+	}
+}
+
+START_TEST(convolve_fft_and_direct)
+{
+	int i;
+	len_t lengths[][2] = { {300, 200}, {200, 8}, {5, 700}, {1000, 1000} };
+	DspArena arena;
+	DspTimeView fview, sview, result;
+
+	printf("\n[TEST] Testing dsp_view_convolve()...\n");
+
+	dsp_arena_init(&arena, storage, sizeof(storage));
+	for (i = 0; i < 4; i++)
+	{
+		draw_samples(lengths[i][0], lengths[i][1]);
+		dsp_time_convolve(&fsample, &ssample, &expected);
+
+		fview = dsp_time_view_of(&fsample);
+		sview = dsp_time_view_of(&ssample);
+		result = dsp_time_view_new(&arena, expected.length);
+		dsp_view_convolve(&fview, &sview, &result, &arena);
+		compare_with_library(&result);
+		dsp_arena_reset(&arena);
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(correlate_fft_and_direct)
+{
+	int i;
+	len_t lengths[] = { 300, 16, 1024 };
+	DspArena arena;
+	DspTimeView fview, sview, result;
+
+	printf("\n[TEST] Testing dsp_view_cross_corr() and auto_corr()...\n");
+
+	dsp_arena_init(&arena, storage, sizeof(storage));
+	for (i = 0; i < 3; i++)
+	{
+		draw_samples(lengths[i], lengths[i]);
+		fview = dsp_time_view_of(&fsample);
+		sview = dsp_time_view_of(&ssample);
+		result = dsp_time_view_new(&arena, 2 * lengths[i] - 1);
+
+		dsp_time_cross_corr(&fsample, &ssample, &expected);
+		dsp_view_cross_corr(&fview, &sview, &result, &arena);
+		compare_with_library(&result);
+
+		dsp_time_auto_corr(&fsample, &expected);
+		dsp_view_auto_corr(&fview, &result, &arena);
+		compare_with_library(&result);
+		dsp_arena_reset(&arena);
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(convolver_streams_frames)
+{
+	int i, t, taps[] = { 9, 101 };
+	len_t k, start, frames[] = { 1, 37, 512, 700, 3, 256 };
+	DspConvolver conv;
+	DspTimeView input, output;
+	DspArena arena;
+
+	printf("\n[TEST] Testing overlap-save DspConvolver...\n");
+
+	/* The frames of any length give the head of the one-shot output. */
+	dsp_arena_init(&arena, storage, sizeof(storage));
+	for (t = 0; t < 2; t++)
+	{
+		draw_samples(1509, (len_t) taps[t]);
+		dsp_time_convolve(&fsample, &ssample, &expected);
+		dsp_convolver_init(&conv, ssample.data, taps[t]);
+		ck_assert_int_eq(conv.block == 0, taps[t] <= DSP_CONV_DIRECT_TAPS);
+
+		output = dsp_time_view_new(&arena, 1024);
+		for (start = 0, i = 0; i < 6; start += frames[i++])
+		{
+			input.data = fsample.data + start;
+			input.length = frames[i];
+			input.capacity = frames[i];
+			dsp_convolver_process(&conv, &input, &output);
+			ck_assert_uint_eq(output.length, frames[i]);
+			for (k = 0; k < frames[i]; k++)
+			{
+				ck_assert_double_eq_tol(output.data[k],
+					expected.data[start + k], TOLERANCE);
+			}
+		}
+
+		/* A reset convolver starts over from the silence. */
+		dsp_convolver_reset(&conv);
+		input.data = fsample.data;
+		input.length = 64;
+		dsp_convolver_process(&conv, &input, &output);
+		ck_assert_double_eq_tol(output.data[63], expected.data[63], TOLERANCE);
+
+		dsp_convolver_free(&conv);
+		dsp_arena_reset(&arena);
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+Suite *conv_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Convolution");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, convolve_fft_and_direct);
+	tcase_add_test(tc_core, correlate_fft_and_direct);
+	tcase_add_test(tc_core, convolver_streams_frames);
+
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
+
+int main(int argc, char *argv[])
+{
+	int numFailed = 0;
+	Suite *s;
+	SRunner *sr;
+
+	s = conv_suite();
+	sr = srunner_create(s);
+
+	srunner_run_all(sr, CK_NORMAL);
+
+	numFailed = srunner_ntests_failed(sr);
+
+	srunner_free(sr);
+
+	printf("numFailed = %d\n", numFailed);
+
+	return (numFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
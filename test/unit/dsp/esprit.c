@@ -0,0 +1,121 @@
+/**
+ ******************************************************************************
+ * @file 	esprit.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Unit test for UCA-ESPRIT arrival of angle.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#define _GNU_SOURCE
+#include <check.h>
+#include "../../../src/dsp/dsp_ext.h"
+
+#define MICS									8
+#define RADIUS									0.1		/* meter */
+#define FREQ									1000.0	/* Hz */
+#define SAMPLE_FREQ							12000.0	/* Hz */
+#define LENGTH									512
+
+static DspTime samples[MICS];
+
+/**
+ * Fill the mics with a plane wave coming from `theta` degrees plus the
+ * white noise of `noise` deviation.
+ */
+static void plane_wave(DspArrival *arrival, double theta, double noise,
+	len_t offset)
+{
+	int i;
+	len_t t;
+	double delay;
+
+	arrival->mics = MICS;
+	arrival->freq = FREQ;
+	arrival->radius = RADIUS;
+	arrival->sources = 1;
+	for (i = 0; i < MICS; i++)
+	{
+		delay = RADIUS * cos(theta * M_PI / 180.0 - 2.0 * M_PI * i / MICS) /
+			SOUND_SPEED;
+		dsp_time_randn(LENGTH, &samples[i]);
+		for (t = 0; t < LENGTH; t++)
+		{
+			samples[i].data[t] = noise * samples[i].data[t] + cos(2.0 * M_PI *
+				FREQ * ((t + offset) / SAMPLE_FREQ + delay));
+		}
+		arrival->samples[i] = &samples[i];
+	}
+}
+
+START_TEST(esprit_plane_wave)
+{
+	double theta, distance;
+	DspArrival arrival;
+	DspDirection direction;
+
+	printf("\n[TEST] Testing UCA-ESPRIT...\n");
+
+	/* The azimuth is continuous and has no ambiguity of 180 degrees,
+		because the snapshots are complex. The elevation is acos(|mu|),
+		which is steep near the plane of array, so it's coarse there. */
+	for (theta = 0.0; theta < 360.0; theta += 17.3)
+	{
+		plane_wave(&arrival, theta, 0.05, 0);
+		ck_assert_int_eq(dsp_arrival_esprit(&arrival, SAMPLE_FREQ, &direction),
+			1);
+		distance = fabs(direction.azimuth - theta);
+		ck_assert_double_le(fmin(distance, 360.0 - distance), 0.1);
+		ck_assert_double_le(direction.elevation, 10.0);
+	}
+
+	/* 8 mics can't resolve the phase modes of k * r above 4. */
+	arrival.freq = 3000.0;
+	ck_assert_int_eq(dsp_arrival_esprit(&arrival, SAMPLE_FREQ, &direction), 0);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+Suite *esprit_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("ESPRIT");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, esprit_plane_wave);
+
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
+
+int main(int argc, char *argv[])
+{
+	int numFailed = 0;
+	Suite *s;
+	SRunner *sr;
+
+	s = esprit_suite();
+	sr = srunner_create(s);
+
+	srunner_run_all(sr, CK_NORMAL);
+
+	numFailed = srunner_ntests_failed(sr);
+
+	srunner_free(sr);
+
+	printf("numFailed = %d\n", numFailed);
+
+	return (numFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,247 @@
+/**
+ ******************************************************************************
+ * @file 	fft.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Unit test for mixed-radix FFT against the reference DFT.
+ * 
+ ******************************************************************************
+ * @attention
+ * 
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ * 
+ * This software is licensed under the MIT License.
+ * 
+ ******************************************************************************
+ */
+
+#include <check.h>
+#include "../../../src/dsp/dsp_ext.h"
+
+#define TOLERANCE								1e-6
+
+static DspTime sample, inverse;
+static DspFreq expected, result;
+
+/**
+ * Compare the FFT output with the reference DFT for given length.
+ */
+static void compare_with_dft(len_t length)
+{
+	len_t i;
+
+	dsp_time_randn(length, &sample);
+	dsp_transform_dft(&sample, &expected);
+	dsp_transform_fft(&sample, &result);
+
+	ck_assert_uint_eq(result.length, expected.length);
+	for (i = 0; i < length; i++)
+	{
+		ck_assert_double_eq_tol(result.data[i][0], expected.data[i][0], 
+			TOLERANCE * length);
+		ck_assert_double_eq_tol(result.data[i][1], expected.data[i][1], 
+			TOLERANCE * length);
+	}
+}
+
+/**
+ * Compare the real FFT output with the reference real DFT.
+ */
+static void compare_with_dft_real(const DspTime *sample, const DspFreq *result)
+{
+	len_t i;
+
+	dsp_transform_dft_real(sample, &expected);
+
+	ck_assert_uint_eq(result->length, expected.length);
+	for (i = 0; i < expected.length; i++)
+	{
+		ck_assert_double_eq_tol(result->data[i][0], expected.data[i][0], 
+			TOLERANCE * sample->length);
+		ck_assert_double_eq_tol(result->data[i][1], expected.data[i][1], 
+			TOLERANCE * sample->length);
+	}
+}
+
+START_TEST(fft_power_of_two)
+{
+	printf("\n[TEST] Testing dsp_transform_fft() with power of two...\n");
+
+	compare_with_dft(1);
+	compare_with_dft(2);
+	compare_with_dft(8);
+	compare_with_dft(512);
+	compare_with_dft(2048);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(fft_mixed_radix)
+{
+	printf("\n[TEST] Testing dsp_transform_fft() with mixed radix...\n");
+
+	compare_with_dft(3);
+	compare_with_dft(12);
+	compare_with_dft(15);
+	compare_with_dft(360);
+	compare_with_dft(1000);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(fft_prime_length)
+{
+	printf("\n[TEST] Testing dsp_transform_fft() with prime length...\n");
+
+	compare_with_dft(7);
+	compare_with_dft(97);
+	compare_with_dft(2 * 3 * 5 * 7 * 11);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(ifft_round_trip)
+{
+	len_t i;
+
+	printf("\n[TEST] Testing dsp_transform_ifft() round trip...\n");
+
+	dsp_time_randn(600, &sample);
+	dsp_transform_fft(&sample, &result);
+	dsp_transform_ifft(&result, &inverse);
+
+	ck_assert_uint_eq(inverse.length, sample.length);
+	for (i = 0; i < sample.length; i++)
+	{
+		ck_assert_double_eq_tol(inverse.data[i], sample.data[i], TOLERANCE);
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(rfft_half_spectrum)
+{
+	len_t lengths[] = {2, 9, 12, 512, 1000};
+	int i;
+
+	printf("\n[TEST] Testing dsp_transform_rfft() half spectrum...\n");
+
+	for (i = 0; i < 5; i++)
+	{
+		dsp_time_randn(lengths[i], &sample);
+		dsp_transform_rfft(&sample, &result);
+		compare_with_dft_real(&sample, &result);
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(rfft_batch_channels)
+{
+	int i;
+	static DspTime samples[5];
+	static DspFreq results[5];
+
+	printf("\n[TEST] Testing dsp_transform_rfft_batch() channels...\n");
+
+	for (i = 0; i < 5; i++)
+	{
+		dsp_time_randn(512, &samples[i]);
+	}
+	dsp_transform_rfft_batch(samples, 5, results);
+	for (i = 0; i < 5; i++)
+	{
+		compare_with_dft_real(&samples[i], &results[i]);
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(rfft_arena_views)
+{
+	int i;
+	size_t mark;
+	static DspTime samples[3];
+	static DspFreq copy;
+	static unsigned char storage[65536];
+	DspArena arena;
+	DspTimeView views[3];
+	DspFreqView spectrums[3];
+
+	printf("\n[TEST] Testing dsp_view_rfft_batch() with an arena...\n");
+
+	dsp_arena_init(&arena, storage, sizeof(storage));
+	for (i = 0; i < 3; i++)
+	{
+		dsp_time_randn(i == 2 ? 9 : 256, &samples[i]);
+		views[i] = dsp_time_view_of(&samples[i]);
+	}
+	spectrums[0] = dsp_freq_view_new(&arena, 129);
+	spectrums[1] = dsp_freq_view_new(&arena, 129);
+	spectrums[2] = dsp_freq_view_new(&arena, 5);
+	mark = dsp_arena_mark(&arena);
+
+	/* The scratch buffers are released, only the spectrums are kept. */
+	dsp_view_rfft_batch(views, 2, spectrums, &arena);
+	dsp_view_rfft(&views[2], &spectrums[2], &arena);
+	ck_assert_uint_eq(dsp_arena_mark(&arena), mark);
+	ck_assert_uint_gt(arena.peak, mark);
+
+	for (i = 0; i < 3; i++)
+	{
+		ck_assert_uint_eq((uintptr_t) spectrums[i].data % DSP_ARENA_ALIGN, 0);
+		copy.length = spectrums[i].length;
+		memcpy(copy.data, spectrums[i].data, copy.length * sizeof(double [2]));
+		compare_with_dft_real(&samples[i], &copy);
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+Suite *fft_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("FFT");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, fft_power_of_two);
+	tcase_add_test(tc_core, fft_mixed_radix);
+	tcase_add_test(tc_core, fft_prime_length);
+	tcase_add_test(tc_core, ifft_round_trip);
+	tcase_add_test(tc_core, rfft_half_spectrum);
+	tcase_add_test(tc_core, rfft_batch_channels);
+	tcase_add_test(tc_core, rfft_arena_views);
+
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
+
+int main(int argc, char *argv[])
+{
+	int numFailed = 0;
+	Suite *s;
+	SRunner *sr;
+
+	s = fft_suite();
+	sr = srunner_create(s);
+
+	srunner_run_all(sr, CK_NORMAL);
+
+	numFailed = srunner_ntests_failed(sr);
+
+	srunner_free(sr);
+
+	printf("numFailed = %d\n", numFailed);
+
+	return (numFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,253 @@
+/**
+ ******************************************************************************
+ * @file 	filter.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Unit test for the streaming FIR and IIR filters.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#define _GNU_SOURCE
+#include <check.h>
+#include "../../../src/dsp/dsp_ext.h"
+
+#define TOLERANCE								1e-9
+#define SAMPLE_FREQ							12000.0	/* Hz */
+#define FRAME									512
+#define FRAMES									4
+#define TAPS									101
+
+static DspTime white, expected;
+static double streamed[2][FRAMES * FRAME];
+
+/**
+ * Return the steady-state amplitude of the `freq` Hz tone through the
+ * cascade, from the second half of a long tone.
+ */
+static double sos_gain(const DspSos *design, double freq)
+{
+	len_t t;
+	double peak = 0.0;
+	static DspSos sos;
+	static DspTime tone;
+	DspTimeView view;
+
+	sos = *design;
+	dsp_sos_reset(&sos);
+	tone.length = MAX_DATA;
+	for (t = 0; t < MAX_DATA; t++)
+	{
+		tone.data[t] = sin(2.0 * M_PI * freq * t / SAMPLE_FREQ);
+	}
+	view = dsp_time_view_of(&tone);
+	dsp_sos_process(&sos, &view, &view);
+	for (t = MAX_DATA / 2; t < MAX_DATA; t++)
+	{
+		peak = fmax(peak, fabs(tone.data[t]));
+	}
+	return peak;
+}
+
+START_TEST(fir_streams_frames)
+{
+	int c, f;
+	len_t t, lag;
+	DspFilter filters[] = { DSP_FILTER_LOW_PASS, DSP_FILTER_BAND_PASS };
+	DspFir fir;
+	DspTimeView inputs[2], outputs[2];
+
+	printf("\n[TEST] Testing streaming DspFir against the library...\n");
+
+	/* The frames of a channel are the lagged one-shot filter of library. */
+	lag = (TAPS - 1) / 2;
+	dsp_time_randn(FRAMES * FRAME, &white);
+	for (f = 0; f < 2; f++)
+	{
+		if (filters[f] == DSP_FILTER_LOW_PASS)
+		{
+			dsp_filter_fir_low_pass(&white, 500.0, SAMPLE_FREQ, TAPS, &expected);
+		}
+		else
+		{
+			dsp_filter_fir_band_pass(&white, 200.0, 3000.0, SAMPLE_FREQ, TAPS,
+				&expected);
+		}
+		dsp_fir_init(&fir, filters[f], (f == 0) ? 500.0 : 200.0, 3000.0,
+			SAMPLE_FREQ, TAPS, 2);
+		for (t = 0; t < FRAMES * FRAME; t += FRAME)
+		{
+			for (c = 0; c < 2; c++)
+			{
+				inputs[c].data = white.data + t;
+				inputs[c].length = inputs[c].capacity = FRAME;
+				outputs[c].data = streamed[c] + t;
+				outputs[c].length = 0;
+				outputs[c].capacity = FRAME;
+			}
+			dsp_fir_process(&fir, inputs, outputs);
+		}
+		for (t = lag; t < FRAMES * FRAME; t++)
+		{
+			ck_assert_double_eq_tol(streamed[0][t], expected.data[t - lag],
+				TOLERANCE);
+			ck_assert_double_eq_tol(streamed[1][t], streamed[0][t], TOLERANCE);
+		}
+		dsp_fir_free(&fir);
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(fir_design_complements)
+{
+	int i;
+	double low[TAPS], high[TAPS], pass[TAPS], stop[TAPS], dc[4] = { 0.0 };
+
+	printf("\n[TEST] Testing dsp_fir_design() complements...\n");
+
+	/* The high pass and band stop kernels are the complements. */
+	dsp_fir_design(DSP_FILTER_LOW_PASS, 500.0, 0.0, SAMPLE_FREQ, TAPS, low);
+	dsp_fir_design(DSP_FILTER_HIGH_PASS, 500.0, 0.0, SAMPLE_FREQ, TAPS, high);
+	dsp_fir_design(DSP_FILTER_BAND_PASS, 500.0, 1500.0, SAMPLE_FREQ, TAPS,
+		pass);
+	dsp_fir_design(DSP_FILTER_BAND_STOP, 500.0, 1500.0, SAMPLE_FREQ, TAPS,
+		stop);
+	for (i = 0; i < TAPS; i++)
+	{
+		ck_assert_double_eq_tol(low[i] + high[i], (i == TAPS / 2) ? 1.0 : 0.0,
+			TOLERANCE);
+		ck_assert_double_eq_tol(pass[i] + stop[i], (i == TAPS / 2) ? 1.0 : 0.0,
+			TOLERANCE);
+		dc[0] += low[i];
+		dc[1] += high[i];
+		dc[2] += pass[i];
+		dc[3] += stop[i];
+	}
+	ck_assert_double_eq_tol(dc[0], 1.0, TOLERANCE);
+	ck_assert_double_eq_tol(dc[1], 0.0, TOLERANCE);
+	ck_assert_double_eq_tol(dc[2], 0.0, TOLERANCE);
+	ck_assert_double_eq_tol(dc[3], 1.0, TOLERANCE);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(sos_streams_frames)
+{
+	int c;
+	len_t t;
+	static DspSos sos;
+	DspTimeView inputs[2], outputs[2], whole;
+
+	printf("\n[TEST] Testing DspSos over frames and channels...\n");
+
+	/* The band of the rotor, the frames of each channel are filtered as if
+		they were a single call. */
+	dsp_time_randn(2 * FRAMES * FRAME, &white);
+	dsp_sos_init(&sos, 2);
+	dsp_sos_butterworth(&sos, DSP_FILTER_HIGH_PASS, 4, 200.0, SAMPLE_FREQ);
+	dsp_sos_butterworth(&sos, DSP_FILTER_LOW_PASS, 4, 3000.0, SAMPLE_FREQ);
+	ck_assert_int_eq(sos.sections, 4);
+	for (t = 0; t < FRAMES * FRAME; t += FRAME)
+	{
+		for (c = 0; c < 2; c++)
+		{
+			inputs[c].data = white.data + c * FRAMES * FRAME + t;
+			inputs[c].length = inputs[c].capacity = FRAME;
+			outputs[c].data = streamed[c] + t;
+			outputs[c].length = 0;
+			outputs[c].capacity = FRAME;
+		}
+		dsp_sos_process(&sos, inputs, outputs);
+	}
+
+	/* Each channel alone in a single call, in place. */
+	for (c = 0; c < 2; c++)
+	{
+		for (t = 0; t < FRAMES * FRAME; t++)
+		{
+			expected.data[t] = white.data[c * FRAMES * FRAME + t];
+		}
+		expected.length = FRAMES * FRAME;
+		whole = dsp_time_view_of(&expected);
+		dsp_sos_reset(&sos);
+		sos.channels = 1;
+		dsp_sos_process(&sos, &whole, &whole);
+		for (t = 0; t < FRAMES * FRAME; t++)
+		{
+			ck_assert_double_eq_tol(streamed[c][t], expected.data[t], TOLERANCE);
+		}
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(sos_butterworth_response)
+{
+	static DspSos sos;
+
+	printf("\n[TEST] Testing Butterworth sections...\n");
+
+	/* -3 dB at the cutoff, flat in the pass band and 24 dB per octave. */
+	dsp_sos_init(&sos, 1);
+	dsp_sos_butterworth(&sos, DSP_FILTER_LOW_PASS, 4, 1000.0, SAMPLE_FREQ);
+	ck_assert_double_eq_tol(sos_gain(&sos, 1000.0), M_SQRT1_2, 1e-3);
+	ck_assert_double_eq_tol(sos_gain(&sos, 250.0), 1.0, 1e-3);
+	ck_assert_double_le(sos_gain(&sos, 4000.0), 0.005);
+
+	dsp_sos_init(&sos, 1);
+	dsp_sos_butterworth(&sos, DSP_FILTER_HIGH_PASS, 2, 1000.0, SAMPLE_FREQ);
+	ck_assert_double_eq_tol(sos_gain(&sos, 1000.0), M_SQRT1_2, 1e-3);
+	ck_assert_double_le(sos_gain(&sos, 100.0), 0.011);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+Suite *filter_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Filter");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, fir_streams_frames);
+	tcase_add_test(tc_core, fir_design_complements);
+	tcase_add_test(tc_core, sos_streams_frames);
+	tcase_add_test(tc_core, sos_butterworth_response);
+
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
+
+int main(int argc, char *argv[])
+{
+	int numFailed = 0;
+	Suite *s;
+	SRunner *sr;
+
+	s = filter_suite();
+	sr = srunner_create(s);
+
+	srunner_run_all(sr, CK_NORMAL);
+
+	numFailed = srunner_ntests_failed(sr);
+
+	srunner_free(sr);
+
+	printf("numFailed = %d\n", numFailed);
+
+	return (numFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,248 @@
+/**
+ ******************************************************************************
+ * @file 	float32.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Unit test for single-precision kernels against the double path.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include <check.h>
+#include "../../../src/dsp/dsp_ext.h"
+
+#define TOLERANCE								1e-5		/* relative to float */
+
+static DspTime sample, expected;
+static DspFreq spectrum;
+static DspArena arena;
+static DspTimeViewF32 view, output;
+static _Alignas(DSP_ARENA_ALIGN) unsigned char storage[131072];
+
+/**
+ * Prepare a random sample and its single-precision copy before each test.
+ */
+static void setup(void)
+{
+	dsp_arena_init(&arena, storage, sizeof(storage));
+	view = dsp_time_view_f32_new(&arena, MAX_DATA / 4);
+	output = dsp_time_view_f32_new(&arena, MAX_DATA / 4);
+
+	dsp_time_randn(500, &sample);
+	dsp_time_f32_from_double(&sample, &view);
+}
+
+/**
+ * Compare the single-precision output with the double `expected` one.
+ */
+static void compare_with_double(const DspTimeViewF32 *result, double scale)
+{
+	len_t i;
+
+	ck_assert_uint_eq(result->length, expected.length);
+	for (i = 0; i < expected.length; i++)
+	{
+		ck_assert_double_eq_tol(result->data[i], expected.data[i],
+			TOLERANCE * scale);
+	}
+}
+
+START_TEST(f32_conversions)
+{
+	len_t i;
+	int8_t pcm[256];
+
+	printf("\n[TEST] Testing dsp_time_f32_from_int8() conversions...\n");
+
+	for (i = 0; i < 256; i++)
+	{
+		pcm[i] = (int8_t) (i - 128);
+	}
+	dsp_time_f32_from_int8(pcm, 256, &output);
+	dsp_time_f32_to_double(&output, &expected);
+
+	ck_assert_uint_eq(expected.length, 256);
+	for (i = 0; i < 256; i++)
+	{
+		ck_assert_double_eq(expected.data[i], pcm[i]);
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(f32_statistics)
+{
+	len_t i;
+	double energy = 0.0;
+
+	printf("\n[TEST] Testing single-precision statistics...\n");
+
+	for (i = 0; i < sample.length; i++)
+	{
+		energy += sample.data[i] * sample.data[i];
+	}
+	ck_assert_float_eq(dsp_time_f32_max(&view), (float) dsp_time_max(&sample));
+	ck_assert_float_eq(dsp_time_f32_min(&view), (float) dsp_time_min(&sample));
+	ck_assert_float_eq(dsp_time_f32_abs_max(&view),
+		(float) dsp_time_abs_max(&sample));
+	ck_assert_int_eq(dsp_time_f32_argmax(&view), dsp_time_argmax(&sample));
+	ck_assert_double_eq_tol(dsp_time_f32_mean(&view), dsp_time_mean(&sample),
+		TOLERANCE);
+	ck_assert_double_eq_tol(dsp_time_f32_stddev(&view),
+		dsp_time_stddev(&sample), TOLERANCE);
+	ck_assert_double_eq_tol(dsp_time_f32_variance(&view),
+		dsp_time_variance(&sample), TOLERANCE);
+	ck_assert_double_eq_tol(dsp_time_f32_energy(&view), energy,
+		TOLERANCE * energy);
+	ck_assert_double_eq_tol(dsp_time_f32_rms(&view),
+		sqrt(energy / sample.length), TOLERANCE);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(f32_windows)
+{
+	printf("\n[TEST] Testing single-precision windows...\n");
+
+	dsp_window_hamming(&sample, &expected);
+	dsp_window_f32_hamming(&view, &output);
+	compare_with_double(&output, 1.0);
+
+	dsp_window_hanning(&sample, &expected);
+	dsp_window_f32_hanning(&view, &output);
+	compare_with_double(&output, 1.0);
+
+	dsp_window_blackman(&sample, &expected);
+	dsp_window_f32_blackman(&view, &output);
+	compare_with_double(&output, 1.0);
+
+	dsp_time_scale(&sample, 128.0, &expected);
+	dsp_time_f32_scale(&view, 128.0f, &output);
+	compare_with_double(&output, 128.0);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(f32_fir_filters)
+{
+	int taps;
+	size_t mark;
+
+	printf("\n[TEST] Testing single-precision FIR filters...\n");
+
+	mark = dsp_arena_mark(&arena);
+	for (taps = 17; taps <= 65; taps += 16)
+	{
+		dsp_filter_fir_low_pass(&sample, 1000.0, 12000.0, taps, &expected);
+		dsp_filter_f32_fir_low_pass(&view, 1000.0f, 12000.0f, taps, &output,
+			&arena);
+		compare_with_double(&output, 1.0);
+
+		dsp_filter_fir_high_pass(&sample, 2500.0, 12000.0, taps, &expected);
+		dsp_filter_f32_fir_high_pass(&view, 2500.0f, 12000.0f, taps, &output,
+			&arena);
+		compare_with_double(&output, 1.0);
+	}
+	ck_assert_uint_eq(dsp_arena_mark(&arena), mark);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(f32_rfft_batch)
+{
+	int i;
+	len_t k, lengths[] = {512, 512, 360, 360, 97};
+	DspTimeViewF32 views[5];
+	DspFreqViewF32 spectrums[5];
+
+	printf("\n[TEST] Testing dsp_view_rfft_batch_f32() against double...\n");
+
+	for (i = 0; i < 5; i++)
+	{
+		views[i] = dsp_time_view_f32_new(&arena, lengths[i]);
+		spectrums[i] = dsp_freq_view_f32_new(&arena, lengths[i] / 2 + 1);
+	}
+	for (i = 0; i < 5; i += 2)
+	{
+		dsp_time_randn(lengths[i], &sample);
+		dsp_time_f32_from_double(&sample, &views[i]);
+		if (i + 1 < 5)
+		{
+			dsp_time_randn(lengths[i + 1], &sample);
+			dsp_time_f32_from_double(&sample, &views[i + 1]);
+			dsp_view_rfft_batch_f32(&views[i], 2, &spectrums[i], &arena);
+		}
+		else
+		{
+			dsp_view_rfft_batch_f32(&views[i], 1, &spectrums[i], &arena);
+		}
+	}
+	for (i = 0; i < 5; i++)
+	{
+		dsp_time_f32_to_double(&views[i], &sample);
+		dsp_transform_rfft(&sample, &spectrum);
+
+		ck_assert_uint_eq(spectrums[i].length, spectrum.length);
+		for (k = 0; k < spectrum.length; k++)
+		{
+			ck_assert_double_eq_tol(spectrums[i].data[k][0],
+				spectrum.data[k][0], TOLERANCE * lengths[i]);
+			ck_assert_double_eq_tol(spectrums[i].data[k][1],
+				spectrum.data[k][1], TOLERANCE * lengths[i]);
+		}
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+Suite *float32_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Float32");
+	tc_core = tcase_create("Core");
+
+	tcase_add_checked_fixture(tc_core, setup, NULL);
+	tcase_add_test(tc_core, f32_conversions);
+	tcase_add_test(tc_core, f32_statistics);
+	tcase_add_test(tc_core, f32_windows);
+	tcase_add_test(tc_core, f32_fir_filters);
+	tcase_add_test(tc_core, f32_rfft_batch);
+
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
+
+int main(int argc, char *argv[])
+{
+	int numFailed = 0;
+	Suite *s;
+	SRunner *sr;
+
+	s = float32_suite();
+	sr = srunner_create(s);
+
+	srunner_run_all(sr, CK_NORMAL);
+
+	numFailed = srunner_ntests_failed(sr);
+
+	srunner_free(sr);
+
+	printf("numFailed = %d\n", numFailed);
+
+	return (numFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,157 @@
+/**
+ ******************************************************************************
+ * @file 	moments.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Unit test for single-pass statistics against the DSP library.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include <check.h>
+#include "../../../src/dsp/dsp_ext.h"
+
+#define TOLERANCE								1e-9
+
+static DspTime sample;
+
+/**
+ * Compare the moments of sample with the separate library functions. The
+ * energy of library doesn't clear its sum, so it's calculated here.
+ */
+static void compare_with_library(const DspTime *sample)
+{
+	len_t i;
+	double energy = 0.0;
+	DspMoments moments;
+
+	dsp_time_moments(sample, &moments);
+	for (i = 0; i < sample->length; i++)
+	{
+		energy += sample->data[i] * sample->data[i];
+	}
+
+	ck_assert_uint_eq(moments.count, sample->length);
+	ck_assert_double_eq(moments.max, dsp_time_max(sample));
+	ck_assert_double_eq(moments.min, dsp_time_min(sample));
+	ck_assert_double_eq(moments.absMax, dsp_time_abs_max(sample));
+	ck_assert_double_eq_tol(moments.mean, dsp_time_mean(sample), TOLERANCE);
+	ck_assert_double_eq_tol(moments.stddev, dsp_time_stddev(sample),
+		TOLERANCE);
+	ck_assert_double_eq_tol(moments.variance, dsp_time_variance(sample),
+		TOLERANCE);
+	ck_assert_double_eq_tol(moments.energy, energy, TOLERANCE * energy);
+	ck_assert_double_eq_tol(moments.power, energy / sample->length,
+		TOLERANCE);
+	ck_assert_double_eq_tol(moments.rms, sqrt(energy / sample->length),
+		TOLERANCE);
+	ck_assert_double_eq_tol(moments.skewness, dsp_time_skewness(sample),
+		TOLERANCE);
+	ck_assert_double_eq_tol(moments.kurtosis, dsp_time_kurtosis(sample),
+		TOLERANCE);
+}
+
+START_TEST(moments_lengths)
+{
+	len_t lengths[] = {2, 3, 5, 7, 64, 513, 4096};
+	int i;
+
+	printf("\n[TEST] Testing dsp_time_moments() with various lengths...\n");
+
+	for (i = 0; i < 7; i++)
+	{
+		dsp_time_randn(lengths[i], &sample);
+		compare_with_library(&sample);
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(moments_constant)
+{
+	DspMoments moments;
+
+	printf("\n[TEST] Testing dsp_time_moments() with constant signal...\n");
+
+	sample.length = 1;
+	sample.data[0] = -3.0;
+	dsp_time_moments(&sample, &moments);
+
+	ck_assert_double_eq(moments.mean, -3.0);
+	ck_assert_double_eq(moments.variance, 0.0);
+	ck_assert_double_eq(moments.skewness, 0.0);
+	ck_assert_double_eq(moments.kurtosis, 0.0);
+	ck_assert_double_eq(moments.crestFactor, 1.0);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(moments_big_offset)
+{
+	len_t i;
+	DspMoments moments;
+
+	printf("\n[TEST] Testing dsp_time_moments() with a big offset...\n");
+
+	/* The sums of powers lose the deviations of +-1 around 1e9. */
+	sample.length = 1000;
+	for (i = 0; i < sample.length; i++)
+	{
+		sample.data[i] = 1e9 + ((i % 2) ? 1.0 : -1.0);
+	}
+	dsp_time_moments(&sample, &moments);
+
+	ck_assert_double_eq_tol(moments.mean, 1e9, 1e-6);
+	ck_assert_double_eq_tol(moments.variance, 1.0, 1e-6);
+	ck_assert_double_eq_tol(moments.skewness, 0.0, 1e-6);
+	ck_assert_double_eq_tol(moments.kurtosis, -2.0, 1e-6);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+Suite *moments_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Moments");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, moments_lengths);
+	tcase_add_test(tc_core, moments_constant);
+	tcase_add_test(tc_core, moments_big_offset);
+
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
+
+int main(int argc, char *argv[])
+{
+	int numFailed = 0;
+	Suite *s;
+	SRunner *sr;
+
+	s = moments_suite();
+	sr = srunner_create(s);
+
+	srunner_run_all(sr, CK_NORMAL);
+
+	numFailed = srunner_ntests_failed(sr);
+
+	srunner_free(sr);
+
+	printf("numFailed = %d\n", numFailed);
+
+	return (numFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,266 @@
+/**
+ ******************************************************************************
+ * @file 	music.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Unit test for MUSIC and its tracker against the DSP library.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#define _GNU_SOURCE
+#include <check.h>
+#include "../../../src/dsp/dsp_ext.h"
+
+#define TOLERANCE								1e-9
+#define MICS									8
+#define RADIUS									0.1		/* meter */
+#define FREQ									1000.0	/* Hz */
+#define SAMPLE_FREQ							12000.0	/* Hz */
+#define LENGTH									512
+
+static DspTime samples[MICS];
+
+/**
+ * Return the distance of the axes of two angles in degrees. The covariance
+ * of real samples is the same for theta and theta + 180, so MUSIC of the
+ * library can't tell them apart and both trackers may pick either one.
+ */
+static int axis_distance(int fangle, int sangle)
+{
+	int distance = abs(fangle - sangle) % 180;
+
+	return (distance > 90) ? 180 - distance : distance;
+}
+
+/**
+ * Fill the mics with a plane wave coming from `theta` degrees plus the
+ * white noise of `noise` deviation.
+ */
+static void plane_wave(DspArrival *arrival, double theta, double noise,
+	len_t offset)
+{
+	int i;
+	len_t t;
+	double delay;
+
+	arrival->mics = MICS;
+	arrival->freq = FREQ;
+	arrival->radius = RADIUS;
+	arrival->sources = 1;
+	for (i = 0; i < MICS; i++)
+	{
+		delay = RADIUS * cos(theta * M_PI / 180.0 - 2.0 * M_PI * i / MICS) /
+			SOUND_SPEED;
+		dsp_time_randn(LENGTH, &samples[i]);
+		for (t = 0; t < LENGTH; t++)
+		{
+			samples[i].data[t] = noise * samples[i].data[t] + cos(2.0 * M_PI *
+				FREQ * ((t + offset) / SAMPLE_FREQ + delay));
+		}
+		arrival->samples[i] = &samples[i];
+	}
+}
+
+START_TEST(music_eigen_symm)
+{
+	int i, j, k, n;
+	double matrix[MAX_MICS][MAX_MICS], vectors[MAX_MICS][MAX_MICS];
+	double values[MAX_MICS], product;
+	DspTime random;
+
+	printf("\n[TEST] Testing symmetric eigendecomposition...\n");
+
+	for (n = 1; n <= MAX_MICS; n += 7)
+	{
+		dsp_time_randn(n * n, &random);
+		for (i = 0; i < n; i++)
+		{
+			for (j = 0; j <= i; j++)
+			{
+				matrix[i][j] = matrix[j][i] = random.data[i * n + j];
+			}
+		}
+		dsp_linalg_eigen_symm(n, (const double (*)[MAX_MICS]) matrix, values,
+			vectors);
+
+		for (k = 0; k < n; k++)
+		{
+			if (k > 0)
+			{
+				ck_assert_double_le(values[k - 1], values[k]);
+			}
+			for (i = 0; i < n; i++)
+			{
+				product = 0.0;
+				for (j = 0; j < n; j++)
+				{
+					product += matrix[i][j] * vectors[j][k];
+				}
+				ck_assert_double_eq_tol(product, values[k] * vectors[i][k],
+					TOLERANCE);
+			}
+		}
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(music_track_without_memory)
+{
+	int theta;
+	DspArrival arrival;
+	DspMusicTracker tracker;
+
+	printf("\n[TEST] Testing MUSIC tracker without memory...\n");
+
+	/* A tracker that forgets at once and decomposes at each frame is the
+		same of the library, except the rounding of eigensolvers. */
+	dsp_music_tracker_init(&tracker, 0.0, 1);
+	for (theta = 0; theta < 360; theta += 25)
+	{
+		plane_wave(&arrival, theta, 0.1, 0);
+		ck_assert_int_le(axis_distance(dsp_arrival_music_track(&tracker,
+			&arrival), dsp_arrival_music(&arrival)), 1);
+	}
+	ck_assert_int_eq(tracker.decompositions, 360 / 25 + 1);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(music_track_frames)
+{
+	int frame, angle;
+	DspArrival arrival;
+	DspMusicTracker tracker;
+
+	printf("\n[TEST] Testing MUSIC tracker over frames...\n");
+
+	/* The subspace is followed by PAST between the decompositions. */
+	dsp_music_tracker_init(&tracker, 0.8, 8);
+	for (frame = 0; frame < 20; frame++)
+	{
+		plane_wave(&arrival, 130.0, 0.5, frame * LENGTH);
+		angle = dsp_arrival_music_track(&tracker, &arrival);
+		ck_assert_int_le(axis_distance(angle, 130), 3);
+	}
+	ck_assert_int_eq(tracker.decompositions, 3);
+
+	/* A different number of sources starts over. */
+	arrival.sources = 2;
+	dsp_arrival_music_track(&tracker, &arrival);
+	ck_assert_int_eq(tracker.decompositions, 4);
+	ck_assert_int_eq(tracker.frames, 1);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(music_steering_search)
+{
+	int i, j;
+	double re[MICS], im[MICS], phase, denom, best, theta, expected = 0.0;
+	double distance;
+	DspArrival arrival;
+	DspMusicTracker tracker;
+	const DspSteering *steering;
+
+	printf("\n[TEST] Testing cached steering and refined search...\n");
+
+	/* The tables are shared per geometry and frequency. */
+	steering = dsp_steering_table(MICS, RADIUS, FREQ);
+	ck_assert_ptr_nonnull(steering);
+	ck_assert_ptr_eq(steering, dsp_steering_table(MICS, RADIUS, FREQ));
+	ck_assert_ptr_ne(steering, dsp_steering_table(MICS, RADIUS, 2.0 * FREQ));
+	for (i = 0; i < MICS; i++)
+	{
+		ck_assert_double_eq_tol(steering->vectors[MICS + i][1],
+			sin(-(2.0 * M_PI * FREQ / SOUND_SPEED) * RADIUS * cos(
+			DSP_STEERING_STEP * M_PI / 180.0 - 2.0 * M_PI * i / MICS)),
+			TOLERANCE);
+	}
+
+	/* The refined bearing is the peak of a fine exhaustive scan of the
+		same noise projector. */
+	dsp_music_tracker_init(&tracker, 0.0, 1);
+	plane_wave(&arrival, 130.4, 0.05, 0);
+	dsp_arrival_music_track(&tracker, &arrival);
+	ck_assert_int_eq(dsp_linalg_orthonormalize(MICS, 1, tracker.subspace), 1);
+	best = INFINITY;
+	for (theta = 0.0; theta < 360.0; theta += 0.005)
+	{
+		denom = 0.0;
+		for (i = 0; i < MICS; i++)
+		{
+			phase = -(2.0 * M_PI * FREQ / SOUND_SPEED) * RADIUS *
+				cos(theta * M_PI / 180.0 - 2.0 * M_PI * i / MICS);
+			re[i] = cos(phase);
+			im[i] = sin(phase);
+		}
+		for (i = 0; i < MICS; i++)
+		{
+			for (j = 0; j < MICS; j++)
+			{
+				denom += ((i == j) - tracker.subspace[i][0] *
+					tracker.subspace[j][0]) * (re[i] * re[j] + im[i] * im[j]);
+			}
+		}
+		if (denom < best)
+		{
+			best = denom;
+			expected = theta;
+		}
+	}
+	distance = fmod(fabs(tracker.bearing - expected), 180.0);
+	ck_assert_double_le(fmin(distance, 180.0 - distance), 0.02);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+Suite *music_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("MUSIC");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, music_eigen_symm);
+	tcase_add_test(tc_core, music_track_without_memory);
+	tcase_add_test(tc_core, music_track_frames);
+	tcase_add_test(tc_core, music_steering_search);
+
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
+
+int main(int argc, char *argv[])
+{
+	int numFailed = 0;
+	Suite *s;
+	SRunner *sr;
+
+	s = music_suite();
+	sr = srunner_create(s);
+
+	srunner_run_all(sr, CK_NORMAL);
+
+	numFailed = srunner_ntests_failed(sr);
+
+	srunner_free(sr);
+
+	printf("numFailed = %d\n", numFailed);
+
+	return (numFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
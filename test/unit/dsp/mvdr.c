@@ -0,0 +1,154 @@
+/**
+ ******************************************************************************
+ * @file 	mvdr.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Unit test for the MVDR beamformer.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#define _GNU_SOURCE
+#include <check.h>
+#include "../../../src/dsp/dsp_ext.h"
+
+#define TOLERANCE								1e-9
+#define MICS									8
+#define RADIUS									0.1		/* meter */
+#define FREQ									1000.0	/* Hz */
+#define SAMPLE_FREQ							12000.0	/* Hz */
+#define LENGTH									512
+
+static DspTime samples[MICS];
+
+/**
+ * Return the amplitude of the `freq` Hz tone in the sample.
+ */
+static double tone_amplitude(const DspTime *sample, double freq)
+{
+	len_t t;
+	double real = 0.0, imag = 0.0;
+
+	for (t = 0; t < sample->length; t++)
+	{
+		real += sample->data[t] * cos(2.0 * M_PI * freq * t / SAMPLE_FREQ);
+		imag += sample->data[t] * sin(2.0 * M_PI * freq * t / SAMPLE_FREQ);
+	}
+	return 2.0 * hypot(real, imag) / sample->length;
+}
+
+START_TEST(mvdr_nulls_interference)
+{
+	int i;
+	len_t t;
+	double target, jammer, delay, covariance[MAX_MICS][MAX_MICS];
+	double weights[MAX_MICS][2], gain[2];
+	static unsigned char storage[65536];
+	static DspTime white, result;
+	DspArena arena;
+	DspArrival arrival;
+	DspBeamform beamform;
+	DspMvdr mvdr;
+	DspMusicTracker tracker;
+
+	printf("\n[TEST] Testing MVDR beamforming on the covariance...\n");
+
+	/* A tone from 40 degrees and a louder one from 130 degrees, both on
+		the bins of the frame. */
+	arrival.mics = beamform.mics = MICS;
+	arrival.radius = beamform.radius = RADIUS;
+	arrival.freq = beamform.freq = 937.5;
+	arrival.sources = 2;
+	beamform.theta = 40.0;
+	dsp_time_randn(MICS * LENGTH, &white);
+	for (i = 0; i < MICS; i++)
+	{
+		target = RADIUS * cos(40.0 * M_PI / 180.0 - 2.0 * M_PI * i / MICS) /
+			SOUND_SPEED;
+		jammer = RADIUS * cos(130.0 * M_PI / 180.0 - 2.0 * M_PI * i / MICS) /
+			SOUND_SPEED;
+		samples[i].length = LENGTH;
+		for (t = 0; t < LENGTH; t++)
+		{
+			samples[i].data[t] = 0.01 * white.data[i * LENGTH + t] +
+				cos(2.0 * M_PI * 937.5 * (t / SAMPLE_FREQ + target)) +
+				3.0 * cos(2.0 * M_PI * 1500.0 * (t / SAMPLE_FREQ + jammer));
+		}
+		arrival.samples[i] = beamform.samples[i] = &samples[i];
+	}
+	dsp_covariance(&arrival, covariance);
+	ck_assert_int_eq(dsp_mvdr_init(&mvdr, MICS,
+		(const double (*)[MAX_MICS]) covariance, 0.001), 1);
+
+	/* The weights are distortionless toward the look direction. */
+	dsp_mvdr_weights(&mvdr, RADIUS, FREQ, 40.0, weights);
+	gain[0] = gain[1] = 0.0;
+	for (i = 0; i < MICS; i++)
+	{
+		delay = 2.0 * M_PI * FREQ * RADIUS / SOUND_SPEED *
+			cos(40.0 * M_PI / 180.0 - 2.0 * M_PI * i / MICS);
+		gain[0] += weights[i][0] * cos(delay) + weights[i][1] * sin(delay);
+		gain[1] += weights[i][0] * sin(delay) - weights[i][1] * cos(delay);
+	}
+	ck_assert_double_eq_tol(gain[0], 1.0, TOLERANCE);
+	ck_assert_double_eq_tol(gain[1], 0.0, TOLERANCE);
+
+	/* The target passes at unit gain and the loud one is nulled. */
+	dsp_arena_init(&arena, storage, sizeof(storage));
+	dsp_beamform_capon(&beamform, &mvdr, SAMPLE_FREQ, &result, &arena);
+	ck_assert_uint_eq(result.length, LENGTH);
+	ck_assert_double_eq_tol(tone_amplitude(&result, 937.5), 1.0, 0.02);
+	ck_assert_double_le(tone_amplitude(&result, 1500.0), 0.03);
+	ck_assert_uint_eq(dsp_arena_mark(&arena), 0);
+
+	/* The tracker of a single frame holds the same covariance. */
+	dsp_music_tracker_init(&tracker, 0.0, 1);
+	dsp_arrival_music_track(&tracker, &arrival);
+	ck_assert_double_eq_tol(tracker.covariance[2][5],
+		covariance[2][5], TOLERANCE);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+Suite *mvdr_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("MVDR");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, mvdr_nulls_interference);
+
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
+
+int main(int argc, char *argv[])
+{
+	int numFailed = 0;
+	Suite *s;
+	SRunner *sr;
+
+	s = mvdr_suite();
+	sr = srunner_create(s);
+
+	srunner_run_all(sr, CK_NORMAL);
+
+	numFailed = srunner_ntests_failed(sr);
+
+	srunner_free(sr);
+
+	printf("numFailed = %d\n", numFailed);
+
+	return (numFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
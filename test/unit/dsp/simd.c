@@ -0,0 +1,171 @@
+/**
+ ******************************************************************************
+ * @file 	simd.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Unit test for SIMD elementwise kernels against the DSP library.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include <check.h>
+#include "../../../src/dsp/dsp_ext.h"
+
+#define TOLERANCE								1e-12
+
+static DspTime fsample, ssample, expected, output, ones;
+static DspFreq spectrum;
+
+/**
+ * Compare the output view with the `expected` sample of DSP library.
+ */
+static void compare_with_library(const DspTimeView *result)
+{
+	len_t i;
+
+	ck_assert_uint_eq(result->length, expected.length);
+	for (i = 0; i < expected.length; i++)
+	{
+		ck_assert_double_eq_tol(result->data[i], expected.data[i], TOLERANCE);
+	}
+}
+
+/**
+ * Run all elementwise methods on the samples of `length` and compare them.
+ */
+static void compare_methods(len_t length)
+{
+	len_t i;
+	DspTimeView fview, sview, result;
+	DspFreqView bins;
+
+	dsp_time_randn(length, &fsample);
+	dsp_time_randn(length, &ssample);
+	fview = dsp_time_view_of(&fsample);
+	sview = dsp_time_view_of(&ssample);
+	output.length = length;
+	result = dsp_time_view_of(&output);
+
+	dsp_time_add(&fsample, &ssample, &expected);
+	dsp_view_add(&fview, &sview, &result);
+	compare_with_library(&result);
+
+	dsp_time_dot_mul(&fsample, &ssample, &expected);
+	dsp_view_dot_mul(&fview, &sview, &result);
+	compare_with_library(&result);
+
+	dsp_time_scalar_mul(&fsample, -2.5, &expected);
+	dsp_view_scalar_mul(&fview, -2.5, &result);
+	compare_with_library(&result);
+
+	dsp_time_scale(&fsample, 128.0, &expected);
+	dsp_view_scale(&fview, 128.0, &result);
+	compare_with_library(&result);
+
+	dsp_time_abs(&fsample, &expected);
+	dsp_view_abs(&fview, &result);
+	compare_with_library(&result);
+
+	/* dsp_time_clip() of library has AMD XOP instructions, which most of
+		the CPUs lack, so the expected sample is clipped here. */
+	expected.length = length;
+	for (i = 0; i < length; i++)
+	{
+		expected.data[i] = fmin(fmax(fsample.data[i], -0.5), 0.75);
+	}
+	dsp_view_clip(&fview, -0.5, 0.75, &result);
+	compare_with_library(&result);
+
+	/* The window of library is taken from a sample of ones. */
+	if (length > 1)
+	{
+		ones.length = length;
+		for (i = 0; i < length; i++)
+		{
+			ones.data[i] = 1.0;
+		}
+		dsp_window_blackman(&ones, &ssample);
+		dsp_window_blackman(&fsample, &expected);
+		dsp_view_window(&fview, ssample.data, &result);
+		compare_with_library(&result);
+	}
+
+	dsp_transform_fft(&fsample, &spectrum);
+	dsp_freq_magnitude(&spectrum, &expected);
+	bins = dsp_freq_view_of(&spectrum);
+	dsp_view_magnitude(&bins, &result);
+	ck_assert_uint_eq(result.length, expected.length);
+	for (i = 0; i < expected.length; i++)
+	{
+		ck_assert_double_eq_tol(result.data[i], expected.data[i],
+			TOLERANCE * length);
+	}
+}
+
+START_TEST(simd_every_level)
+{
+	int level;
+	DspSimdLevel best;
+
+	best = dsp_simd_detect();
+	for (level = DSP_SIMD_SCALAR; level <= DSP_SIMD_AVX512; level++)
+	{
+		printf("\n[TEST] Testing %s elementwise kernels...\n",
+			dsp_simd_name(level));
+
+		/* The levels that the CPU lacks are capped at the best one. */
+		ck_assert_int_eq(dsp_simd_select(level), (level > best) ? best : level);
+		ck_assert_int_eq(dsp_simd_level(), (level > best) ? best : level);
+
+		compare_methods(1);
+		compare_methods(7);
+		compare_methods(64);
+		compare_methods(515);
+
+		printf("Passed.\n");
+	}
+	dsp_simd_select(best);
+}
+END_TEST
+
+Suite *simd_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("SIMD");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, simd_every_level);
+
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
+
+int main(int argc, char *argv[])
+{
+	int numFailed = 0;
+	Suite *s;
+	SRunner *sr;
+
+	s = simd_suite();
+	sr = srunner_create(s);
+
+	srunner_run_all(sr, CK_NORMAL);
+
+	numFailed = srunner_ntests_failed(sr);
+
+	srunner_free(sr);
+
+	printf("numFailed = %d\n", numFailed);
+
+	return (numFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
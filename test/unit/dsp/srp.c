@@ -0,0 +1,137 @@
+/**
+ ******************************************************************************
+ * @file 	srp.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Unit test for wideband SRP-PHAT.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#define _GNU_SOURCE
+#include <check.h>
+#include "../../../src/dsp/dsp_ext.h"
+
+#define MICS									8
+#define RADIUS									0.1		/* meter */
+#define SAMPLE_FREQ							12000.0	/* Hz */
+#define LENGTH									512
+
+static DspTime samples[MICS];
+
+/**
+ * Fill the mics with the harmonics of a rotor of `fundamental` Hz coming
+ * from `theta` degrees plus the white noise of `noise` deviation. Each
+ * draw of the library starts from the same seed, so the mics take their
+ * own slices of a single draw to keep the noise uncorrelated.
+ */
+static void rotor_wave(DspArrival *arrival, double theta, double fundamental,
+	double noise)
+{
+	int i, h;
+	len_t t;
+	double delay;
+	static DspTime white;
+
+	arrival->mics = MICS;
+	arrival->freq = fundamental;
+	arrival->radius = RADIUS;
+	arrival->sources = 1;
+	dsp_time_randn(MICS * LENGTH, &white);
+	for (i = 0; i < MICS; i++)
+	{
+		delay = RADIUS * cos(theta * M_PI / 180.0 - 2.0 * M_PI * i / MICS) /
+			SOUND_SPEED;
+		samples[i].length = LENGTH;
+		for (t = 0; t < LENGTH; t++)
+		{
+			samples[i].data[t] = noise * white.data[i * LENGTH + t];
+			for (h = 1; h <= 12; h++)
+			{
+				samples[i].data[t] += cos(2.0 * M_PI * fundamental * h *
+					(t / SAMPLE_FREQ + delay) + h);
+			}
+		}
+		arrival->samples[i] = &samples[i];
+	}
+}
+
+START_TEST(srp_phat_wideband)
+{
+	double theta, serial, parallel, distance;
+	static unsigned char storage[65536];
+	DspArena arena;
+	DspPool pool;
+	DspArrival arrival;
+
+	printf("\n[TEST] Testing wideband SRP-PHAT on a pool...\n");
+
+	/* The bins of the pool are summed in the same order as the serial
+		ones, so the bearings agree whatever the number of workers. The
+		parabola over the 4-degree grid is a little biased. */
+	dsp_arena_init(&arena, storage, sizeof(storage));
+	dsp_pool_init(&pool, 3);
+	ck_assert_int_eq(dsp_pool_size(&pool), 4);
+	for (theta = 0.0; theta < 360.0; theta += 13.7)
+	{
+		rotor_wave(&arrival, theta, 180.0, 0.3);
+		serial = dsp_arrival_srp_phat(&arrival, SAMPLE_FREQ, 200.0, 3000.0,
+			NULL, &arena);
+		parallel = dsp_arrival_srp_phat(&arrival, SAMPLE_FREQ, 200.0, 3000.0,
+			&pool, &arena);
+		ck_assert_double_eq_tol(serial, parallel, 1e-6);
+		distance = fabs(parallel - theta);
+		ck_assert_double_le(fmin(distance, 360.0 - distance), 1.5);
+	}
+	ck_assert_uint_eq(dsp_arena_mark(&arena), 0);
+
+	/* A band without any bin gives no arrival. */
+	ck_assert_double_eq(dsp_arrival_srp_phat(&arrival, SAMPLE_FREQ, 10.0,
+		11.0, &pool, &arena), 0.0);
+	dsp_pool_free(&pool);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+Suite *srp_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("SRP-PHAT");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, srp_phat_wideband);
+
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
+
+int main(int argc, char *argv[])
+{
+	int numFailed = 0;
+	Suite *s;
+	SRunner *sr;
+
+	s = srp_suite();
+	sr = srunner_create(s);
+
+	srunner_run_all(sr, CK_NORMAL);
+
+	numFailed = srunner_ntests_failed(sr);
+
+	srunner_free(sr);
+
+	printf("numFailed = %d\n", numFailed);
+
+	return (numFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,154 @@
+/**
+ ******************************************************************************
+ * @file 	tdoa.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Unit test for GCC-PHAT delays and their bearing.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#define _GNU_SOURCE
+#include <check.h>
+#include "../../../src/dsp/dsp_ext.h"
+
+#define TOLERANCE								1e-9
+#define MICS									8
+#define RADIUS									0.1		/* meter */
+#define FREQ									1000.0	/* Hz */
+#define SAMPLE_FREQ							12000.0	/* Hz */
+#define LENGTH									512
+
+static DspTime samples[MICS];
+
+/**
+ * Fill the mics with a broadband source coming from `theta` degrees plus
+ * the white noise of `noise` deviation. The source is delayed by a phase
+ * ramp of its spectrum, so the delays aren't rounded to the samples.
+ */
+static void broadband_wave(DspArrival *arrival, double theta, double noise)
+{
+	int i;
+	len_t k;
+	double delay, phase;
+	static DspTime white;
+	static DspFreq source, spectrum;
+
+	arrival->mics = MICS;
+	arrival->freq = FREQ;
+	arrival->radius = RADIUS;
+	arrival->sources = 1;
+	dsp_time_randn((MICS + 2) * (LENGTH / 2), &white);
+	white.length = LENGTH;
+	dsp_transform_fft(&white, &source);
+	for (i = 0; i < MICS; i++)
+	{
+		delay = RADIUS * cos(theta * M_PI / 180.0 - 2.0 * M_PI * i / MICS) /
+			SOUND_SPEED;
+		spectrum.length = LENGTH;
+		for (k = 0; k <= LENGTH / 2; k++)
+		{
+			phase = 2.0 * M_PI * k * SAMPLE_FREQ / LENGTH * delay;
+			spectrum.data[k][0] = source.data[k][0] * cos(phase) -
+				source.data[k][1] * sin(phase);
+			spectrum.data[k][1] = source.data[k][0] * sin(phase) +
+				source.data[k][1] * cos(phase);
+			if (k == LENGTH / 2)
+			{
+				spectrum.data[k][1] = 0.0;
+			}
+			else if (k > 0)
+			{
+				spectrum.data[LENGTH - k][0] = spectrum.data[k][0];
+				spectrum.data[LENGTH - k][1] = -spectrum.data[k][1];
+			}
+		}
+		dsp_transform_ifft(&spectrum, &samples[i]);
+		for (k = 0; k < LENGTH; k++)
+		{
+			samples[i].data[k] += noise * white.data[(i + 1) * (LENGTH / 2) + k];
+		}
+		arrival->samples[i] = &samples[i];
+	}
+}
+
+START_TEST(gcc_phat_tdoa)
+{
+	int p;
+	double theta, expected, distance;
+	static unsigned char storage[65536];
+	static DspTdoa tdoa;
+	DspArena arena;
+	DspArrival arrival;
+	DspDirection direction;
+
+	printf("\n[TEST] Testing GCC-PHAT delays and their bearing...\n");
+
+	/* The delay of a pair is the lead of the first mic over the second,
+		to a fraction of a sample. */
+	dsp_arena_init(&arena, storage, sizeof(storage));
+	for (theta = 0.0; theta < 360.0; theta += 13.7)
+	{
+		broadband_wave(&arrival, theta, 0.3);
+		ck_assert_int_eq(dsp_tdoa_gcc_phat(&arrival, SAMPLE_FREQ, &tdoa,
+			&arena), MICS * (MICS - 1) / 2);
+		for (p = 0; p < tdoa.pairs; p++)
+		{
+			expected = RADIUS / SOUND_SPEED * (cos(theta * M_PI / 180.0 -
+				2.0 * M_PI * tdoa.first[p] / MICS) - cos(theta * M_PI / 180.0 -
+				2.0 * M_PI * tdoa.second[p] / MICS));
+			ck_assert_double_eq_tol(tdoa.delay[p] * SAMPLE_FREQ,
+				expected * SAMPLE_FREQ, 0.5);
+			ck_assert_double_le(tdoa.weight[p], 1.0 + TOLERANCE);
+		}
+		ck_assert_int_eq(dsp_arrival_tdoa(&tdoa, RADIUS, &direction), 1);
+		distance = fabs(direction.azimuth - theta);
+		ck_assert_double_le(fmin(distance, 360.0 - distance), 2.0);
+	}
+	ck_assert_uint_eq(dsp_arena_mark(&arena), 0);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+Suite *tdoa_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("GCC-PHAT");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, gcc_phat_tdoa);
+
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
+
+int main(int argc, char *argv[])
+{
+	int numFailed = 0;
+	Suite *s;
+	SRunner *sr;
+
+	s = tdoa_suite();
+	sr = srunner_create(s);
+
+	srunner_run_all(sr, CK_NORMAL);
+
+	numFailed = srunner_ntests_failed(sr);
+
+	srunner_free(sr);
+
+	printf("numFailed = %d\n", numFailed);
+
+	return (numFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
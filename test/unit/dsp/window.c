@@ -0,0 +1,195 @@
+/**
+ ******************************************************************************
+ * @file 	window.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Unit test for the cached window tables.
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ *
+ * This software is licensed under the MIT License.
+ *
+ ******************************************************************************
+ */
+
+#include <check.h>
+#include "../../../src/dsp/dsp_ext.h"
+
+#define TOLERANCE								1e-9
+#define LENGTH									512
+
+static DspTime sample, expected;
+
+START_TEST(window_table_matches_library)
+{
+	len_t t;
+	const DspWindowTable *table;
+
+	printf("\n[TEST] Testing dsp_window_table() against the library...\n");
+
+	dsp_time_randn(LENGTH, &sample);
+
+	dsp_window_hamming(&sample, &expected);
+	table = dsp_window_table(DSP_WINDOW_HAMMING, LENGTH, 0);
+	for (t = 0; t < LENGTH; t++)
+	{
+		ck_assert_double_eq_tol(sample.data[t] * table->coeffs[t],
+			expected.data[t], TOLERANCE);
+	}
+
+	dsp_window_hanning(&sample, &expected);
+	table = dsp_window_table(DSP_WINDOW_HANNING, LENGTH, 0);
+	for (t = 0; t < LENGTH; t++)
+	{
+		ck_assert_double_eq_tol(sample.data[t] * table->coeffs[t],
+			expected.data[t], TOLERANCE);
+	}
+
+	dsp_window_blackman(&sample, &expected);
+	table = dsp_window_table(DSP_WINDOW_BLACKMAN, LENGTH, 0);
+	for (t = 0; t < LENGTH; t++)
+	{
+		ck_assert_double_eq_tol(sample.data[t] * table->coeffs[t],
+			expected.data[t], TOLERANCE);
+	}
+
+	dsp_window_chebyshev(&sample, 60, &expected);
+	table = dsp_window_table(DSP_WINDOW_CHEBYSHEV, LENGTH, 60);
+	for (t = 0; t < LENGTH; t++)
+	{
+		ck_assert_double_eq_tol(sample.data[t] * table->coeffs[t],
+			expected.data[t], TOLERANCE * fabs(expected.data[t]) + TOLERANCE);
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(window_table_is_cached)
+{
+	const DspWindowTable *table;
+
+	printf("\n[TEST] Testing the keys of window cache...\n");
+
+	/* The same key gives the same table, the factor is a key of Kaiser. */
+	table = dsp_window_table(DSP_WINDOW_KAISER, LENGTH, 60);
+	ck_assert_ptr_eq(dsp_window_table(DSP_WINDOW_KAISER, LENGTH, 60), table);
+	ck_assert_ptr_ne(dsp_window_table(DSP_WINDOW_KAISER, LENGTH, 40), table);
+	ck_assert_ptr_ne(dsp_window_table(DSP_WINDOW_KAISER, LENGTH / 2, 60),
+		table);
+
+	/* The factor isn't a key of the cosine windows. */
+	table = dsp_window_table(DSP_WINDOW_HANNING, LENGTH, 0);
+	ck_assert_ptr_eq(dsp_window_table(DSP_WINDOW_HANNING, LENGTH, 30), table);
+	ck_assert_ptr_ne(dsp_window_table(DSP_WINDOW_HAMMING, LENGTH, 0), table);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(window_kaiser_shape)
+{
+	len_t t;
+	double beta;
+	const DspWindowTable *table;
+
+	printf("\n[TEST] Testing Kaiser window...\n");
+
+	/* Symmetric, 1 at the center and 1 / I0(beta) at the edges, where
+		I0(5.65326) = 49.05 for 60 dB. */
+	beta = 0.1102 * (60 - 8.7);
+	ck_assert_double_eq_tol(beta, 5.65326, 1e-9);
+	table = dsp_window_table(DSP_WINDOW_KAISER, LENGTH + 1, 60);
+	ck_assert_double_eq_tol(table->coeffs[LENGTH / 2], 1.0, TOLERANCE);
+	ck_assert_double_eq_tol(table->coeffs[0], 1.0 / 49.05, 1e-4);
+	for (t = 0; t < LENGTH / 2; t++)
+	{
+		ck_assert_double_eq_tol(table->coeffs[t], table->coeffs[LENGTH - t],
+			TOLERANCE);
+		ck_assert_double_le(table->coeffs[t], table->coeffs[t + 1]);
+	}
+
+	/* No shape below 21 dB, it's the rectangle. */
+	table = dsp_window_table(DSP_WINDOW_KAISER, LENGTH, 20);
+	for (t = 0; t < LENGTH; t++)
+	{
+		ck_assert_double_eq_tol(table->coeffs[t], 1.0, TOLERANCE);
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(window_apply_in_place)
+{
+	len_t t;
+	DspTimeView view;
+	DspTimeViewF32 single;
+	static float data[LENGTH];
+
+	printf("\n[TEST] Testing dsp_window_apply() in place...\n");
+
+	dsp_time_randn(LENGTH, &sample);
+	dsp_window_blackman(&sample, &expected);
+	for (t = 0; t < LENGTH; t++)
+	{
+		data[t] = (float) sample.data[t];
+	}
+
+	view = dsp_time_view_of(&sample);
+	dsp_window_apply(DSP_WINDOW_BLACKMAN, 0, &view);
+	ck_assert_uint_eq(view.length, LENGTH);
+
+	single.data = data;
+	single.length = single.capacity = LENGTH;
+	dsp_window_apply_f32(DSP_WINDOW_BLACKMAN, 0, &single);
+	for (t = 0; t < LENGTH; t++)
+	{
+		ck_assert_double_eq_tol(sample.data[t], expected.data[t], TOLERANCE);
+		ck_assert_double_eq_tol(data[t], expected.data[t], 1e-5);
+	}
+
+	printf("Passed.\n");
+}
+END_TEST
+
+Suite *window_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Window");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, window_table_matches_library);
+	tcase_add_test(tc_core, window_table_is_cached);
+	tcase_add_test(tc_core, window_kaiser_shape);
+	tcase_add_test(tc_core, window_apply_in_place);
+
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
+
+int main(int argc, char *argv[])
+{
+	int numFailed = 0;
+	Suite *s;
+	SRunner *sr;
+
+	s = window_suite();
+	sr = srunner_create(s);
+
+	srunner_run_all(sr, CK_NORMAL);
+
+	numFailed = srunner_ntests_failed(sr);
+
+	srunner_free(sr);
+
+	printf("numFailed = %d\n", numFailed);
+
+	return (numFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,236 @@
+/**
+ ******************************************************************************
+ * @file 	codec.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Unit test for the compact payload encoding.
+ * 
+ ******************************************************************************
+ * @attention
+ * 
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ * 
+ * This software is licensed under the MIT License.
+ * 
+ ******************************************************************************
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <check.h>
+#include "../../../common/payload.h"
+
+static PayloadData sent, received;
+static uint8_t encoded[PAYLOAD_MAX_ENCODED];
+
+/**
+ * Fill the microphone channels with a tone or with white noise.
+ */
+static void fill_mics(PayloadData *data, int noise)
+{
+	int i, j;
+	int8_t *channels[PAYLOAD_MIC_COUNT] = {
+		data->micNorth, data->micNorthEast, data->micEast, data->micSouthEast,
+		data->micSouth, data->micSouthWest, data->micWest, data->micNorthWest
+	};
+
+	for (i = 0; i < PAYLOAD_MIC_COUNT; i++)
+	{
+		for (j = 0; j < PAYLOAD_MIC_SIZE; j++)
+		{
+			channels[i][j] = noise ? (int8_t) rand() :
+				(int8_t) (100.0 * sin(2.0 * M_PI * j / 48.0 + i));
+		}
+	}
+}
+
+/**
+ * Fill the GPS and IMU fields with a typical fix.
+ */
+static void fill_sensors(PayloadData *data)
+{
+	strcpy(data->gpsUTCTime, "083519");
+	strcpy(data->gpsLatitude, "41.0082376");
+	strcpy(data->gpsLongitude, "-28.9783589");
+	strcpy(data->gpsQuality, "1");
+	strcpy(data->gpsNumSat, "8");
+	strcpy(data->gpsAltitude, "545.4");
+	strcpy(data->gpsStatus, "A");
+	strcpy(data->gpsSpeed, "22.4");
+	strcpy(data->gpsCourse, "84.4");
+	strcpy(data->gpsDate, "030394");
+
+	data->imuAccelX = 0.125f;
+	data->imuAccelY = -9.81f;
+	data->imuAccelZ = 3.5e-3f;
+	data->imuGyroX = 1.75f;
+	data->imuGyroY = -0.07f;
+	data->imuGyroZ = 250.0f;
+	data->imuTemp = 27.25f;
+}
+
+START_TEST(payload_round_trip_tone)
+{
+	size_t size;
+
+	printf("\n[TEST] Testing payload round trip with tone...\n");
+
+	memset(&sent, 0, sizeof(PayloadData));
+	memset(&received, 0, sizeof(PayloadData));
+	fill_mics(&sent, 0);
+	fill_sensors(&sent);
+
+	size = payload_encode(&sent, PAYLOAD_HAS_ALL, encoded);
+	printf("encoded %zu bytes (raw %zu bytes)\n", size, sizeof(PayloadData));
+
+	ck_assert_uint_lt(size, PAYLOAD_MIC_COUNT * PAYLOAD_MIC_SIZE * 3 / 4);
+	ck_assert_int_eq(payload_decode(encoded, size, &received), PAYLOAD_HAS_ALL);
+	ck_assert_mem_eq(&sent, &received, sizeof(PayloadData));
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(payload_round_trip_noise)
+{
+	size_t size;
+
+	printf("\n[TEST] Testing payload round trip with noise...\n");
+
+	memset(&sent, 0, sizeof(PayloadData));
+	memset(&received, 0, sizeof(PayloadData));
+	fill_mics(&sent, 1);
+
+	/* The noise doesn't compress, so the channels must be sent raw. */
+	size = payload_encode(&sent, PAYLOAD_HAS_MIC, encoded);
+
+	ck_assert_uint_eq(size, 1 + PAYLOAD_MIC_COUNT * (1 + PAYLOAD_MIC_SIZE));
+	ck_assert_int_eq(payload_decode(encoded, size, &received), PAYLOAD_HAS_MIC);
+	ck_assert_mem_eq(&sent, &received, sizeof(PayloadData));
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(payload_gps_fixed_point)
+{
+	size_t size;
+
+	printf("\n[TEST] Testing payload GPS fixed-point fields...\n");
+
+	memset(&sent, 0, sizeof(PayloadData));
+	memset(&received, 0, sizeof(PayloadData));
+	strcpy(sent.gpsLatitude, "41.008");
+	strcpy(sent.gpsSpeed, "022.45");
+	strcpy(sent.gpsCourse, "99999");
+
+	size = payload_encode(&sent, PAYLOAD_HAS_GPS, encoded);
+
+	ck_assert_uint_eq(size, 1 + 27);
+	ck_assert_int_eq(payload_decode(encoded, size, &received), PAYLOAD_HAS_GPS);
+	ck_assert_str_eq(received.gpsLatitude, "41.0080000");
+	ck_assert_str_eq(received.gpsSpeed, "22.4");		/* truncated */
+	ck_assert_str_eq(received.gpsCourse, "3276.7");	/* saturated */
+	ck_assert_str_eq(received.gpsUTCTime, "");		/* empty */
+	ck_assert_str_eq(received.gpsStatus, "");
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(payload_presence_mask)
+{
+	size_t size;
+
+	printf("\n[TEST] Testing payload field-presence mask...\n");
+
+	memset(&sent, 0, sizeof(PayloadData));
+	fill_mics(&sent, 0);
+	fill_sensors(&sent);
+	received = sent;
+
+	/* The absent sections keep their previous values. */
+	fill_mics(&sent, 1);
+	sent.imuTemp = 30.0f;
+	strcpy(sent.gpsStatus, "V");
+
+	size = payload_encode(&sent, PAYLOAD_HAS_MIC | PAYLOAD_HAS_IMU, encoded);
+
+	ck_assert_int_eq(payload_decode(encoded, size, &received),
+		PAYLOAD_HAS_MIC | PAYLOAD_HAS_IMU);
+	ck_assert_mem_eq(sent.micNorth, received.micNorth, PAYLOAD_MIC_SIZE);
+	ck_assert_float_eq(received.imuTemp, 30.0f);
+	ck_assert_str_eq(received.gpsStatus, "A");
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(payload_malformed)
+{
+	size_t size;
+
+	printf("\n[TEST] Testing payload decoding of malformed data...\n");
+
+	memset(&sent, 0, sizeof(PayloadData));
+	fill_mics(&sent, 0);
+	fill_sensors(&sent);
+
+	size = payload_encode(&sent, PAYLOAD_HAS_ALL, encoded);
+
+	ck_assert_int_eq(payload_decode(encoded, size - 1, &received), -1);
+	ck_assert_int_eq(payload_decode(encoded, 0, &received), -1);
+
+	encoded[0] = 0x80;		/* unknown section */
+	ck_assert_int_eq(payload_decode(encoded, size, &received), -1);
+
+	encoded[0] = PAYLOAD_HAS_ALL;
+	encoded[2] = 9;			/* bit width of first block */
+	ck_assert_int_eq(payload_decode(encoded, size, &received), -1);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+Suite *payload_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Payload");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, payload_round_trip_tone);
+	tcase_add_test(tc_core, payload_round_trip_noise);
+	tcase_add_test(tc_core, payload_gps_fixed_point);
+	tcase_add_test(tc_core, payload_presence_mask);
+	tcase_add_test(tc_core, payload_malformed);
+
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
+
+int main(int argc, char *argv[])
+{
+	int numFailed = 0;
+	Suite *s;
+	SRunner *sr;
+
+	s = payload_suite();
+	sr = srunner_create(s);
+
+	srunner_run_all(sr, CK_NORMAL);
+
+	numFailed = srunner_ntests_failed(sr);
+
+	srunner_free(sr);
+
+	printf("numFailed = %d\n", numFailed);
+
+	return (numFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
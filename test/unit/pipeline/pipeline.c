@@ -0,0 +1,304 @@
+/**
+ ******************************************************************************
+ * @file 	pipeline.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Unit test for the GUI-free analysis pipeline.
+ * 
+ ******************************************************************************
+ * @attention
+ * 
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ * 
+ * This software is licensed under the MIT License.
+ * 
+ ******************************************************************************
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <check.h>
+#include "../../../src/pipeline.h"
+
+static Pipeline pipeline;
+static PayloadData frame;
+
+/**
+ * Fill the microphone channels with a tone at the `bin` and make the
+ * `loudest` channel biased.
+ */
+static void fill_mics(PayloadData *data, int bin, int loudest)
+{
+	int i, j;
+	int8_t *channels[MIC_COUNT] = {
+		data->micNorth, data->micNorthEast, data->micEast, data->micSouthEast,
+		data->micSouth, data->micSouthWest, data->micWest, data->micNorthWest
+	};
+
+	for (i = 0; i < MIC_COUNT; i++)
+	{
+		for (j = 0; j < PIPELINE_DATA_SIZE; j++)
+		{
+			channels[i][j] = (int8_t) (60.0 * sin(2.0 * M_PI * bin * j /
+				PIPELINE_DATA_SIZE + 0.3 * i) + ((i == loudest) ? 10 : 0));
+		}
+	}
+}
+
+/**
+ * Fill the microphone channels with a plane wave of `freq` Hz coming from
+ * the `bearing` degrees, clockwise from the north.
+ */
+static void fill_plane_wave(PayloadData *data, double freq, double bearing)
+{
+	int i, j;
+	double delay;
+	int8_t *channels[MIC_COUNT] = {
+		data->micNorth, data->micNorthEast, data->micEast, data->micSouthEast,
+		data->micSouth, data->micSouthWest, data->micWest, data->micNorthWest
+	};
+
+	for (i = 0; i < MIC_COUNT; i++)
+	{
+		delay = MIC_RADIUS * cos((bearing - 360.0 * i / MIC_COUNT) * M_PI /
+			180.0) / SOUND_SPEED;
+		for (j = 0; j < PIPELINE_DATA_SIZE; j++)
+		{
+			channels[i][j] = (int8_t) lround(60.0 * sin(2.0 * M_PI * freq *
+				((double) j / MIC_SAMPLE_FREQ + delay)));
+		}
+	}
+}
+
+/**
+ * Fill the microphone channels with a plane wave of the tones over the
+ * band coming from the `bearing` degrees, clockwise from the north.
+ */
+static void fill_wideband_wave(PayloadData *data, double bearing)
+{
+	int i, j, k;
+	double delay, value, freq;
+	int8_t *channels[MIC_COUNT] = {
+		data->micNorth, data->micNorthEast, data->micEast, data->micSouthEast,
+		data->micSouth, data->micSouthWest, data->micWest, data->micNorthWest
+	};
+
+	for (i = 0; i < MIC_COUNT; i++)
+	{
+		delay = MIC_RADIUS * cos((bearing - 360.0 * i / MIC_COUNT) * M_PI /
+			180.0) / SOUND_SPEED;
+		for (j = 0; j < PIPELINE_DATA_SIZE; j++)
+		{
+			value = 0.0;
+			for (k = 0; k < 8; k++)
+			{
+				freq = PIPELINE_BAND_LOW + 330.0 * k + 50.0;
+				value += 14.0 * sin(2.0 * M_PI * freq * ((double) j /
+					MIC_SAMPLE_FREQ + delay) + 0.7 * k * k);
+			}
+			channels[i][j] = (int8_t) lround(value);
+		}
+	}
+}
+
+/**
+ * Prepare the pipeline before each test.
+ */
+static void setup(void)
+{
+	pipeline_init(&pipeline, PIPELINE_FLOAT64);
+}
+
+START_TEST(pipeline_init_clears)
+{
+	int i;
+
+	/* The results of a reused pipeline are cleared before its first scan. */
+	memset(&pipeline, 0xa5, sizeof(Pipeline));
+	pipeline_init(&pipeline, PIPELINE_FLOAT64);
+
+	ck_assert_double_eq(pipeline.frequency, 0.0);
+	ck_assert_int_eq(pipeline.arrival, 0);
+	ck_assert_int_eq(pipeline.sector, 0);
+	for (i = 0; i < PIPELINE_SCAN_ANGLES; i++)
+	{
+		ck_assert_double_eq(pipeline.power[i], 0.0);
+	}
+	ck_assert_int_eq(pipeline_sector(&pipeline), 1);
+}
+END_TEST
+
+START_TEST(pipeline_load)
+{
+	fill_mics(&frame, 5, 0);
+	pipeline_load_samples(&pipeline, &frame);
+
+	ck_assert_uint_eq(pipeline.samples[0].length, PIPELINE_DATA_SIZE);
+	ck_assert_uint_eq(pipeline.samples[7].length, PIPELINE_DATA_SIZE);
+	ck_assert_double_eq(pipeline.samples[2].data[17], frame.micEast[17]);
+	ck_assert_double_eq(pipeline.samples[7].data[511], frame.micNorthWest[511]);
+}
+END_TEST
+
+START_TEST(pipeline_frequency)
+{
+	int bin;
+
+	for (bin = 1; bin < PIPELINE_DATA_SIZE / 2; bin += 37)
+	{
+		fill_mics(&frame, bin, 0);
+		pipeline_load_samples(&pipeline, &frame);
+		ck_assert_double_eq(pipeline_dominant_freq(&pipeline),
+			(double) MIC_SAMPLE_FREQ / PIPELINE_DATA_SIZE * bin);
+	}
+}
+END_TEST
+
+START_TEST(pipeline_frequency_f32)
+{
+	int bin;
+
+	pipeline_init(&pipeline, PIPELINE_FLOAT32);
+	for (bin = 1; bin < PIPELINE_DATA_SIZE / 2; bin += 37)
+	{
+		fill_mics(&frame, bin, 0);
+		pipeline_load_samples(&pipeline, &frame);
+		ck_assert_double_eq(pipeline_dominant_freq(&pipeline),
+			(double) MIC_SAMPLE_FREQ / PIPELINE_DATA_SIZE * bin);
+	}
+}
+END_TEST
+
+START_TEST(pipeline_loudest_sector)
+{
+	int mic, loudest;
+
+	/* The map peaks at the bearing and its sector is the nearest mic. */
+	for (mic = 0; mic < MIC_COUNT; mic++)
+	{
+		fill_plane_wave(&frame, 1500.0, 45.0 * mic + 10.0);
+		pipeline_load_samples(&pipeline, &frame);
+		loudest = pipeline_scan(&pipeline);
+		ck_assert_int_eq(loudest, (mic * 45 + 10) / 5);
+		ck_assert_int_eq(pipeline_sector(&pipeline), mic + 1);
+	}
+}
+END_TEST
+
+START_TEST(pipeline_run_srp)
+{
+	/* The wideband stage takes its bins after the spectral ones. */
+	pipeline_srp(&pipeline, NULL);
+	fill_plane_wave(&frame, 1500.0, 100.0);
+	pipeline_run(&pipeline, &frame);
+
+	ck_assert_int_le(abs(pipeline.arrival - 100), 2);
+	ck_assert_uint_eq(pipeline.beamformed.length, PIPELINE_DATA_SIZE);
+	ck_assert_int_eq(pipeline.sector, 3);
+}
+END_TEST
+
+START_TEST(pipeline_run_tdoa)
+{
+	/* The same for the cross spectrums, of a wave that a tone would alias. */
+	pipeline_tdoa(&pipeline);
+	fill_wideband_wave(&frame, 100.0);
+	pipeline_run(&pipeline, &frame);
+
+	ck_assert_int_le(abs(pipeline.arrival - 100), 5);
+	ck_assert_uint_eq(pipeline.beamformed.length, PIPELINE_DATA_SIZE);
+	ck_assert_int_eq(pipeline.sector, 3);
+}
+END_TEST
+
+START_TEST(pipeline_run_mvdr)
+{
+	/* MVDR takes the buffers of its filters after the wideband stage. */
+	pipeline_srp(&pipeline, NULL);
+	pipeline_mvdr(&pipeline, PIPELINE_MVDR_LOADING);
+	fill_plane_wave(&frame, 1500.0, 100.0);
+	pipeline_run(&pipeline, &frame);
+
+	ck_assert_int_le(abs(pipeline.arrival - 100), 2);
+	ck_assert_uint_eq(pipeline.beamformed.length, PIPELINE_DATA_SIZE);
+	ck_assert_double_gt(dsp_time_abs_max(&pipeline.beamformed), 0.0);
+	ck_assert_int_eq(pipeline.sector, 3);
+}
+END_TEST
+
+START_TEST(pipeline_statistics)
+{
+	int i;
+	double energy = 0.0;
+	PipelineStats stats;
+	const DspTime *sample = &pipeline.samples[3];
+
+	fill_mics(&frame, 12, 3);
+	pipeline_load_samples(&pipeline, &frame);
+	pipeline_stats(sample, &stats);
+
+	for (i = 0; i < PIPELINE_DATA_SIZE; i++)
+	{
+		energy += frame.micSouthEast[i] * frame.micSouthEast[i];
+	}
+	ck_assert_double_eq_tol(stats.energy, energy, 1e-6);
+	ck_assert_double_eq_tol(stats.power, energy / PIPELINE_DATA_SIZE, 1e-9);
+	ck_assert_double_eq_tol(stats.rms, sqrt(energy / PIPELINE_DATA_SIZE), 1e-9);
+	ck_assert_double_eq_tol(stats.crestFactor, dsp_time_abs_max(sample) /
+		sqrt(energy / PIPELINE_DATA_SIZE), 1e-9);
+
+	ck_assert_double_eq(stats.max, dsp_time_max(sample));
+	ck_assert_double_eq(stats.min, dsp_time_min(sample));
+	ck_assert_double_eq_tol(stats.mean, dsp_time_mean(sample), 1e-9);
+	ck_assert_double_eq_tol(stats.kurtosis, dsp_time_kurtosis(sample), 1e-9);
+	ck_assert_double_eq_tol(stats.variance, dsp_time_variance(sample), 1e-9);
+}
+END_TEST
+
+Suite *pipeline_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Pipeline");
+	tc_core = tcase_create("Core");
+
+	tcase_add_checked_fixture(tc_core, setup, NULL);
+	tcase_add_test(tc_core, pipeline_init_clears);
+	tcase_add_test(tc_core, pipeline_load);
+	tcase_add_test(tc_core, pipeline_frequency);
+	tcase_add_test(tc_core, pipeline_frequency_f32);
+	tcase_add_test(tc_core, pipeline_loudest_sector);
+	tcase_add_test(tc_core, pipeline_run_srp);
+	tcase_add_test(tc_core, pipeline_run_tdoa);
+	tcase_add_test(tc_core, pipeline_run_mvdr);
+	tcase_add_test(tc_core, pipeline_statistics);
+
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
+
+int main(int argc, char *argv[])
+{
+	int numFailed = 0;
+	Suite *s;
+	SRunner *sr;
+
+	s = pipeline_suite();
+	sr = srunner_create(s);
+
+	srunner_run_all(sr, CK_NORMAL);
+
+	numFailed = srunner_ntests_failed(sr);
+
+	srunner_free(sr);
+
+	printf("numFailed = %d\n", numFailed);
+
+	return (numFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
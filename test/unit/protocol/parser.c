@@ -0,0 +1,192 @@
+/**
+ ******************************************************************************
+ * @file 	parser.c
+ * @author 	Ahmet Can GULMEZ
+ * @brief 	Unit test for the framed wire protocol parser.
+ * 
+ ******************************************************************************
+ * @attention
+ * 
+ * Copyright (c) 2026 Ahmet Can GULMEZ.
+ * All rights reserved.
+ * 
+ * This software is licensed under the MIT License.
+ * 
+ ******************************************************************************
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <check.h>
+#include "../../../common/protocol.h"
+
+#define PAYLOAD_SIZE							4764
+#define FRAME_COUNT							4
+
+static uint8_t payloads[FRAME_COUNT][PAYLOAD_SIZE];
+static uint8_t stream[FRAME_COUNT * PROTOCOL_FRAME_SIZE(PAYLOAD_SIZE) + 64];
+static ProtocolParser parser;
+
+/**
+ * Build the test stream with consecutive frames.
+ */
+static size_t build_stream(uint16_t firstSequence)
+{
+	int i;
+	size_t j, size = 0;
+
+	for (i = 0; i < FRAME_COUNT; i++)
+	{
+		for (j = 0; j < PAYLOAD_SIZE; j++)
+		{
+			payloads[i][j] = (uint8_t) rand();
+		}
+		size += protocol_frame_encode(firstSequence + i, payloads[i],
+			PAYLOAD_SIZE, stream + size);
+	}
+	return size;
+}
+
+/**
+ * Feed the stream in small chunks and count the received frames. The 
+ * received frame sequences are written into `sequences`.
+ */
+static int parse_stream(const uint8_t *data, size_t size, int *sequences)
+{
+	int count = 0;
+	size_t taken;
+	ProtocolFrame frame;
+
+	protocol_parser_init(&parser);
+	while (size > 0)
+	{
+		taken = protocol_parser_feed(&parser, data, size > 333 ? 333 : size);
+		data += taken;
+		size -= taken;
+		while (protocol_parser_next(&parser, &frame))
+		{
+			ck_assert_uint_eq(frame.length, PAYLOAD_SIZE);
+			sequences[count++] = frame.sequence;
+		}
+	}
+	return count;
+}
+
+START_TEST(protocol_crc32_check_value)
+{
+	printf("\n[TEST] Testing protocol_crc32() check value...\n");
+
+	ck_assert_uint_eq(protocol_crc32(0, (const uint8_t *) "123456789", 9),
+		0xCBF43926);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(protocol_parser_round_trip)
+{
+	int i, count, sequences[FRAME_COUNT];
+	size_t size;
+
+	printf("\n[TEST] Testing protocol parser round trip...\n");
+
+	size = build_stream(100);
+	count = parse_stream(stream, size, sequences);
+
+	ck_assert_int_eq(count, FRAME_COUNT);
+	for (i = 0; i < FRAME_COUNT; i++)
+	{
+		ck_assert_int_eq(sequences[i], 100 + i);
+	}
+	ck_assert_uint_eq(parser.crcErrors, 0);
+	ck_assert_uint_eq(parser.lostFrames, 0);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(protocol_parser_dropped_byte)
+{
+	int count, sequences[FRAME_COUNT];
+	size_t size, drop;
+
+	printf("\n[TEST] Testing protocol parser resync after dropped byte...\n");
+
+	size = build_stream(0);
+
+	/* Drop a byte from the payload of second frame. */
+	drop = PROTOCOL_FRAME_SIZE(PAYLOAD_SIZE) + 100;
+	memmove(stream + drop, stream + drop + 1, size - drop - 1);
+	count = parse_stream(stream, size - 1, sequences);
+
+	ck_assert_int_eq(count, FRAME_COUNT - 1);
+	ck_assert_int_eq(sequences[0], 0);
+	ck_assert_int_eq(sequences[1], 2);
+	ck_assert_int_eq(sequences[2], 3);
+	ck_assert_uint_eq(parser.lostFrames, 1);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+START_TEST(protocol_parser_garbage)
+{
+	int count, sequences[FRAME_COUNT];
+	size_t size;
+
+	printf("\n[TEST] Testing protocol parser with leading garbage...\n");
+
+	size = build_stream(65534);	/* the sequence also wraps around */
+	memmove(stream + 37, stream, size);
+	memset(stream, 0xEF, 37);
+	count = parse_stream(stream, size + 37, sequences);
+
+	ck_assert_int_eq(count, FRAME_COUNT);
+	ck_assert_int_eq(sequences[2], 0);
+	ck_assert_uint_eq(parser.lostFrames, 0);
+	ck_assert_uint_eq(parser.skippedBytes, 37);
+
+	printf("Passed.\n");
+}
+END_TEST
+
+Suite *protocol_suite(void)
+{
+	Suite *s;
+	TCase *tc_core;
+
+	s = suite_create("Protocol");
+	tc_core = tcase_create("Core");
+
+	tcase_add_test(tc_core, protocol_crc32_check_value);
+	tcase_add_test(tc_core, protocol_parser_round_trip);
+	tcase_add_test(tc_core, protocol_parser_dropped_byte);
+	tcase_add_test(tc_core, protocol_parser_garbage);
+
+	suite_add_tcase(s, tc_core);
+
+	return s;
+}
+
+int main(int argc, char *argv[])
+{
+	int numFailed = 0;
+	Suite *s;
+	SRunner *sr;
+
+	s = protocol_suite();
+	sr = srunner_create(s);
+
+	srunner_run_all(sr, CK_NORMAL);
+
+	numFailed = srunner_ntests_failed(sr);
+
+	srunner_free(sr);
+
+	printf("numFailed = %d\n", numFailed);
+
+	return (numFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}